@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Builds, connects and starts a type-erased sender per request, where nine requests in ten
+// are one of three sender types, once with exec::any_sender and once with
+// any_sender::with_fast_types listing those three types.
+
+#include <stdexec/execution.hpp>
+#include <exec/any_sender_of.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+  using completions = stdexec::completion_signatures<
+    stdexec::set_value_t(long),
+    stdexec::set_error_t(std::exception_ptr),
+    stdexec::set_stopped_t()
+  >;
+
+  using any_request = exec::any_receiver_ref<completions>::any_sender<>;
+
+  struct add_one {
+    auto operator()(long i) const noexcept -> long {
+      return i + 1;
+    }
+  };
+
+  struct twice {
+    auto operator()(long i) const noexcept -> long {
+      return 2 * i;
+    }
+  };
+
+  struct rare {
+    auto operator()(long i) const noexcept -> long {
+      return i - 1;
+    }
+  };
+
+  using just_request = decltype(stdexec::just(0L));
+  using add_one_request = decltype(stdexec::just(0L) | stdexec::then(add_one{}));
+  using twice_request = decltype(stdexec::just(0L) | stdexec::then(twice{}));
+
+  using fast_request = any_request::with_fast_types<just_request, add_one_request, twice_request>;
+
+  struct sink {
+    using receiver_concept = stdexec::receiver_t;
+    long* total_;
+
+    void set_value(long value) noexcept {
+      *total_ += value;
+    }
+
+    void set_error(std::exception_ptr) noexcept {
+    }
+
+    void set_stopped() noexcept {
+    }
+  };
+
+  template <class Request>
+  auto make_request(std::size_t i) -> Request {
+    auto value = static_cast<long>(i);
+    switch (i % 10) {
+    case 0:
+      return stdexec::just(value) | stdexec::then(rare{});
+    case 1:
+    case 2:
+    case 3:
+      return stdexec::just(value);
+    case 4:
+    case 5:
+    case 6:
+      return stdexec::just(value) | stdexec::then(add_one{});
+    default:
+      return stdexec::just(value) | stdexec::then(twice{});
+    }
+  }
+
+  template <class Request>
+  void measure(const char* name, std::size_t n_requests) {
+    long total = 0;
+    auto run = [&] {
+      for (std::size_t i = 0; i < n_requests; ++i) {
+        auto op = stdexec::connect(make_request<Request>(i), sink{&total});
+        stdexec::start(op);
+      }
+    };
+    run(); // warmup
+    auto start = std::chrono::steady_clock::now();
+    run();
+    auto end = std::chrono::steady_clock::now();
+    auto dur = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    auto n = static_cast<double>(n_requests);
+    std::cout << name << ": " << dur.count() / n * 1e9 << "ns per request, " << n / dur.count()
+              << " requests/s (checksum " << total << ")\n";
+  }
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+  std::size_t n_requests = 10'000'000;
+  if (argc > 1) {
+    n_requests = static_cast<std::size_t>(std::atoll(argv[1]));
+  }
+  measure<any_request>("any_sender", n_requests);
+  measure<fast_request>("with_fast_types", n_requests);
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Spawns small operations into one async_scope from every thread of a static_thread_pool at
+// once, which stresses the scope's active count and its spawn allocations.
+
+#include <exec/async_scope.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <stdexec/execution.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+auto main(int argc, char** argv) -> int {
+  std::uint32_t nthreads = std::thread::hardware_concurrency();
+  if (argc > 1) {
+    nthreads = static_cast<std::uint32_t>(std::atoi(argv[1]));
+  }
+  std::size_t n_per_thread = 1'000'000;
+  if (argc > 2) {
+    n_per_thread = static_cast<std::size_t>(std::atoll(argv[2]));
+  }
+
+  exec::static_thread_pool pool{nthreads};
+  auto sched = pool.get_scheduler();
+  exec::async_scope scope;
+  std::atomic<std::size_t> counter{0};
+
+  auto spawn_all = [&] {
+    stdexec::sync_wait(
+      stdexec::schedule(sched) | stdexec::bulk(stdexec::par, nthreads, [&](std::uint32_t) {
+        for (std::size_t i = 0; i < n_per_thread; ++i) {
+          scope.spawn(stdexec::just() | stdexec::then([&] {
+                        counter.fetch_add(1, std::memory_order_relaxed);
+                      }));
+        }
+      }));
+    stdexec::sync_wait(scope.on_empty());
+  };
+
+  spawn_all(); // warmup
+  constexpr int n_runs = 5;
+  auto start = std::chrono::steady_clock::now();
+  for (int run = 0; run < n_runs; ++run) {
+    spawn_all();
+  }
+  auto end = std::chrono::steady_clock::now();
+  auto dur = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+  auto total = static_cast<double>(n_per_thread * nthreads * n_runs);
+  std::cout << nthreads << " threads: " << dur.count() / total * 1e9 << "ns per spawn, "
+            << total / dur.count() << " spawns/s\n";
+}
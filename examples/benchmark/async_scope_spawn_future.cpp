@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Measures the latency of async_scope::spawn_future followed by waiting for the future, with
+// many threads spawning into the same scope concurrently.
+
+#include <exec/async_scope.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <stdexec/execution.hpp>
+
+#include <barrier>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+  template <class Fn>
+  void measure(const char* name, std::size_t nthreads, std::size_t n_ops, Fn fn) {
+    std::barrier<> barrier{static_cast<std::ptrdiff_t>(nthreads + 1)};
+    std::vector<std::thread> threads;
+    for (std::size_t tid = 0; tid < nthreads; ++tid) {
+      threads.emplace_back([&] {
+        barrier.arrive_and_wait();
+        fn();
+        barrier.arrive_and_wait();
+      });
+    }
+    barrier.arrive_and_wait();
+    auto start = std::chrono::steady_clock::now();
+    barrier.arrive_and_wait();
+    auto end = std::chrono::steady_clock::now();
+    for (auto& thread: threads) {
+      thread.join();
+    }
+    auto dur = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    auto total = static_cast<double>(nthreads * n_ops);
+    std::cout << name << ": " << dur.count() / static_cast<double>(n_ops) * 1e9
+              << "ns per spawn_future+await per thread, " << total / dur.count() << " ops/s\n";
+  }
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+  std::size_t nthreads = std::thread::hardware_concurrency();
+  if (argc > 1) {
+    nthreads = static_cast<std::size_t>(std::atoi(argv[1]));
+  }
+  std::size_t n_ops = 100'000;
+  if (argc > 2) {
+    n_ops = static_cast<std::size_t>(std::atoll(argv[2]));
+  }
+
+  exec::static_thread_pool pool{static_cast<std::uint32_t>(nthreads)};
+  auto sched = pool.get_scheduler();
+  exec::async_scope scope;
+
+  measure("inline completion", nthreads, n_ops, [&] {
+    for (std::size_t i = 0; i < n_ops; ++i) {
+      stdexec::sync_wait(scope.spawn_future(stdexec::just(i)));
+    }
+  });
+
+  measure("completion on the pool", nthreads, n_ops, [&] {
+    for (std::size_t i = 0; i < n_ops; ++i) {
+      stdexec::sync_wait(scope.spawn_future(stdexec::starts_on(sched, stdexec::just(i))));
+    }
+  });
+
+  constexpr std::size_t fan_out = 64;
+  measure("fan-out/fan-in on the pool", nthreads, n_ops, [&] {
+    using future_t = decltype(scope.spawn_future(stdexec::starts_on(sched, stdexec::just(0UL))));
+    std::vector<future_t> futures;
+    futures.reserve(fan_out);
+    for (std::size_t i = 0; i < n_ops; i += fan_out) {
+      for (std::size_t j = 0; j < fan_out; ++j) {
+        futures.push_back(scope.spawn_future(stdexec::starts_on(sched, stdexec::just(i + j))));
+      }
+      for (auto& future: futures) {
+        stdexec::sync_wait(std::move(future));
+      }
+      futures.clear();
+    }
+  });
+
+  stdexec::sync_wait(scope.on_empty());
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Computes y = a * x + y over large float arrays on a static_thread_pool, with a scalar
+// `bulk(par, ...)`, an unsequenced `bulk(par_unseq, ...)` whose chunks the compiler may
+// vectorize, and an explicit `exec::bulk_simd` that processes a vector of elements per call.
+
+#include <stdexec/execution.hpp>
+#include <exec/bulk_simd.hpp>
+#include <exec/static_thread_pool.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#if __has_include(<experimental/simd>)
+#  include <experimental/simd>
+#  if defined(__cpp_lib_experimental_parallel_simd)
+#    define HAS_STD_SIMD 1
+#  endif
+#endif
+
+namespace {
+#if defined(HAS_STD_SIMD)
+  namespace stdx = std::experimental;
+  constexpr std::size_t simd_width = stdx::native_simd<float>::size();
+#else
+  constexpr std::size_t simd_width = 8;
+#endif
+
+  struct saxpy_one {
+    float a_;
+    const float* x_;
+    float* y_;
+
+    void operator()(std::size_t i) const noexcept {
+      y_[i] = a_ * x_[i] + y_[i];
+    }
+  };
+
+  struct saxpy_batch {
+    float a_;
+    const float* x_;
+    float* y_;
+
+    template <std::size_t Width>
+    void operator()(std::size_t i, std::integral_constant<std::size_t, Width>) const noexcept {
+#if defined(HAS_STD_SIMD)
+      using simd_t = stdx::fixed_size_simd<float, Width>;
+      simd_t x{x_ + i, stdx::element_aligned};
+      simd_t y{y_ + i, stdx::element_aligned};
+      y = a_ * x + y;
+      y.copy_to(y_ + i, stdx::element_aligned);
+#else
+      for (std::size_t j = i; j < i + Width; ++j) {
+        y_[j] = a_ * x_[j] + y_[j];
+      }
+#endif
+    }
+  };
+
+  template <class MakeSender>
+  void measure(const char* name, std::size_t n, std::size_t reps, MakeSender make_sender) {
+    stdexec::sync_wait(make_sender()); // warmup
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < reps; ++r) {
+      stdexec::sync_wait(make_sender());
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto dur = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    auto elements = static_cast<double>(n) * static_cast<double>(reps);
+    std::cout << name << ": " << elements / dur.count() / 1e9 << " Gelements/s\n";
+  }
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+  std::size_t n = 1 << 22;
+  std::size_t reps = 100;
+  if (argc > 1) {
+    n = static_cast<std::size_t>(std::atoll(argv[1]));
+  }
+  if (argc > 2) {
+    reps = static_cast<std::size_t>(std::atoll(argv[2]));
+  }
+
+  exec::static_thread_pool pool;
+  auto sched = pool.get_scheduler();
+  std::vector<float> x(n, 1.0f);
+  std::vector<float> y(n, 0.0f);
+  const float a = 0.5f;
+
+  measure("bulk(par)", n, reps, [&] {
+    return stdexec::schedule(sched)
+         | stdexec::bulk(stdexec::par, n, saxpy_one{a, x.data(), y.data()});
+  });
+  measure("bulk(par_unseq)", n, reps, [&] {
+    return stdexec::schedule(sched)
+         | stdexec::bulk(stdexec::par_unseq, n, saxpy_one{a, x.data(), y.data()});
+  });
+  measure("bulk_simd(par_unseq)", n, reps, [&] {
+    return stdexec::schedule(sched)
+         | exec::bulk_simd<simd_width>(stdexec::par_unseq, n, saxpy_batch{a, x.data(), y.data()});
+  });
+  std::cout << "checksum " << y[0] + y[n - 1] << "\n";
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Transposes a large square matrix of doubles on a static_thread_pool, with a flat
+// `bulk(par, n * n, ...)` whose even shares are stripes of whole rows, and with
+// `exec::bulk_md` over an mdshape{n, n}, which hands each thread a compact region of tiles in
+// Morton order so that the column-wise writes stay in cache.
+
+#include <stdexec/execution.hpp>
+#include <exec/bulk_md.hpp>
+#include <exec/static_thread_pool.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+  struct transpose_flat {
+    std::size_t n_;
+    const double* in_;
+    double* out_;
+
+    void operator()(std::size_t k) const noexcept {
+      const std::size_t i = k / n_;
+      const std::size_t j = k % n_;
+      out_[j * n_ + i] = in_[i * n_ + j];
+    }
+  };
+
+  struct transpose_md {
+    std::size_t n_;
+    const double* in_;
+    double* out_;
+
+    void operator()(std::size_t i, std::size_t j) const noexcept {
+      out_[j * n_ + i] = in_[i * n_ + j];
+    }
+  };
+
+  template <class MakeSender>
+  void measure(const char* name, std::size_t n, std::size_t reps, MakeSender make_sender) {
+    stdexec::sync_wait(make_sender()); // warmup
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < reps; ++r) {
+      stdexec::sync_wait(make_sender());
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto dur = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    auto bytes = 2.0 * sizeof(double) * static_cast<double>(n * n) * static_cast<double>(reps);
+    std::cout << name << ": " << bytes / dur.count() / 1e9 << " GB/s\n";
+  }
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+  std::size_t n = 4096;
+  std::size_t reps = 20;
+  if (argc > 1) {
+    n = static_cast<std::size_t>(std::atoll(argv[1]));
+  }
+  if (argc > 2) {
+    reps = static_cast<std::size_t>(std::atoll(argv[2]));
+  }
+
+  exec::static_thread_pool pool;
+  auto sched = pool.get_scheduler();
+  std::vector<double> in(n * n);
+  std::vector<double> out(n * n);
+  for (std::size_t k = 0; k < in.size(); ++k) {
+    in[k] = static_cast<double>(k);
+  }
+
+  measure("bulk(par, n * n)", n, reps, [&] {
+    return stdexec::schedule(sched)
+         | stdexec::bulk(stdexec::par, n * n, transpose_flat{n, in.data(), out.data()});
+  });
+  measure("bulk_md(par, {n, n})", n, reps, [&] {
+    return stdexec::schedule(sched)
+         | exec::bulk_md(stdexec::par, exec::mdshape{n, n}, transpose_md{n, in.data(), out.data()});
+  });
+  std::cout << "checksum " << out[1] + out[n * n - 2] << "\n";
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Computes fibonacci numbers on a static_thread_pool with a parallel recursion down to
+// `cutoff`, once by spawning a type-erased sender per child (as example.benchmark.fibonacci
+// does) and once with exec::fork_join_context, whose children live on the stack.
+
+#include <exec/any_sender_of.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <stdexec/execution.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+namespace {
+  auto serial_fib(long n) -> long {
+    return n < 2 ? n : serial_fib(n - 1) + serial_fib(n - 2);
+  }
+
+  template <class... Ts>
+  using any_sender_of =
+    exec::any_receiver_ref<stdexec::completion_signatures<Ts...>>::template any_sender<>;
+
+  using fib_sender = any_sender_of<stdexec::set_value_t(long)>;
+
+  template <typename Scheduler>
+  struct fib_s {
+    using sender_concept = stdexec::sender_t;
+    using completion_signatures = stdexec::completion_signatures<stdexec::set_value_t(long)>;
+
+    long cutoff;
+    long n;
+    Scheduler sched;
+
+    template <class Receiver>
+    struct operation {
+      Receiver rcvr_;
+      long cutoff;
+      long n;
+      Scheduler sched;
+
+      void start() & noexcept {
+        if (n < cutoff) {
+          stdexec::set_value(static_cast<Receiver&&>(rcvr_), serial_fib(n));
+        } else {
+          auto mkchild = [&](long n) {
+            return stdexec::starts_on(sched, fib_sender(fib_s{cutoff, n, sched}));
+          };
+
+          stdexec::start_detached(
+            stdexec::when_all(mkchild(n - 1), mkchild(n - 2))
+            | stdexec::then([rcvr = static_cast<Receiver&&>(rcvr_)](long a, long b) mutable {
+                stdexec::set_value(static_cast<Receiver&&>(rcvr), a + b);
+              }));
+        }
+      }
+    };
+
+    template <stdexec::receiver_of<completion_signatures> Receiver>
+    friend auto tag_invoke(stdexec::connect_t, fib_s self, Receiver rcvr) -> operation<Receiver> {
+      return {static_cast<Receiver&&>(rcvr), self.cutoff, self.n, self.sched};
+    }
+  };
+
+  template <class Scheduler>
+  fib_s(long cutoff, long n, Scheduler sched) -> fib_s<Scheduler>;
+
+  auto fork_join_fib(exec::fork_join_context ctx, long cutoff, long n) -> long {
+    if (n < cutoff) {
+      return serial_fib(n);
+    }
+    long a = 0;
+    auto child = ctx.spawn_child(
+      [&](exec::fork_join_context c) { a = fork_join_fib(c, cutoff, n - 1); });
+    long b = fork_join_fib(ctx, cutoff, n - 2);
+    ctx.sync(child);
+    return a + b;
+  }
+
+  template <class F>
+  auto measure(std::size_t nruns, F f) -> double {
+    // The first run warms up the pool and is not timed.
+    long result = f();
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < nruns; ++i) {
+      result = f();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Result: " << result << ". ";
+    return elapsed.count() / static_cast<double>(nruns);
+  }
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+  if (argc < 4) {
+    std::cerr << "Usage: example.benchmark.fibonacci_fork_join cutoff n nruns" << std::endl;
+    return -1;
+  }
+
+  long cutoff = std::strtol(argv[1], nullptr, 10);
+  long n = std::strtol(argv[2], nullptr, 10);
+  std::size_t nruns = std::strtoul(argv[3], nullptr, 10);
+
+  exec::static_thread_pool pool{std::thread::hardware_concurrency()};
+  auto sched = pool.get_scheduler();
+
+  double any_sender_ms = measure(nruns, [&] {
+    auto [result] = stdexec::sync_wait(fib_sender(fib_s{cutoff, n, sched})).value();
+    return result;
+  });
+  std::cout << "any_sender:        " << any_sender_ms << "ms\n";
+
+  double fork_join_ms = measure(nruns, [&] {
+    auto snd = stdexec::schedule(sched) | stdexec::then([&] {
+                 return fork_join_fib(exec::fork_join_context::current(), cutoff, n);
+               });
+    auto [result] = stdexec::sync_wait(std::move(snd)).value();
+    return result;
+  });
+  std::cout << "fork_join_context: " << fork_join_ms << "ms\n";
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Compares exec::iterate and exec::parallel_iterate on a static_thread_pool for CPU-bound
+// per-element work.
+
+#include <exec/sequence/ignore_all_values.hpp>
+#include <exec/sequence/iterate.hpp>
+#include <exec/sequence/parallel_iterate.hpp>
+#include <exec/sequence/transform_each.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <stdexec/execution.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace {
+  auto work(int value) -> double {
+    double x = value;
+    for (int i = 0; i < 200; ++i) {
+      x = std::sin(x) + std::cos(x);
+    }
+    return x;
+  }
+
+  template <class Fn>
+  void measure(const char* name, std::size_t n_items, Fn fn) {
+    fn(); // warmup
+    constexpr int n_runs = 10;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n_runs; ++i) {
+      fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto dur = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    std::cout << name << ": " << dur.count() / n_runs * 1000.0 << "ms per run, "
+              << static_cast<double>(n_items * n_runs) / dur.count() << " items/s\n";
+  }
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+  std::uint32_t nthreads = std::thread::hardware_concurrency();
+  if (argc > 1) {
+    nthreads = static_cast<std::uint32_t>(std::atoi(argv[1]));
+  }
+  std::size_t n_items = 1'000'000;
+  if (argc > 2) {
+    n_items = static_cast<std::size_t>(std::atoll(argv[2]));
+  }
+
+  exec::static_thread_pool pool{nthreads};
+  auto sched = pool.get_scheduler();
+  std::vector<int> values(n_items);
+  std::iota(values.begin(), values.end(), 0);
+  std::atomic<double> sink{0.0};
+
+  measure("iterate", n_items, [&] {
+    stdexec::sync_wait(stdexec::starts_on(
+      sched,
+      exec::ignore_all_values(exec::transform_each(
+        exec::iterate(std::views::all(values)),
+        stdexec::then([&](int value) { sink.store(work(value), std::memory_order_relaxed); })))));
+  });
+
+  measure("parallel_iterate", n_items, [&] {
+    stdexec::sync_wait(exec::ignore_all_values(exec::transform_each(
+      exec::parallel_iterate(std::views::all(values), sched),
+      stdexec::then([&](int value) { sink.store(work(value), std::memory_order_relaxed); }))));
+  });
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Posts tasks to a stdexec::run_loop from one or more producer threads and handles them on
+// the thread that calls run(). Reports the time per task from the first post to the moment
+// the loop has handled the last one.
+
+#include <stdexec/execution.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+  struct countdown {
+    stdexec::run_loop* loop_;
+    std::size_t remaining_;
+  };
+
+  struct handle_task {
+    using receiver_concept = stdexec::receiver_t;
+    countdown* countdown_;
+
+    void set_value() noexcept {
+      if (--countdown_->remaining_ == 0) {
+        countdown_->loop_->finish();
+      }
+    }
+
+    void set_error(std::exception_ptr) noexcept {
+    }
+
+    void set_stopped() noexcept {
+    }
+  };
+
+  using scheduler = decltype(std::declval<stdexec::run_loop&>().get_scheduler());
+  using schedule_sender = decltype(stdexec::schedule(std::declval<scheduler>()));
+
+  struct posted_task {
+    posted_task(scheduler sched, countdown* count)
+      : op_(stdexec::connect(stdexec::schedule(sched), handle_task{count})) {
+    }
+
+    stdexec::connect_result_t<schedule_sender, handle_task> op_;
+  };
+
+  void measure(
+    const char* name,
+    std::size_t spin_count,
+    std::size_t n_producers,
+    std::size_t n_tasks_per_producer) {
+    stdexec::run_loop loop{spin_count};
+    countdown count{&loop, n_producers * n_tasks_per_producer};
+
+    std::vector<std::vector<std::unique_ptr<posted_task>>> tasks(n_producers);
+    for (auto& per_producer: tasks) {
+      per_producer.reserve(n_tasks_per_producer);
+      for (std::size_t i = 0; i < n_tasks_per_producer; ++i) {
+        per_producer.push_back(std::make_unique<posted_task>(loop.get_scheduler(), &count));
+      }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (auto& per_producer: tasks) {
+      producers.emplace_back([&per_producer] {
+        for (auto& task: per_producer) {
+          stdexec::start(task->op_);
+        }
+      });
+    }
+    loop.run();
+    auto end = std::chrono::steady_clock::now();
+    for (auto& producer: producers) {
+      producer.join();
+    }
+
+    auto dur = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    auto n = static_cast<double>(n_producers * n_tasks_per_producer);
+    std::cout << name << ", " << n_producers << " producer(s): " << dur.count() / n * 1e9
+              << "ns per task, " << n / dur.count() << " tasks/s\n";
+  }
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+  std::size_t n_tasks = 1'000'000;
+  if (argc > 1) {
+    n_tasks = static_cast<std::size_t>(std::atoll(argv[1]));
+  }
+  for (std::size_t n_producers: {1, 4}) {
+    measure("parking", 0, n_producers, n_tasks / n_producers);
+    measure("spinning", 1000, n_producers, n_tasks / n_producers);
+  }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Measures the throughput of registering and deregistering stop callbacks on one stop source
+// from many threads at once, for stdexec::inplace_stop_source and exec::sharded_stop_source.
+
+#include <stdexec/stop_token.hpp>
+#include <exec/sharded_stop_token.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+  struct noop {
+    void operator()() const noexcept {
+    }
+  };
+
+  template <class Source>
+  void measure(const char* name, std::size_t num_threads, std::size_t iterations) {
+    Source source;
+    std::atomic<std::size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&] {
+        using callback_t = stdexec::stop_callback_for_t<decltype(source.get_token()), noop>;
+        ready.fetch_add(1);
+        while (!go.load(std::memory_order_acquire)) {
+          std::this_thread::yield();
+        }
+        for (std::size_t i = 0; i < iterations; ++i) {
+          callback_t cb{source.get_token(), noop{}};
+        }
+      });
+    }
+    while (ready.load() != num_threads) {
+      std::this_thread::yield();
+    }
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread: threads) {
+      thread.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto dur = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    auto ops = static_cast<double>(num_threads) * static_cast<double>(iterations);
+    std::cout << name << ": " << ops / dur.count() / 1e6
+              << " M register/deregister pairs/s\n";
+  }
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+  std::size_t num_threads = std::thread::hardware_concurrency();
+  std::size_t iterations = 1'000'000;
+  if (argc > 1) {
+    num_threads = static_cast<std::size_t>(std::atoll(argv[1]));
+  }
+  if (argc > 2) {
+    iterations = static_cast<std::size_t>(std::atoll(argv[2]));
+  }
+  if (num_threads == 0) {
+    num_threads = 1;
+  }
+  std::cout << num_threads << " threads\n";
+  measure<stdexec::inplace_stop_source>("inplace_stop_source", num_threads, iterations);
+  measure<exec::sharded_stop_source>("sharded_stop_source", num_threads, iterations);
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Measures how many co_await expressions per second an exec::task running on a
+// static_thread_pool can get through, for senders that complete inline, for schedule senders
+// of the task's own pool, and for child tasks.
+
+#include <stdexec/execution.hpp>
+
+#if !STDEXEC_STD_NO_COROUTINES() && !STDEXEC_NVHPC()
+#  include <exec/async_scope.hpp>
+#  include <exec/static_thread_pool.hpp>
+#  include <exec/task.hpp>
+
+#  include <chrono>
+#  include <cstdlib>
+#  include <iostream>
+#  include <thread>
+
+namespace {
+  auto await_just(std::size_t n_awaits) -> exec::task<std::size_t> {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < n_awaits; ++i) {
+      total += co_await stdexec::just(std::size_t{1});
+    }
+    co_return total;
+  }
+
+  auto await_schedule(exec::static_thread_pool::scheduler sched, std::size_t n_awaits)
+    -> exec::task<std::size_t> {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < n_awaits; ++i) {
+      co_await stdexec::schedule(sched);
+      ++total;
+    }
+    co_return total;
+  }
+
+  auto child() -> exec::task<std::size_t> {
+    co_return 1;
+  }
+
+  auto await_child(std::size_t n_awaits) -> exec::task<std::size_t> {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < n_awaits; ++i) {
+      total += co_await child();
+    }
+    co_return total;
+  }
+
+  template <class MakeTask>
+  void measure(
+    const char* name,
+    exec::static_thread_pool& pool,
+    std::uint32_t n_tasks,
+    std::size_t n_awaits,
+    MakeTask make_task) {
+    auto run = [&] {
+      auto sched = pool.get_scheduler();
+      exec::async_scope scope;
+      for (std::uint32_t i = 0; i < n_tasks; ++i) {
+        scope.spawn(stdexec::starts_on(sched, make_task(n_awaits)) | stdexec::then([](auto) { }));
+      }
+      stdexec::sync_wait(scope.on_empty());
+    };
+    run(); // warmup
+    auto start = std::chrono::steady_clock::now();
+    run();
+    auto end = std::chrono::steady_clock::now();
+    auto dur = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    auto n_total = static_cast<double>(n_awaits * n_tasks);
+    std::cout << name << ": " << dur.count() / n_total * 1e9 << "ns per await, "
+              << n_total / dur.count() << " awaits/s\n";
+  }
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+  std::uint32_t nthreads = std::thread::hardware_concurrency();
+  if (argc > 1) {
+    nthreads = static_cast<std::uint32_t>(std::atoi(argv[1]));
+  }
+  std::size_t n_awaits = 1'000'000;
+  if (argc > 2) {
+    n_awaits = static_cast<std::size_t>(std::atoll(argv[2]));
+  }
+
+  exec::static_thread_pool pool{nthreads};
+  auto sched = pool.get_scheduler();
+  measure("just", pool, nthreads, n_awaits, await_just);
+  measure("schedule", pool, nthreads, n_awaits / 10, [sched](std::size_t n) {
+    return await_schedule(sched, n);
+  });
+  measure("child task", pool, nthreads, n_awaits, await_child);
+}
+#else
+auto main() -> int {
+}
+#endif
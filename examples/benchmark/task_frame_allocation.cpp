@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Runs chains of nested exec::task coroutines, in the style of hello_coro, on every thread of a
+// static_thread_pool, once with frames from the global heap and once with frames from the
+// per-thread cache of exec::recycling_frame_allocator.
+
+#include <stdexec/execution.hpp>
+
+#if !STDEXEC_STD_NO_COROUTINES() && !STDEXEC_NVHPC()
+#  include <exec/static_thread_pool.hpp>
+#  include <exec/task.hpp>
+
+#  include <chrono>
+#  include <cstdlib>
+#  include <iostream>
+#  include <thread>
+
+namespace {
+  template <template <class> class Task>
+  auto nested(int depth) -> Task<int> {
+    if (depth == 0) {
+      co_return co_await stdexec::just(1);
+    }
+    co_return 1 + co_await nested<Task>(depth - 1);
+  }
+
+  template <template <class> class Task>
+  void measure(
+    const char* name,
+    exec::static_thread_pool& pool,
+    std::uint32_t nthreads,
+    std::size_t n_chains,
+    int depth) {
+    auto run = [&] {
+      stdexec::sync_wait(
+        stdexec::schedule(pool.get_scheduler())
+        | stdexec::bulk(stdexec::par, nthreads, [&](std::uint32_t) {
+            for (std::size_t i = 0; i < n_chains; ++i) {
+              stdexec::sync_wait(nested<Task>(depth));
+            }
+          }));
+    };
+    run(); // warmup
+    auto start = std::chrono::steady_clock::now();
+    run();
+    auto end = std::chrono::steady_clock::now();
+    auto dur = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    auto n_frames = static_cast<double>(n_chains * nthreads * static_cast<std::size_t>(depth + 1));
+    std::cout << name << ": " << dur.count() / n_frames * 1e9 << "ns per frame, "
+              << n_frames / dur.count() << " frames/s\n";
+  }
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+  std::uint32_t nthreads = std::thread::hardware_concurrency();
+  if (argc > 1) {
+    nthreads = static_cast<std::uint32_t>(std::atoi(argv[1]));
+  }
+  std::size_t n_chains = 100'000;
+  if (argc > 2) {
+    n_chains = static_cast<std::size_t>(std::atoll(argv[2]));
+  }
+  constexpr int depth = 8;
+
+  exec::static_thread_pool pool{nthreads};
+  measure<exec::task>("task", pool, nthreads, n_chains, depth);
+  measure<exec::recycling_task>("recycling_task", pool, nthreads, n_chains, depth);
+}
+#else
+auto main() -> int {
+}
+#endif
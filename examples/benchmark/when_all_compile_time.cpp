@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// A compile-time benchmark: the interesting number is how long this file takes to build, e.g.
+//   time cmake --build . --target example.benchmark.when_all_compile_time
+// It instantiates when_all over WHEN_ALL_WIDTH children with a mix of value, void and
+// potentially-throwing completions, at several nesting depths.
+
+#include <stdexec/execution.hpp>
+
+#include <cstdio>
+#include <utility>
+
+#ifndef WHEN_ALL_WIDTH
+#  define WHEN_ALL_WIDTH 64
+#endif
+
+namespace {
+  template <std::size_t I>
+  auto child() {
+    if constexpr (I % 3 == 0) {
+      return stdexec::just(static_cast<int>(I));
+    } else if constexpr (I % 3 == 1) {
+      return stdexec::just();
+    } else {
+      return stdexec::just(I) | stdexec::then([](std::size_t i) { return static_cast<double>(i); });
+    }
+  }
+
+  template <std::size_t Offset, std::size_t... Is>
+  auto wide(std::index_sequence<Is...>) {
+    return stdexec::when_all(child<Offset + Is>()...);
+  }
+
+  template <std::size_t Width>
+  auto nested() {
+    constexpr std::size_t half = Width / 2;
+    return stdexec::when_all(
+      wide<0>(std::make_index_sequence<half>{}),
+      wide<half>(std::make_index_sequence<Width - half>{}));
+  }
+} // namespace
+
+auto main() -> int {
+  auto flat = stdexec::sync_wait(wide<0>(std::make_index_sequence<WHEN_ALL_WIDTH>{}));
+  auto tree = stdexec::sync_wait(nested<WHEN_ALL_WIDTH>());
+  std::printf(
+    "when_all of %d children: %s\n", WHEN_ALL_WIDTH, flat && tree ? "completed" : "failed");
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Joins a runtime number of senders on a static_thread_pool and collects their results,
+// once with exec::when_all_range and once with the async_scope workaround of spawning every
+// sender and writing its result into a pre-sized vector.
+
+#include <exec/async_scope.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <exec/when_all_range.hpp>
+#include <stdexec/execution.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+  template <class Fn>
+  void measure(const char* name, std::size_t n_senders, Fn fn) {
+    fn(); // warmup
+    constexpr int n_runs = 10;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n_runs; ++i) {
+      fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto dur = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    std::cout << name << ": " << dur.count() / n_runs * 1000.0 << "ms per run, "
+              << static_cast<double>(n_senders * n_runs) / dur.count() << " senders/s\n";
+  }
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+  std::uint32_t nthreads = std::thread::hardware_concurrency();
+  if (argc > 1) {
+    nthreads = static_cast<std::uint32_t>(std::atoi(argv[1]));
+  }
+  std::size_t n_senders = 100'000;
+  if (argc > 2) {
+    n_senders = static_cast<std::size_t>(std::atoll(argv[2]));
+  }
+
+  exec::static_thread_pool pool{nthreads};
+  auto sched = pool.get_scheduler();
+  auto request = [sched](std::size_t i) {
+    return stdexec::schedule(sched) | stdexec::then([i] { return i * i; });
+  };
+  std::size_t checksum = 0;
+
+  measure("when_all_range", n_senders, [&] {
+    std::vector<decltype(request(0))> senders;
+    senders.reserve(n_senders);
+    for (std::size_t i = 0; i < n_senders; ++i) {
+      senders.push_back(request(i));
+    }
+    auto [results] = stdexec::sync_wait(exec::when_all_range(std::move(senders))).value();
+    checksum += results.back();
+  });
+
+  measure("async_scope", n_senders, [&] {
+    exec::async_scope scope;
+    std::vector<std::size_t> results(n_senders);
+    for (std::size_t i = 0; i < n_senders; ++i) {
+      scope.spawn(request(i) | stdexec::then([&results, i](std::size_t r) { results[i] = r; }));
+    }
+    stdexec::sync_wait(scope.on_empty());
+    checksum += results.back();
+  });
+
+  return checksum == 0 ? 1 : 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Measures the throughput of connecting and starting wide when_all operations over many small
+// senders, and reports the size of their operation states.
+
+#include <stdexec/execution.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+
+namespace {
+  struct sink_receiver {
+    using receiver_concept = stdexec::receiver_t;
+    long* sum_;
+
+    template <class... Ints>
+    void set_value(Ints... ints) noexcept {
+      *sum_ += (0L + ... + ints);
+    }
+
+    void set_stopped() noexcept {
+    }
+  };
+
+  template <std::size_t Width>
+  auto make_when_all() {
+    return []<std::size_t... Is>(std::index_sequence<Is...>) {
+      return stdexec::when_all(stdexec::just(static_cast<int>(Is))...);
+    }(std::make_index_sequence<Width>{});
+  }
+
+  template <std::size_t Width>
+  void measure(std::size_t n_iterations) {
+    using op_t = stdexec::connect_result_t<decltype(make_when_all<Width>()), sink_receiver>;
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < n_iterations; ++i) {
+      auto op = stdexec::connect(make_when_all<Width>(), sink_receiver{&sum});
+      stdexec::start(op);
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto dur = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    std::cout << "when_all of " << Width << ": " << sizeof(op_t) << " byte op state, "
+              << dur.count() / static_cast<double>(n_iterations) * 1e9 << "ns per op, "
+              << static_cast<double>(n_iterations * Width) / dur.count() << " children/s"
+              << (sum == 0 ? " (no work)" : "") << '\n';
+  }
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+  std::size_t n_iterations = 1'000'000;
+  if (argc > 1) {
+    n_iterations = static_cast<std::size_t>(std::atoll(argv[1]));
+  }
+  measure<4>(n_iterations);
+  measure<16>(n_iterations);
+  measure<64>(n_iterations / 4);
+}
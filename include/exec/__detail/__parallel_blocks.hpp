@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../../stdexec/execution.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <thread>
+#include <utility>
+
+// Helpers for algorithms that split an index space into one block per execution agent and
+// run a bulk_chunked over the blocks, each block producing a private result that is combined
+// in block order afterwards.
+namespace exec::__blocks {
+  using namespace stdexec;
+
+  //! A block's private result, on a cache line of its own.
+  template <class _Ty>
+  struct alignas(64) __slot {
+    std::optional<_Ty> __value_;
+  };
+
+  //! Bounds of the __block-th of __count nearly equal blocks of [0, __size).
+  inline auto __bounds(std::size_t __size, std::size_t __count, std::size_t __block) noexcept
+    -> std::pair<std::size_t, std::size_t> {
+    return {__size * __block / __count, __size * (__block + 1) / __count};
+  }
+
+  //! One block per execution agent of the scheduler __sndr completes on, as far as we can tell.
+  template <class _Sender>
+  auto __count_for(const _Sender& __sndr) noexcept -> std::size_t {
+    if constexpr (requires {
+                    get_completion_scheduler<set_value_t>(get_env(__sndr)).available_parallelism();
+                  }) {
+      auto __sched = get_completion_scheduler<set_value_t>(get_env(__sndr));
+      return (std::max) (std::size_t{__sched.available_parallelism()}, std::size_t{1});
+    } else {
+      auto __n = std::thread::hardware_concurrency();
+      return __n == 0 ? 1 : __n;
+    }
+  }
+} // namespace exec::__blocks
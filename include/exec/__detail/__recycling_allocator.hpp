@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace exec {
+  ////////////////////////////////////////////////////////////////////////////////
+  // A per-thread cache of memory blocks, binned by size. Blocks freed on a thread are reused
+  // by the next allocation of a similar size on that thread, so code that repeatedly creates
+  // and destroys short-lived objects -- coroutine frames, type-erased operation states --
+  // reaches a steady state with no calls to the heap.
+  class __recycling_cache {
+    struct __free_block {
+      __free_block* __next_;
+    };
+
+    static constexpr std::size_t __min_shift = 6;   // 64 bytes
+    static constexpr std::size_t __num_classes = 7; // up to 4 KiB
+    static constexpr std::size_t __max_cached = 64;
+
+    struct __bin {
+      __free_block* __head_{nullptr};
+      std::size_t __count_{0};
+    };
+
+    __bin __bins_[__num_classes]{};
+    std::size_t __num_allocations_{0};
+
+    // Counts the blocks that were allocated rather than reused.
+    auto __allocate_new(std::size_t __size) -> void* {
+      ++__num_allocations_;
+      return ::operator new(__size);
+    }
+
+    static constexpr auto __size_class(std::size_t __size) noexcept -> std::size_t {
+      const std::size_t __shift = static_cast<std::size_t>(
+        std::bit_width((std::max) (__size, std::size_t{1} << __min_shift) - 1));
+      return __shift - __min_shift;
+    }
+
+   public:
+    __recycling_cache() = default;
+    __recycling_cache(__recycling_cache&&) = delete;
+
+    ~__recycling_cache() {
+      for (__bin& __b: __bins_) {
+        while (__b.__head_ != nullptr) {
+          ::operator delete(std::exchange(__b.__head_, __b.__head_->__next_));
+        }
+      }
+    }
+
+    static auto __get() noexcept -> __recycling_cache& {
+      thread_local __recycling_cache __cache;
+      return __cache;
+    }
+
+    auto __allocate(std::size_t __size) -> void* {
+      const std::size_t __class = __size_class(__size);
+      if (__class >= __num_classes) {
+        return __allocate_new(__size);
+      }
+      __bin& __b = __bins_[__class];
+      if (__b.__head_ != nullptr) {
+        --__b.__count_;
+        return std::exchange(__b.__head_, __b.__head_->__next_);
+      }
+      return __allocate_new(std::size_t{1} << (__class + __min_shift));
+    }
+
+    //! The number of allocations on this thread that could not be served from the cache.
+    [[nodiscard]]
+    auto __num_allocations() const noexcept -> std::size_t {
+      return __num_allocations_;
+    }
+
+    void __deallocate(void* __block, std::size_t __size) noexcept {
+      const std::size_t __class = __size_class(__size);
+      if (__class >= __num_classes || __bins_[__class].__count_ == __max_cached) {
+        ::operator delete(__block);
+        return;
+      }
+      __bin& __b = __bins_[__class];
+      __b.__head_ = ::new (__block) __free_block{__b.__head_};
+      ++__b.__count_;
+    }
+  };
+
+  //! An allocator that serves memory from a per-thread cache of recently freed blocks, binned
+  //! by size. It suits objects that are freed soon after they are allocated, and mostly on
+  //! the thread that allocated them.
+  template <class _Ty>
+  struct recycling_allocator {
+    using value_type = _Ty;
+
+    recycling_allocator() = default;
+
+    template <class _Uy>
+    constexpr recycling_allocator(const recycling_allocator<_Uy>&) noexcept {
+    }
+
+    [[nodiscard]]
+    auto allocate(std::size_t __n) -> _Ty* {
+      static_assert(alignof(_Ty) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+      return static_cast<_Ty*>(__recycling_cache::__get().__allocate(__n * sizeof(_Ty)));
+    }
+
+    void deallocate(_Ty* __p, std::size_t __n) noexcept {
+      __recycling_cache::__get().__deallocate(__p, __n * sizeof(_Ty));
+    }
+
+    template <class _Uy>
+    friend constexpr auto
+      operator==(recycling_allocator, recycling_allocator<_Uy>) noexcept -> bool {
+      return true;
+    }
+  };
+} // namespace exec
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace exec {
+  // A small number for the calling thread, for picking one of several shards of a contended
+  // data structure. Threads are numbered in the order in which they first ask, so threads
+  // that are active at the same time land on different shards when reduced modulo the number
+  // of shards.
+  inline auto __this_thread_index() noexcept -> std::size_t {
+    static std::atomic<std::size_t> __next_index{0};
+    thread_local const std::size_t __index = __next_index.fetch_add(1, std::memory_order_relaxed);
+    return __index;
+  }
+} // namespace exec
@@ -21,12 +21,38 @@
 #include "../stdexec/__detail/__env.hpp"
 #include "../stdexec/__detail/__transform_completion_signatures.hpp"
 
+#include "__detail/__recycling_allocator.hpp"
 #include "sequence_senders.hpp"
 
 #include <cstddef>
 #include <utility>
 
 namespace exec {
+  //! Chooses where `any_sender` keeps the type-erased sender and the operation state that it
+  //! connects to. Objects that fit in the inline buffers of `_SenderInlineSize` and
+  //! `_OperationInlineSize` bytes are stored there; larger ones are allocated with a rebound,
+  //! default-constructed `_Allocator`.
+  template <
+    std::size_t _SenderInlineSize = 3 * sizeof(void*),
+    std::size_t _OperationInlineSize = 6 * sizeof(void*),
+    class _Allocator = std::allocator<std::byte>
+  >
+  struct any_sender_storage {
+    static constexpr std::size_t sender_inline_size = _SenderInlineSize;
+    static constexpr std::size_t operation_inline_size = _OperationInlineSize;
+    using allocator_type = _Allocator;
+  };
+
+  //! Like `any_sender_storage`, but senders and operation states that do not fit inline are
+  //! allocated from a per-thread cache, so an operation connected after the previous one was
+  //! destroyed reuses its heap block.
+  template <
+    std::size_t _SenderInlineSize = 3 * sizeof(void*),
+    std::size_t _OperationInlineSize = 6 * sizeof(void*)
+  >
+  using recycling_any_sender_storage =
+    any_sender_storage<_SenderInlineSize, _OperationInlineSize, recycling_allocator<std::byte>>;
+
   namespace __any {
     using namespace stdexec;
 
@@ -597,8 +623,12 @@ namespace exec {
     using __immovable_storage_t =
       __t<__immovable_storage<_VTable, _Allocator, _InlineSize, _Alignment>>;
 
-    template <class _VTable, class _Allocator = std::allocator<std::byte>>
-    using __unique_storage_t = __t<__storage<_VTable, _Allocator>>;
+    template <
+      class _VTable,
+      class _Allocator = std::allocator<std::byte>,
+      std::size_t _InlineSize = 3 * sizeof(void*)
+    >
+    using __unique_storage_t = __t<__storage<_VTable, _Allocator, false, _InlineSize>>;
 
     template <
       class _VTable,
@@ -855,8 +885,14 @@ namespace exec {
       }
     };
 
-    using __immovable_operation_storage =
-      __immovable_storage_t<__operation_vtable, std::allocator<std::byte>, 6 * sizeof(void*)>;
+    template <class _Storage = any_sender_storage<>>
+    using __operation_storage_t = __immovable_storage_t<
+      __operation_vtable,
+      typename _Storage::allocator_type,
+      _Storage::operation_inline_size
+    >;
+
+    using __immovable_operation_storage = __operation_storage_t<>;
 
     template <class _Sigs, class _Queries>
     using __receiver_ref = __mapply<__mbind_front_q<__rec::__ref, _Sigs>, _Queries>;
@@ -931,7 +967,7 @@ namespace exec {
     template <class _ReceiverId>
     using __stoppable_receiver_t = stdexec::__t<__stoppable_receiver<_ReceiverId>>;
 
-    template <class _ReceiverId, bool>
+    template <class _ReceiverId, bool, class _OpStorage = __immovable_operation_storage>
     struct __operation {
       using _Receiver = stdexec::__t<_ReceiverId>;
 
@@ -956,12 +992,12 @@ namespace exec {
 
        private:
         __stoppable_receiver_t<_ReceiverId> __rec_;
-        __immovable_operation_storage __storage_{};
+        _OpStorage __storage_{};
       };
     };
 
-    template <class _ReceiverId>
-    struct __operation<_ReceiverId, false> {
+    template <class _ReceiverId, class _OpStorage>
+    struct __operation<_ReceiverId, false, _OpStorage> {
       using _Receiver = stdexec::__t<_ReceiverId>;
 
       class __t {
@@ -981,7 +1017,7 @@ namespace exec {
 
        private:
         STDEXEC_ATTRIBUTE(no_unique_address) _Receiver __rec_;
-        __immovable_operation_storage __storage_{};
+        _OpStorage __storage_{};
       };
     };
 
@@ -1004,9 +1040,15 @@ namespace exec {
       }
     };
 
-    template <class _Sigs, class _SenderQueries = __types<>, class _ReceiverQueries = __types<>>
+    template <
+      class _Sigs,
+      class _SenderQueries = __types<>,
+      class _ReceiverQueries = __types<>,
+      class _Storage = any_sender_storage<>
+    >
     struct __sender {
       using __receiver_ref_t = __receiver_ref<_Sigs, _ReceiverQueries>;
+      using __op_storage_t = __operation_storage_t<_Storage>;
       static constexpr bool __with_inplace_stop_token =
         __v<__mapply<__mall_of<__q<__is_not_stop_token_query_t>>, _ReceiverQueries>>;
 
@@ -1018,18 +1060,17 @@ namespace exec {
           return *this;
         }
 
-        __immovable_operation_storage (*__connect_)(void*, __receiver_ref_t);
+        __op_storage_t (*__connect_)(void*, __receiver_ref_t);
        private:
         template <sender_to<__receiver_ref_t> _Sender>
         STDEXEC_MEMFN_DECL(auto __create_vtable)(this __mtype<__vtable>, __mtype<_Sender>) noexcept
           -> const __vtable* {
           static const __vtable __vtable_{
             {*__create_vtable(__mtype<__query_vtable<_SenderQueries>>{}, __mtype<_Sender>{})},
-            [](void* __object_pointer, __receiver_ref_t __receiver)
-              -> __immovable_operation_storage {
+            [](void* __object_pointer, __receiver_ref_t __receiver) -> __op_storage_t {
               _Sender& __sender = *static_cast<_Sender*>(__object_pointer);
               using __op_state_t = connect_result_t<_Sender, __receiver_ref_t>;
-              return __immovable_operation_storage{
+              return __op_storage_t{
                 std::in_place_type<__op_state_t>, __emplace_from{[&] {
                   return stdexec::connect(
                     static_cast<_Sender&&>(__sender), static_cast<__receiver_ref_t&&>(__receiver));
@@ -1069,7 +1110,7 @@ namespace exec {
           : __storage_{static_cast<_Sender&&>(__sndr)} {
         }
 
-        auto __connect(__receiver_ref_t __receiver) -> __immovable_operation_storage {
+        auto __connect(__receiver_ref_t __receiver) -> __op_storage_t {
           return __storage_.__get_vtable()->__connect_(
             __storage_.__get_object_pointer(), static_cast<__receiver_ref_t&&>(__receiver));
         }
@@ -1080,13 +1121,234 @@ namespace exec {
 
         template <receiver_of<_Sigs> _Rcvr>
         auto connect(_Rcvr __rcvr) && -> stdexec::__t<
-          __operation<stdexec::__id<_Rcvr>, __with_inplace_stop_token>
+          __operation<stdexec::__id<_Rcvr>, __with_inplace_stop_token, __op_storage_t>
         > {
           return {static_cast<__t&&>(*this), static_cast<_Rcvr&&>(__rcvr)};
         }
 
        private:
-        __unique_storage_t<__vtable> __storage_;
+        __unique_storage_t<
+          __vtable,
+          typename _Storage::allocator_type,
+          _Storage::sender_inline_size
+        >
+          __storage_;
+      };
+    };
+
+    // The receiver of an operation of a __fast_sender, and the state that the type-erased path
+    // needs around it. With an inplace stop token, this mirrors __operation above.
+    template <class _ReceiverId, bool>
+    struct __fast_operation_base : __operation_base<stdexec::__t<_ReceiverId>> {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+
+      explicit __fast_operation_base(_Receiver&& __rcvr)
+        : __operation_base<_Receiver>{static_cast<_Receiver&&>(__rcvr)} {
+      }
+
+      void __start_forwarding_stop() noexcept {
+        this->__on_stop_.emplace(
+          stdexec::get_stop_token(stdexec::get_env(this->__rcvr_)),
+          __on_stop_t{this->__stop_source_});
+      }
+
+      __stoppable_receiver_t<_ReceiverId> __rec_{this};
+    };
+
+    template <class _ReceiverId>
+    struct __fast_operation_base<_ReceiverId, false> {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+
+      explicit __fast_operation_base(_Receiver&& __rcvr)
+        : __rec_{static_cast<_Receiver&&>(__rcvr)} {
+      }
+
+      void __start_forwarding_stop() noexcept {
+      }
+
+      STDEXEC_ATTRIBUTE(no_unique_address) _Receiver __rec_;
+    };
+
+    // A type-erased sender that stores senders of the types _Fast... directly rather than
+    // behind a vtable. When connected, a sender of one of those types is connected to a
+    // receiver that completes the concrete receiver directly and is started through a switch
+    // on the variant's index, so neither start() nor the completion makes an indirect call.
+    // That receiver has the same environment as the __receiver_ref_t of the type-erased path,
+    // so a sender behaves the same whether or not its type is one of _Fast... . Senders of any
+    // other type take the type-erased path of _Sender.
+    template <class _Sender, class... _Fast>
+    struct __fast_sender {
+      using __erased_t = stdexec::__t<_Sender>;
+      using __receiver_ref_t = _Sender::__receiver_ref_t;
+      using __op_storage_t = _Sender::__op_storage_t;
+      using __variant_t = __variant_for<_Fast..., __erased_t>;
+
+      static_assert((sender_to<_Fast, __receiver_ref_t> && ...));
+      static_assert((__not_decays_to<_Fast, __erased_t> && ...));
+
+      template <class _Rcvr>
+      struct __receiver {
+        using receiver_concept = stdexec::receiver_t;
+
+        _Rcvr* __rcvr_;
+        __receiver_ref_t __ref_;
+
+        template <class... _As>
+          requires __callable<set_value_t, __receiver_ref_t, _As...>
+                && __callable<set_value_t, _Rcvr, _As...>
+        void set_value(_As&&... __as) noexcept {
+          stdexec::set_value(static_cast<_Rcvr&&>(*__rcvr_), static_cast<_As&&>(__as)...);
+        }
+
+        template <class _Error>
+          requires __callable<set_error_t, __receiver_ref_t, _Error>
+                && __callable<set_error_t, _Rcvr, _Error>
+        void set_error(_Error&& __err) noexcept {
+          stdexec::set_error(static_cast<_Rcvr&&>(*__rcvr_), static_cast<_Error&&>(__err));
+        }
+
+        void set_stopped() noexcept
+          requires __callable<set_stopped_t, __receiver_ref_t>
+                && __callable<set_stopped_t, _Rcvr>
+        {
+          stdexec::set_stopped(static_cast<_Rcvr&&>(*__rcvr_));
+        }
+
+        auto get_env() const noexcept -> env_of_t<__receiver_ref_t> {
+          return stdexec::get_env(__ref_);
+        }
+      };
+
+      template <class _ReceiverId>
+      struct __operation {
+        using _Receiver = stdexec::__t<_ReceiverId>;
+        using __base_t = __fast_operation_base<_ReceiverId, _Sender::__with_inplace_stop_token>;
+        using __rcvr_t = decltype(__base_t::__rec_);
+        using __fast_rcvr_t = __receiver<__rcvr_t>;
+
+        template <class _Fp>
+        using __fast_op_t = __if_c<
+          sender_to<_Fp, __fast_rcvr_t>,
+          connect_result_t<_Fp, __fast_rcvr_t>,
+          __op_storage_t
+        >;
+
+        class __t
+          : __base_t
+          , __immovable {
+          static constexpr std::size_t __erased_index = sizeof...(_Fast);
+
+          auto __ref() noexcept -> __receiver_ref_t {
+            return __receiver_ref_t{this->__rec_};
+          }
+
+          template <std::size_t _Index, class _Fp>
+          void __connect(_Fp&& __sndr) {
+            if constexpr (_Index == __erased_index) {
+              __op_.template emplace_from_at<_Index>([&] { return __sndr.__connect(__ref()); });
+            } else if constexpr (sender_to<_Fp, __fast_rcvr_t>) {
+              __op_.template emplace_from_at<_Index>(
+                stdexec::connect,
+                static_cast<_Fp&&>(__sndr),
+                __fast_rcvr_t{&this->__rec_, __ref()});
+            } else {
+              __op_.template emplace_from_at<_Index>(
+                [&] { return __erased_t(static_cast<_Fp&&>(__sndr)).__connect(__ref()); });
+            }
+          }
+
+         public:
+          using __id = __operation;
+
+          __t(__variant_t& __sndrs, _Receiver __rcvr)
+            : __base_t{static_cast<_Receiver&&>(__rcvr)} {
+            const std::size_t __index = __sndrs.index();
+            [&]<std::size_t... _Is>(__indices<_Is...>) {
+              ((_Is == __index ? __connect<_Is>(std::move(__sndrs).template get<_Is>()) : void()),
+               ...);
+            }(__indices_for<_Fast..., __erased_t>());
+          }
+
+          void start() & noexcept {
+            this->__start_forwarding_stop();
+            __op_variant_t::visit(
+              []<class _Op>(_Op& __op) noexcept {
+                if constexpr (__same_as<_Op, __op_storage_t>) {
+                  STDEXEC_ASSERT(__op.__get_vtable()->__start_);
+                  __op.__get_vtable()->__start_(__op.__get_object_pointer());
+                } else {
+                  stdexec::start(__op);
+                }
+              },
+              __op_);
+          }
+
+         private:
+          using __op_variant_t = __variant_for<__fast_op_t<_Fast>..., __op_storage_t>;
+          __op_variant_t __op_;
+        };
+      };
+
+      struct __t {
+        using __id = __fast_sender;
+        using completion_signatures = __erased_t::completion_signatures;
+        using sender_concept = stdexec::sender_t;
+
+        template <__not_decays_to<__t> _Sndr>
+          requires sender_to<_Sndr, __receiver_ref_t>
+        __t(_Sndr&& __sndr) {
+          __sndrs_.template emplace<__stored_t<_Sndr>>(static_cast<_Sndr&&>(__sndr));
+        }
+
+        __t(__t&& __other) noexcept(__nothrow_move) {
+          __move_from(__other);
+        }
+
+        auto operator=(__t&& __other) noexcept(__nothrow_move) -> __t& {
+          if (this != &__other) {
+            __move_from(__other);
+          }
+          return *this;
+        }
+
+        template <receiver_of<completion_signatures> _Rcvr>
+        auto connect(_Rcvr __rcvr) && -> stdexec::__t<__operation<stdexec::__id<_Rcvr>>> {
+          return {__sndrs_, static_cast<_Rcvr&&>(__rcvr)};
+        }
+
+        auto get_env() const noexcept -> env_of_t<__erased_t> {
+          env_of_t<__erased_t> __env{nullptr, nullptr};
+          __variant_t::visit(
+            [&]<class _Fp>(const _Fp& __sndr) noexcept {
+              if constexpr (__same_as<_Fp, __erased_t>) {
+                __env = stdexec::get_env(__sndr);
+              } else {
+                __env = {
+                  __create_vtable(__mtype<typename _Sender::__vtable>{}, __mtype<_Fp>{}),
+                  const_cast<_Fp*>(&__sndr)};
+              }
+            },
+            __sndrs_);
+          return __env;
+        }
+
+       private:
+        template <class _Sndr>
+        using __stored_t =
+          __if_c<__one_of<__decay_t<_Sndr>, _Fast...>, __decay_t<_Sndr>, __erased_t>;
+
+        static constexpr bool __nothrow_move = (__nothrow_move_constructible<_Fast> && ...)
+                                            && __nothrow_move_constructible<__erased_t>;
+
+        void __move_from(__t& __other) noexcept(__nothrow_move) {
+          __variant_t::visit(
+            [&]<class _Fp>(_Fp&& __sndr) noexcept(__nothrow_move) {
+              __sndrs_.template emplace<_Fp>(static_cast<_Fp&&>(__sndr));
+            },
+            std::move(__other.__sndrs_));
+        }
+
+        __variant_t __sndrs_;
       };
     };
 
@@ -1188,21 +1450,27 @@ namespace exec {
   template <auto... _Sigs>
   using queries = stdexec::__types<decltype(_Sigs)...>;
 
-  template <class _Completions, auto... _ReceiverQueries>
-  class any_receiver_ref {
+  //! A type-erased reference to a receiver. The `any_sender`s that connect to it store
+  //! themselves and their operation states as `_Storage`, an `any_sender_storage`, says.
+  template <class _Completions, class _Storage, auto... _ReceiverQueries>
+  class basic_any_receiver_ref {
     using __receiver_base = __any::__rec::__ref<_Completions, decltype(_ReceiverQueries)...>;
     using __env_t = stdexec::env_of_t<__receiver_base>;
     __receiver_base __receiver_;
 
    public:
     using receiver_concept = stdexec::receiver_t;
-    using __t = any_receiver_ref;
-    using __id = any_receiver_ref;
-
-    template <stdexec::__none_of<any_receiver_ref, const any_receiver_ref, __env_t, const __env_t>
-                _Receiver>
+    using __t = basic_any_receiver_ref;
+    using __id = basic_any_receiver_ref;
+
+    template <stdexec::__none_of<
+      basic_any_receiver_ref,
+      const basic_any_receiver_ref,
+      __env_t,
+      const __env_t
+    > _Receiver>
       requires stdexec::receiver_of<_Receiver, _Completions>
-    any_receiver_ref(_Receiver& __receiver)
+    basic_any_receiver_ref(_Receiver& __receiver)
       noexcept(stdexec::__nothrow_constructible_from<__receiver_base, _Receiver>)
       : __receiver_(__receiver) {
     }
@@ -1231,9 +1499,12 @@ namespace exec {
 
     template <auto... _SenderQueries>
     class any_sender {
-      using __sender_base = stdexec::__t<
-        __any::__sender<_Completions, queries<_SenderQueries...>, queries<_ReceiverQueries...>>
-      >;
+      using __sender_base = stdexec::__t<__any::__sender<
+        _Completions,
+        queries<_SenderQueries...>,
+        queries<_ReceiverQueries...>,
+        _Storage
+      >>;
       __sender_base __sender_;
 
      public:
@@ -1264,6 +1535,52 @@ namespace exec {
         return static_cast<const __sender_base&>(__sender_).get_env();
       }
 
+      //! An `any_sender` that keeps senders of the types `_FastSenders...` unerased, for when
+      //! most of the senders it holds are known to be of a few types. Those senders are
+      //! connected straight to the receiver and started through a switch on their type, so
+      //! their operations run without indirect calls. Other senders are type-erased as usual.
+      template <class... _FastSenders>
+      class with_fast_types {
+        using __sender_base = stdexec::__t<__any::__fast_sender<
+          __any::__sender<
+            _Completions,
+            queries<_SenderQueries...>,
+            queries<_ReceiverQueries...>,
+            _Storage
+          >,
+          _FastSenders...
+        >>;
+        __sender_base __sender_;
+
+       public:
+        using sender_concept = stdexec::sender_t;
+        using __t = with_fast_types;
+        using __id = with_fast_types;
+
+        template <stdexec::__not_decays_to<with_fast_types> _Sender>
+          requires stdexec::sender_to<_Sender, __receiver_base>
+        with_fast_types(_Sender&& __sender)
+          noexcept(stdexec::__nothrow_constructible_from<__sender_base, _Sender>)
+          : __sender_(static_cast<_Sender&&>(__sender)) {
+        }
+
+        template <stdexec::__decays_to<with_fast_types> _Self, class... _Env>
+          requires(__any::__satisfies_receiver_query<decltype(_ReceiverQueries), _Env...> && ...)
+        static auto get_completion_signatures(_Self&&, _Env&&...) noexcept
+          -> __sender_base::completion_signatures {
+          return {};
+        }
+
+        template <stdexec::receiver_of<_Completions> _Receiver>
+        auto connect(_Receiver __rcvr) && -> stdexec::connect_result_t<__sender_base, _Receiver> {
+          return static_cast<__sender_base&&>(__sender_).connect(static_cast<_Receiver&&>(__rcvr));
+        }
+
+        auto get_env() const noexcept -> stdexec::env_of_t<__sender_base> {
+          return __sender_.get_env();
+        }
+      };
+
       template <auto... _SchedulerQueries>
       class any_scheduler {
         // Add the required set_value_t() completions to the schedule-sender.
@@ -1271,7 +1588,8 @@ namespace exec {
           _Completions,
           stdexec::completion_signatures<stdexec::set_value_t()>
         >;
-        using __schedule_receiver = any_receiver_ref<__schedule_completions, _ReceiverQueries...>;
+        using __schedule_receiver =
+          basic_any_receiver_ref<__schedule_completions, _Storage, _ReceiverQueries...>;
 
         template <typename _Tag, typename _Sig>
         static auto __ret_fn(_Tag (*const)(_Sig)) -> _Tag;
@@ -1339,4 +1657,8 @@ namespace exec {
       };
     };
   };
+
+  template <class _Completions, auto... _ReceiverQueries>
+  using any_receiver_ref =
+    basic_any_receiver_ref<_Completions, any_sender_storage<>, _ReceiverQueries...>;
 } // namespace exec
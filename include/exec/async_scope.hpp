@@ -19,10 +19,18 @@
 #include "../stdexec/stop_token.hpp"
 #include "../stdexec/__detail/__intrusive_queue.hpp"
 #include "../stdexec/__detail/__optional.hpp"
+#include "__detail/__thread_index.hpp"
 #include "env.hpp"
 
+#include <algorithm>
 #include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include <new>
+#include <utility>
 
 namespace exec {
   /////////////////////////////////////////////////////////////////////////////
@@ -47,17 +55,265 @@ namespace exec {
     template <class _BaseEnv>
     using __env_t = make_env_t<_BaseEnv, prop<get_stop_token_t, inplace_stop_token>>;
 
+    // Counts the operations that are nested in a scope. The count is split across shards, each on
+    // its own cache line, so that operations started on different threads do not contend. An
+    // operation decrements the shard that it incremented, so no shard ever goes negative. Besides
+    // the number of active operations in its low half, each shard counts the operations started
+    // on it in its high half, which lets __drained() detect concurrent starts.
+    class __active_count {
+      static constexpr std::size_t __num_shards = 64;
+      static constexpr std::uint64_t __count_mask = 0xFFFF'FFFF;
+      static constexpr std::uint64_t __start = (std::uint64_t{1} << 32) | 1;
+
+      struct alignas(64) __shard {
+        std::atomic<std::uint64_t> __value_{0};
+      };
+
+      __shard __shards_[__num_shards]{};
+
+      auto __collect(std::uint64_t (&__values)[__num_shards]) const noexcept -> bool {
+        for (std::size_t __i = 0; __i < __num_shards; ++__i) {
+          __values[__i] = __shards_[__i].__value_.load(std::memory_order_seq_cst);
+          if ((__values[__i] & __count_mask) != 0) {
+            return false;
+          }
+        }
+        return true;
+      }
+
+     public:
+      // Returns the shard to pass to __decrement() when the operation completes.
+      auto __increment() noexcept -> std::size_t {
+        const std::size_t __index = exec::__this_thread_index() % __num_shards;
+        __shards_[__index].__value_.fetch_add(__start, std::memory_order_relaxed);
+        return __index;
+      }
+
+      // Returns true if the shard has no more active operations.
+      auto __decrement(std::size_t __index) noexcept -> bool {
+        return (__shards_[__index].__value_.fetch_sub(1, std::memory_order_seq_cst) & __count_mask)
+            == 1;
+      }
+
+      // Returns true if there was a moment during the call at which no operation was active. Two
+      // collects that find every shard idle and no operation started in between prove that all
+      // shards were idle at the moment the first collect ended.
+      [[nodiscard]]
+      auto __drained() const noexcept -> bool {
+        std::uint64_t __first[__num_shards];
+        std::uint64_t __second[__num_shards];
+        while (true) {
+          if (!__collect(__first) || !__collect(__second)) {
+            return false;
+          }
+          if (std::equal(std::begin(__first), std::end(__first), std::begin(__second))) {
+            return true;
+          }
+        }
+      }
+    };
+
+    // Recycles the memory of spawned operations. Freed blocks are kept on per-size-class free
+    // lists, which are sharded by thread to keep concurrent spawns from contending on one lock.
+    // An operation is often freed on a different thread than the one that spawned it, so a
+    // thread whose own shard is empty takes a block from the other shards before it allocates.
+    class __spawn_pool : __immovable {
+      struct __block {
+        __block* __next_;
+      };
+
+      static constexpr std::size_t __num_shards = 16;
+      static constexpr std::size_t __min_shift = 5;
+      static constexpr std::size_t __num_classes = 8;
+      static constexpr std::size_t __max_size = std::size_t{1} << (__min_shift + __num_classes - 1);
+
+      struct alignas(64) __shard {
+        std::mutex __mutex_{};
+        __block* __free_[__num_classes]{};
+      };
+
+      static auto __size_class(std::size_t __size) noexcept -> std::size_t {
+        const auto __width = static_cast<std::size_t>(std::bit_width(__size - 1));
+        return __width <= __min_shift ? 0 : __width - __min_shift;
+      }
+
+      auto __this_shard_index() noexcept -> std::size_t {
+        return exec::__this_thread_index() % __num_shards;
+      }
+
+      static auto __pop(__shard& __s, std::size_t __class) noexcept -> __block* {
+        __block* __head = __s.__free_[__class];
+        if (__head != nullptr) {
+          __s.__free_[__class] = __head->__next_;
+        }
+        return __head;
+      }
+
+      // Counts the blocks that were allocated rather than reused.
+      auto __allocate_new(std::size_t __size) -> void* {
+        __num_allocations_.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(__size);
+      }
+
+      __shard __shards_[__num_shards]{};
+      std::atomic<std::size_t> __num_allocations_{0};
+
+     public:
+      __spawn_pool() = default;
+
+      ~__spawn_pool() {
+        for (__shard& __s: __shards_) {
+          for (__block* __head: __s.__free_) {
+            while (__head != nullptr) {
+              ::operator delete(std::exchange(__head, __head->__next_));
+            }
+          }
+        }
+      }
+
+      auto __allocate(std::size_t __size) -> void* {
+        if (__size > __max_size) {
+          return __allocate_new(__size);
+        }
+        const std::size_t __class = __size_class(__size);
+        const std::size_t __index = __this_shard_index();
+        __shard& __own = __shards_[__index];
+        {
+          std::lock_guard __guard{__own.__mutex_};
+          if (__block* __head = __pop(__own, __class)) {
+            return __head;
+          }
+        }
+        // Take a whole free list from another shard, so that the next allocations on this
+        // thread find blocks in their own shard again.
+        for (std::size_t __i = 1; __i < __num_shards; ++__i) {
+          __shard& __s = __shards_[(__index + __i) % __num_shards];
+          __block* __list = nullptr;
+          {
+            std::lock_guard __guard{__s.__mutex_};
+            __list = std::exchange(__s.__free_[__class], nullptr);
+          }
+          if (__list != nullptr) {
+            if (__list->__next_ != nullptr) {
+              __block* __tail = __list->__next_;
+              while (__tail->__next_ != nullptr) {
+                __tail = __tail->__next_;
+              }
+              std::lock_guard __guard{__own.__mutex_};
+              __tail->__next_ = __own.__free_[__class];
+              __own.__free_[__class] = __list->__next_;
+            }
+            return __list;
+          }
+        }
+        return __allocate_new(std::size_t{1} << (__class + __min_shift));
+      }
+
+      //! The number of allocations that could not be served from the free lists.
+      [[nodiscard]]
+      auto __num_allocations() const noexcept -> std::size_t {
+        return __num_allocations_.load(std::memory_order_relaxed);
+      }
+
+      void __deallocate(void* __pointer, std::size_t __size) noexcept {
+        if (__size > __max_size) {
+          ::operator delete(__pointer);
+          return;
+        }
+        const std::size_t __class = __size_class(__size);
+        auto* __head = ::new (__pointer) __block{nullptr};
+        __shard& __s = __shards_[__this_shard_index()];
+        std::lock_guard __guard{__s.__mutex_};
+        __head->__next_ = __s.__free_[__class];
+        __s.__free_[__class] = __head;
+      }
+    };
+
+    template <class _Ty>
+    struct __spawn_pool_allocator {
+      using value_type = _Ty;
+
+      __spawn_pool* __pool_;
+
+      explicit __spawn_pool_allocator(__spawn_pool* __pool) noexcept
+        : __pool_{__pool} {
+      }
+
+      template <class _Uy>
+      __spawn_pool_allocator(const __spawn_pool_allocator<_Uy>& __other) noexcept
+        : __pool_{__other.__pool_} {
+      }
+
+      auto allocate(std::size_t __n) -> _Ty* {
+        static_assert(alignof(_Ty) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        return static_cast<_Ty*>(__pool_->__allocate(__n * sizeof(_Ty)));
+      }
+
+      void deallocate(_Ty* __pointer, std::size_t __n) noexcept {
+        __pool_->__deallocate(__pointer, __n * sizeof(_Ty));
+      }
+
+      template <class _Uy>
+      auto operator==(const __spawn_pool_allocator<_Uy>& __other) const noexcept -> bool {
+        return __pool_ == __other.__pool_;
+      }
+    };
+
+    template <class _Ty, class _Alloc, class... _Args>
+    auto __allocate_construct(const _Alloc& __alloc, _Args&&... __args) -> _Ty* {
+      using _TyAlloc = std::allocator_traits<_Alloc>::template rebind_alloc<_Ty>;
+      _TyAlloc __ty_alloc{__alloc};
+      _Ty* __pointer = std::allocator_traits<_TyAlloc>::allocate(__ty_alloc, 1);
+      __scope_guard __guard{[&]() noexcept {
+        std::allocator_traits<_TyAlloc>::deallocate(__ty_alloc, __pointer, 1);
+      }};
+      // For spawned operations, this starts the operation, which may complete and destroy
+      // itself before construct() returns.
+      std::allocator_traits<_TyAlloc>::construct(
+        __ty_alloc, __pointer, static_cast<_Args&&>(__args)...);
+      __guard.__dismiss();
+      return __pointer;
+    }
+
+    template <class _Ty, class _Alloc>
+    void __destroy_deallocate(_Alloc __alloc, _Ty* __pointer) noexcept {
+      using _TyAlloc = std::allocator_traits<_Alloc>::template rebind_alloc<_Ty>;
+      _TyAlloc __ty_alloc{__alloc};
+      std::allocator_traits<_TyAlloc>::destroy(__ty_alloc, __pointer);
+      std::allocator_traits<_TyAlloc>::deallocate(__ty_alloc, __pointer, 1);
+    }
+
     struct __impl {
       inplace_stop_source __stop_source_{};
       mutable std::mutex __lock_{};
-      mutable std::atomic_ptrdiff_t __active_ = 0;
+      mutable __active_count __active_{};
+      // Set while __waiters_ is non-empty. Completions only look for waiters when it is set.
+      mutable std::atomic<bool> __has_waiters_{false};
       mutable __intrusive_queue<&__task::__next_> __waiters_{};
+      mutable __spawn_pool __pool_{};
 
       ~__impl() {
         std::unique_lock __guard{__lock_};
-        STDEXEC_ASSERT(__active_ == 0);
+        STDEXEC_ASSERT(__active_.__drained());
         STDEXEC_ASSERT(__waiters_.empty());
       }
+
+      // Starts the waiters if the scope is empty. Must be called with __lock_ held, which is
+      // released before the waiters are started.
+      void __notify_if_empty(std::unique_lock<std::mutex>& __guard) const noexcept {
+        if (__waiters_.empty() || !__active_.__drained()) {
+          return;
+        }
+        auto __local_waiters = std::move(__waiters_);
+        __has_waiters_.store(false, std::memory_order_relaxed);
+        __guard.unlock();
+        // do not access this
+        while (!__local_waiters.empty()) {
+          auto* __next = __local_waiters.pop_front();
+          __next->__notify_waiter(__next);
+          // the scope must be considered deleted
+        }
+      }
     };
 
     ////////////////////////////////////////////////////////////////////////////
@@ -79,17 +335,14 @@ namespace exec {
         }
 
         void start() & noexcept {
-          // must get lock before checking __active, or if the __active is drained before
-          // the waiter is queued but after __active is checked, the waiter will never be notified
-          std::unique_lock __guard{this->__scope_->__lock_};
-          auto& __active = this->__scope_->__active_;
-          auto& __waiters = this->__scope_->__waiters_;
-          if (__active.load(std::memory_order_acquire) != 0) {
-            __waiters.push_back(this);
-            return;
-          }
-          __guard.unlock();
-          stdexec::start(this->__op_);
+          // The waiter is queued and __has_waiters_ is set before the active count is checked.
+          // A completion that drains the count afterwards sees __has_waiters_ and notifies the
+          // waiter; otherwise the check below sees the count drained.
+          auto* __scope = this->__scope_;
+          std::unique_lock __guard{__scope->__lock_};
+          __scope->__waiters_.push_back(this);
+          __scope->__has_waiters_.store(true, std::memory_order_seq_cst);
+          __scope->__notify_if_empty(__guard);
         }
 
        private:
@@ -144,6 +397,7 @@ namespace exec {
       using _Receiver = stdexec::__t<_ReceiverId>;
       const __impl* __scope_;
       STDEXEC_ATTRIBUTE(no_unique_address) _Receiver __rcvr_;
+      std::size_t __shard_{0};
     };
 
     template <class _ReceiverId>
@@ -155,19 +409,14 @@ namespace exec {
         using receiver_concept = stdexec::receiver_t;
         __nest_op_base<_ReceiverId>* __op_;
 
-        static void __complete(const __impl* __scope) noexcept {
-          auto& __active = __scope->__active_;
-          if (__active.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        static void __complete(const __impl* __scope, std::size_t __shard) noexcept {
+          // Only the completion that drains its shard can be the one that empties the scope.
+          if (
+            __scope->__active_.__decrement(__shard)
+            && __scope->__has_waiters_.load(std::memory_order_seq_cst)) {
             std::unique_lock __guard{__scope->__lock_};
-            auto __local_waiters = std::move(__scope->__waiters_);
-            __guard.unlock();
-            __scope = nullptr;
+            __scope->__notify_if_empty(__guard);
             // do not access __scope
-            while (!__local_waiters.empty()) {
-              auto* __next = __local_waiters.pop_front();
-              __next->__notify_waiter(__next);
-              // __scope must be considered deleted
-            }
           }
         }
 
@@ -175,30 +424,33 @@ namespace exec {
           requires __callable<set_value_t, _Receiver, _As...>
         void set_value(_As&&... __as) noexcept {
           auto __scope = __op_->__scope_;
+          auto __shard = __op_->__shard_;
           stdexec::set_value(std::move(__op_->__rcvr_), static_cast<_As&&>(__as)...);
           // do not access __op_
           // do not access this
-          __complete(__scope);
+          __complete(__scope, __shard);
         }
 
         template <class _Error>
           requires __callable<set_error_t, _Receiver, _Error>
         void set_error(_Error&& __err) noexcept {
           auto __scope = __op_->__scope_;
+          auto __shard = __op_->__shard_;
           stdexec::set_error(std::move(__op_->__rcvr_), static_cast<_Error&&>(__err));
           // do not access __op_
           // do not access this
-          __complete(__scope);
+          __complete(__scope, __shard);
         }
 
         void set_stopped() noexcept
           requires __callable<set_stopped_t, _Receiver>
         {
           auto __scope = __op_->__scope_;
+          auto __shard = __op_->__shard_;
           stdexec::set_stopped(std::move(__op_->__rcvr_));
           // do not access __op_
           // do not access this
-          __complete(__scope);
+          __complete(__scope, __shard);
         }
 
         auto get_env() const noexcept -> __env_t<env_of_t<_Receiver>> {
@@ -228,8 +480,7 @@ namespace exec {
 
         void start() & noexcept {
           STDEXEC_ASSERT(this->__scope_);
-          auto& __active = this->__scope_->__active_;
-          __active.fetch_add(1, std::memory_order_relaxed);
+          this->__shard_ = this->__scope_->__active_.__increment();
           stdexec::start(__op_);
         }
       };
@@ -274,16 +525,32 @@ namespace exec {
 
     ////////////////////////////////////////////////////////////////////////////
     // async_scope::spawn_future implementation
-    enum class __future_step {
-      __invalid = 0,
-      __created,
-      __future,
-      __no_future,
-      __deleted
+    template <class _Sender, class _Env>
+    struct __future_state;
+
+    template <class _State>
+    struct __future_state_delete {
+      void operator()(_State* __state) const noexcept {
+        _State::__destroy_delete(__state);
+      }
     };
 
     template <class _Sender, class _Env>
-    struct __future_state;
+    using __future_state_ptr = std::unique_ptr<
+      __future_state<_Sender, _Env>,
+      __future_state_delete<__future_state<_Sender, _Env>>
+    >;
+
+    // Future states use the allocator of the environment passed to spawn_future, if any. They
+    // can outlive the scope, so they are not allocated from the scope's pool.
+    template <class _Env>
+    auto __future_allocator(const _Env& __env) noexcept {
+      if constexpr (__callable<get_allocator_t, const _Env&>) {
+        return stdexec::get_allocator(__env);
+      } else {
+        return std::allocator<std::byte>{};
+      }
+    }
 
     struct __forward_stopped {
       inplace_stop_source* __stop_source_;
@@ -299,8 +566,6 @@ namespace exec {
       void __complete() noexcept {
         __complete_(this);
       }
-
-      __subscription* __next_ = nullptr;
     };
 
     template <class _SenderId, class _EnvId, class _ReceiverId>
@@ -318,29 +583,17 @@ namespace exec {
             __forward_consumer_.reset();
             auto __state = std::move(__state_);
             STDEXEC_ASSERT(__state != nullptr);
-            std::unique_lock __guard{__state->__mutex_};
-            // either the future is still in use or it has passed ownership to __state->__no_future_
-            if (
-              __state->__no_future_.get() != nullptr
-              || __state->__step_ != __future_step::__future) {
-              // invalid state - there is a code bug in the state machine
-              std::terminate();
-            } else if (get_stop_token(get_env(__rcvr_)).stop_requested()) {
-
-              __guard.unlock();
+            if (get_stop_token(get_env(__rcvr_)).stop_requested()) {
               stdexec::set_stopped(static_cast<_Receiver&&>(__rcvr_));
-              __guard.lock();
             } else {
               std::visit(
-                [this, &__guard]<class _Tup>(_Tup& __tup) {
+                [this]<class _Tup>(_Tup& __tup) {
                   if constexpr (same_as<_Tup, std::monostate>) {
                     std::terminate();
                   } else {
                     std::apply(
-                      [this, &__guard]<class... _As>(auto tag, _As&... __as) {
-                        __guard.unlock();
+                      [this]<class... _As>(auto tag, _As&... __as) {
                         tag(static_cast<_Receiver&&>(__rcvr_), static_cast<_As&&>(__as)...);
-                        __guard.lock();
                       },
                       __tup);
                   }
@@ -355,7 +608,7 @@ namespace exec {
         }
 
         STDEXEC_ATTRIBUTE(no_unique_address) _Receiver __rcvr_;
-        std::unique_ptr<__future_state<_Sender, _Env>> __state_;
+        __future_state_ptr<_Sender, _Env> __state_;
         STDEXEC_ATTRIBUTE(no_unique_address)
         stdexec::__optional<__forward_consumer> __forward_consumer_;
 
@@ -363,23 +616,15 @@ namespace exec {
         using __id = __future_op;
 
         ~__t() noexcept {
-          if (__state_ != nullptr) {
-            auto __raw_state = __state_.get();
-            std::unique_lock __guard{__raw_state->__mutex_};
-            if (__raw_state->__data_.index() > 0) {
-              // completed given sender
-              // state is no longer needed
-              return;
-            }
-            __raw_state->__no_future_ = std::move(__state_);
-            __raw_state
-              ->__step_from_to_(__guard, __future_step::__future, __future_step::__no_future);
+          if (__state_ != nullptr && !__state_->__abandon()) {
+            // the state deletes itself when the given sender completes
+            (void) __state_.release();
           }
         }
 
         template <class _Receiver2>
         explicit __t(
-          _Receiver2&& __rcvr, std::unique_ptr<__future_state<_Sender, _Env>> __state)
+          _Receiver2&& __rcvr, __future_state_ptr<_Sender, _Env> __state)
           : __subscription{{},
             [](__subscription* __self) noexcept -> void {
                 static_cast<__t*>(__self)->__complete_();
@@ -391,19 +636,9 @@ namespace exec {
         }
 
         void start() & noexcept {
-          STDEXEC_TRY {
-            if (!!__state_) {
-              std::unique_lock __guard{__state_->__mutex_};
-              if (__state_->__data_.index() != 0) {
-                __guard.unlock();
-                __complete_();
-              } else {
-                __state_->__subscribers_.push_back(this);
-              }
-            }
-          }
-          STDEXEC_CATCH_ALL {
-            stdexec::set_error(static_cast<_Receiver&&>(__rcvr_), std::current_exception());
+          if (!!__state_ && !__state_->__subscribe(this)) {
+            // the given sender has already completed
+            __complete_();
           }
         }
       };
@@ -451,69 +686,69 @@ namespace exec {
       _Completions
     >;
 
-    template <class _Ty>
-    struct __dynamic_delete {
-      __dynamic_delete()
-        : __delete_([](_Ty* __p) { delete __p; }) {
-      }
-
-      template <class _Uy>
-        requires convertible_to<_Uy*, _Ty*>
-      __dynamic_delete(std::default_delete<_Uy>)
-        : __delete_([](_Ty* __p) { delete static_cast<_Uy*>(__p); }) {
-      }
-
-      template <class _Uy>
-        requires convertible_to<_Uy*, _Ty*>
-      auto operator=(std::default_delete<_Uy> __d) -> __dynamic_delete& {
-        __delete_ = __dynamic_delete{__d}.__delete_;
-        return *this;
-      }
-
-      void operator()(_Ty* __p) {
-        __delete_(__p);
-      }
-
-      void (*__delete_)(_Ty*);
-    };
-
     template <class _Completions, class _Env>
     struct __future_state_base {
-      __future_state_base(_Env __env, const __impl* __scope)
+      __future_state_base(
+        _Env __env,
+        const __impl* __scope,
+        void (*__delete)(__future_state_base*) noexcept)
         : __forward_scope_{std::in_place, __scope->__stop_source_.get_token(), __forward_stopped{&__stop_source_}}
         , __env_(make_env(
             static_cast<_Env&&>(__env),
-            stdexec::prop{get_stop_token, __scope->__stop_source_.get_token()})) {
+            stdexec::prop{get_stop_token, __scope->__stop_source_.get_token()}))
+        , __delete_{__delete} {
+      }
+
+      // Publishes the result. Whoever is last, the future or the given sender, deletes the state.
+      void __complete() noexcept {
+        __forward_scope_.reset();
+        const std::uintptr_t __prev = __state_.exchange(__completed, std::memory_order_acq_rel);
+        if (__prev == __abandoned) {
+          __delete_(this);
+        } else if (__prev != __pending) {
+          // do not access this, the subscriber deletes the state
+          reinterpret_cast<__subscription*>(__prev)->__complete();
+        }
       }
 
-      ~__future_state_base() {
-        std::unique_lock __guard{__mutex_};
-        if (__step_ == __future_step::__created) {
-          // exception during connect() will end up here
-          __step_from_to_(__guard, __future_step::__created, __future_step::__deleted);
-        } else if (__step_ != __future_step::__deleted) {
-          // completing the given sender before the future is dropped will end here
-          __step_from_to_(__guard, __future_step::__future, __future_step::__deleted);
+      // Returns false if the result is already available.
+      auto __subscribe(__subscription* __sub) noexcept -> bool {
+        std::uintptr_t __expected = __pending;
+        if (__state_.compare_exchange_strong(
+              __expected,
+              reinterpret_cast<std::uintptr_t>(__sub),
+              std::memory_order_acq_rel,
+              std::memory_order_acquire)) {
+          return true;
         }
+        STDEXEC_ASSERT(__expected == __completed);
+        return false;
       }
 
-      void __step_from_to_(
-        std::unique_lock<std::mutex>& __guard,
-        __future_step __from,
-        __future_step __to) {
-        STDEXEC_ASSERT(__guard.owns_lock());
-        auto actual = std::exchange(__step_, __to);
-        STDEXEC_ASSERT(actual == __from);
+      // Called when the future is dropped without waiting for the result. Returns true if the
+      // result is already available, in which case the caller deletes the state.
+      auto __abandon() noexcept -> bool {
+        std::uintptr_t __expected = __pending;
+        if (__state_.compare_exchange_strong(
+              __expected, __abandoned, std::memory_order_acq_rel, std::memory_order_acquire)) {
+          return false;
+        }
+        STDEXEC_ASSERT(__expected == __completed);
+        return true;
       }
 
+      // Either __pending, __completed, __abandoned, or the address of the subscription of the
+      // future's operation that is waiting for the result.
+      static constexpr std::uintptr_t __pending = 0;
+      static constexpr std::uintptr_t __completed = 1;
+      static constexpr std::uintptr_t __abandoned = 2;
+
       inplace_stop_source __stop_source_;
       stdexec::__optional<inplace_stop_callback<__forward_stopped>> __forward_scope_;
-      std::mutex __mutex_;
-      __future_step __step_ = __future_step::__created;
-      std::unique_ptr<__future_state_base, __dynamic_delete<__future_state_base>> __no_future_;
+      std::atomic<std::uintptr_t> __state_{__pending};
       __completions_as_variant<_Completions> __data_;
-      __intrusive_queue<&__subscription::__next_> __subscribers_;
       __env_t<_Env> __env_;
+      void (*__delete_)(__future_state_base*) noexcept;
     };
 
     template <class _Completions, class _EnvId>
@@ -526,25 +761,6 @@ namespace exec {
         __future_state_base<_Completions, _Env>* __state_;
         const __impl* __scope_;
 
-        void __dispatch_result_(std::unique_lock<std::mutex>& __guard) noexcept {
-          auto& __state = *__state_;
-          auto __local_subscribers = std::move(__state.__subscribers_);
-          __state.__forward_scope_.reset();
-          if (__state.__no_future_.get() != nullptr) {
-            // nobody is waiting for the results
-            // delete this and return
-            __state.__step_from_to_(__guard, __future_step::__no_future, __future_step::__deleted);
-            __guard.unlock();
-            __state.__no_future_.reset();
-            return;
-          }
-          __guard.unlock();
-          while (!__local_subscribers.empty()) {
-            auto* __sub = __local_subscribers.pop_front();
-            __sub->__complete();
-          }
-        }
-
         template <class _Tag, class... _As>
         void __save_completion(_Tag, _As&&... __as) noexcept {
           auto& __state = *__state_;
@@ -560,25 +776,19 @@ namespace exec {
 
         template <__movable_value... _As>
         void set_value(_As&&... __as) noexcept {
-          auto& __state = *__state_;
-          std::unique_lock __guard{__state.__mutex_};
           __save_completion(set_value_t(), static_cast<_As&&>(__as)...);
-          __dispatch_result_(__guard);
+          __state_->__complete();
         }
 
         template <__movable_value _Error>
         void set_error(_Error&& __err) noexcept {
-          auto& __state = *__state_;
-          std::unique_lock __guard{__state.__mutex_};
           __save_completion(set_error_t(), static_cast<_Error&&>(__err));
-          __dispatch_result_(__guard);
+          __state_->__complete();
         }
 
         void set_stopped() noexcept {
-          auto& __state = *__state_;
-          std::unique_lock __guard{__state.__mutex_};
           __save_completion(set_stopped_t());
-          __dispatch_result_(__guard);
+          __state_->__complete();
         }
 
         auto get_env() const noexcept -> const __env_t<_Env>& {
@@ -596,7 +806,12 @@ namespace exec {
       using _Completions = __future_completions_t<_Sender, _Env>;
 
       __future_state(connect_t, _Sender&& __sndr, _Env __env, const __impl* __scope)
-        : __future_state_base<_Completions, _Env>(static_cast<_Env&&>(__env), __scope)
+        : __future_state_base<_Completions, _Env>(
+            static_cast<_Env&&>(__env),
+            __scope,
+            [](__future_state_base<_Completions, _Env>* __self) noexcept {
+              __destroy_delete(static_cast<__future_state*>(__self));
+            })
         , __op_(static_cast<_Sender&&>(__sndr), __future_receiver_t<_Sender, _Env>{this, __scope}) {
       }
 
@@ -613,6 +828,10 @@ namespace exec {
           static_cast<_Sender&&>(__sndr), __future_receiver_t<_Sender, _Env>{this, __scope});
       }
 
+      static void __destroy_delete(__future_state* __self) noexcept {
+        __scope::__destroy_deallocate(__scope::__future_allocator(__self->__env_), __self);
+      }
+
       STDEXEC_ATTRIBUTE(no_unique_address)
       submit_result<_Sender, __future_receiver_t<_Sender, _Env>> __op_{};
     };
@@ -638,17 +857,9 @@ namespace exec {
         auto operator=(__t&&) -> __t& = default;
 
         ~__t() noexcept {
-          if (__state_ != nullptr) {
-            auto __raw_state = __state_.get();
-            std::unique_lock __guard{__raw_state->__mutex_};
-            if (__raw_state->__data_.index() != 0) {
-              // completed given sender
-              // state is no longer needed
-              return;
-            }
-            __raw_state->__no_future_ = std::move(__state_);
-            __raw_state
-              ->__step_from_to_(__guard, __future_step::__future, __future_step::__no_future);
+          if (__state_ != nullptr && !__state_->__abandon()) {
+            // the state deletes itself when the given sender completes
+            (void) __state_.release();
           }
         }
 
@@ -667,13 +878,11 @@ namespace exec {
        private:
         friend struct async_scope;
 
-        explicit __t(std::unique_ptr<__future_state<_Sender, _Env>> __state) noexcept
+        explicit __t(__future_state_ptr<_Sender, _Env> __state) noexcept
           : __state_(std::move(__state)) {
-          std::unique_lock __guard{__state_->__mutex_};
-          __state_->__step_from_to_(__guard, __future_step::__created, __future_step::__future);
         }
 
-        std::unique_ptr<__future_state<_Sender, _Env>> __state_;
+        __future_state_ptr<_Sender, _Env> __state_;
       };
     };
 
@@ -700,6 +909,18 @@ namespace exec {
     template <class _Env>
     using __spawn_env_t = __join_env_t<_Env, __spawn_env_>;
 
+    // Spawned operations use the allocator of the environment passed to spawn, if any, and the
+    // scope's pool otherwise. Scopes outlive the operations spawned in them, because an
+    // operation is destroyed before it decrements the scope's count of active operations.
+    template <class _Env>
+    auto __spawn_allocator(const _Env& __env, const __impl* __scope) noexcept {
+      if constexpr (__callable<get_allocator_t, const _Env&>) {
+        return stdexec::get_allocator(__env);
+      } else {
+        return __spawn_pool_allocator<std::byte>{&__scope->__pool_};
+      }
+    }
+
     template <class _EnvId>
     struct __spawn_op_base {
       using _Env = stdexec::__t<_EnvId>;
@@ -751,7 +972,12 @@ namespace exec {
             >{__env::__join(
                 static_cast<_Env&&>(__env),
                 __spawn_env_{__scope->__stop_source_.get_token()}),
-              [](__spawn_op_base<_EnvId>* __op) { delete static_cast<__t*>(__op); }}
+              [](__spawn_op_base<_EnvId>* __op) {
+                auto* __self = static_cast<__t*>(__op);
+                __scope::__destroy_deallocate(
+                  __spawn_allocator(__self->__env_, __self->__scope_), __self);
+              }}
+          , __scope_{__scope}
           , __data_(static_cast<_Sender&&>(__sndr), __spawn_receiver_t<_Env>{this}) {
         }
 
@@ -767,6 +993,7 @@ namespace exec {
           __data_.submit(static_cast<_Sender&&>(__sndr), __spawn_receiver_t<_Env>{this});
         }
 
+        const __impl* __scope_;
         STDEXEC_ATTRIBUTE(no_unique_address)
         submit_result<_Sender, __spawn_receiver_t<_Env>> __data_;
       };
@@ -800,22 +1027,30 @@ namespace exec {
         return nest_result_t<_Constrained>{&__impl_, static_cast<_Constrained&&>(__c)};
       }
 
+      //! Starts `__sndr` in this scope without waiting for it. The operation state is allocated
+      //! with the allocator returned by `get_allocator(__env)`, if there is one, and otherwise
+      //! from a pool owned by the scope that recycles the memory of completed operations. To
+      //! opt out of the pool, pass an `__env` whose `get_allocator` returns `std::allocator`.
       template <__movable_value _Env = env<>, sender_in<__spawn_env_t<_Env>> _Sender>
         requires sender_to<nest_result_t<_Sender>, __spawn_receiver_t<_Env>>
       void spawn(_Sender&& __sndr, _Env __env = {}) {
         using __op_t = __spawn_operation_t<nest_result_t<_Sender>, _Env>;
+        auto __alloc = __scope::__spawn_allocator(__env, &__impl_);
         // this will connect and start the operation, after which the operation state is
         // responsible for deleting itself after it completes.
-        [[maybe_unused]]
-        auto* __op =
-          new __op_t{nest(static_cast<_Sender&&>(__sndr)), static_cast<_Env&&>(__env), &__impl_};
+        __scope::__allocate_construct<__op_t>(
+          __alloc, nest(static_cast<_Sender&&>(__sndr)), static_cast<_Env&&>(__env), &__impl_);
       }
 
+      //! Starts `__sndr` in this scope and returns a sender of its result. The shared state is
+      //! allocated with the allocator returned by `get_allocator(__env)`, if there is one.
       template <__movable_value _Env = env<>, sender_in<__env_t<_Env>> _Sender>
       auto spawn_future(_Sender&& __sndr, _Env __env = {}) -> __future_t<_Sender, _Env> {
         using __state_t = __future_state<nest_result_t<_Sender>, _Env>;
-        auto __state = std::make_unique<__state_t>(
-          nest(static_cast<_Sender&&>(__sndr)), static_cast<_Env&&>(__env), &__impl_);
+        auto __alloc = __scope::__future_allocator(__env);
+        __future_state_ptr<nest_result_t<_Sender>, _Env> __state{
+          __scope::__allocate_construct<__state_t>(
+            __alloc, nest(static_cast<_Sender&&>(__sndr)), static_cast<_Env&&>(__env), &__impl_)};
         return __future_t<_Sender, _Env>{std::move(__state)};
       }
 
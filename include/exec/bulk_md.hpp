@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace exec {
+  //! The extents of a multidimensional index space, e.g. `mdshape{rows, cols}`.
+  template <std::size_t _Rank>
+  class mdshape {
+    static_assert(_Rank > 0, "An mdshape must have at least one dimension.");
+
+    std::array<std::size_t, _Rank> __extents_{};
+
+   public:
+    constexpr mdshape() = default;
+
+    template <std::integral... _Extents>
+      requires(sizeof...(_Extents) == _Rank)
+    constexpr mdshape(_Extents... __extents) noexcept
+      : __extents_{static_cast<std::size_t>(__extents)...} {
+    }
+
+    static constexpr auto rank() noexcept -> std::size_t {
+      return _Rank;
+    }
+
+    [[nodiscard]]
+    constexpr auto extent(std::size_t __dim) const noexcept -> std::size_t {
+      return __extents_[__dim];
+    }
+
+    [[nodiscard]]
+    constexpr auto size() const noexcept -> std::size_t {
+      std::size_t __size = 1;
+      for (std::size_t __extent: __extents_) {
+        __size *= __extent;
+      }
+      return __size;
+    }
+
+    friend constexpr auto operator==(const mdshape&, const mdshape&) noexcept -> bool = default;
+  };
+
+  template <std::integral... _Extents>
+  mdshape(_Extents...) -> mdshape<sizeof...(_Extents)>;
+
+  /////////////////////////////////////////////////////////////////////////////
+  // bulk_md(sndr, policy, shape, [tile,] fun)
+  //
+  // Like stdexec::bulk over a multidimensional index space: calls `fun(i0, i1, ..., values...)`
+  // for every index of the mdshape `shape`. The space is cut into tiles of extents `tile` (by
+  // default about 4096 indices, as square as possible), the tiles are put in Morton (Z-curve)
+  // order, and that sequence of tiles is handed to stdexec::bulk_chunked. A scheduler that
+  // splits bulk_chunked into contiguous ranges -- static_thread_pool does -- thus gives each
+  // execution agent a compact region of the space instead of a stripe of whole rows, and
+  // within a tile the last dimension varies fastest.
+  namespace __bulk_md {
+    using namespace stdexec;
+
+    template <std::size_t _Rank>
+    using __index_t = std::array<std::size_t, _Rank>;
+
+    template <std::size_t _Rank>
+    constexpr auto __default_tile_extent() noexcept -> std::size_t {
+      // The largest t with t^_Rank <= 4096.
+      std::size_t __t = 1;
+      auto __pow = [](std::size_t __b) {
+        std::size_t __p = 1;
+        for (std::size_t __i = 0; __i < _Rank; ++__i) {
+          __p *= __b;
+        }
+        return __p;
+      };
+      while (__pow(__t + 1) <= 4096) {
+        ++__t;
+      }
+      return __t;
+    }
+
+    template <std::size_t _Rank>
+    constexpr auto __default_tile() noexcept -> mdshape<_Rank> {
+      mdshape<_Rank> __tile;
+      [&]<std::size_t... _Is>(std::index_sequence<_Is...>) {
+        __tile = mdshape<_Rank>{((void) _Is, __default_tile_extent<_Rank>())...};
+      }(std::make_index_sequence<_Rank>{});
+      return __tile;
+    }
+
+    // Appends, in Morton order, the coordinates of the tiles of the grid `__grid` that lie in
+    // the power-of-two box of side 2^__level whose corner is `__corner`. Boxes entirely
+    // outside the grid are skipped, so the cost is proportional to the number of tiles.
+    template <std::size_t _Rank>
+    void __append_morton(
+      const __index_t<_Rank>& __grid,
+      __index_t<_Rank> __corner,
+      std::size_t __level,
+      std::vector<__index_t<_Rank>>& __out) {
+      for (std::size_t __dim = 0; __dim < _Rank; ++__dim) {
+        if (__corner[__dim] >= __grid[__dim]) {
+          return;
+        }
+      }
+      if (__level == 0) {
+        __out.push_back(__corner);
+        return;
+      }
+      const std::size_t __half = std::size_t{1} << (__level - 1);
+      for (std::size_t __child = 0; __child < (std::size_t{1} << _Rank); ++__child) {
+        __index_t<_Rank> __sub = __corner;
+        for (std::size_t __dim = 0; __dim < _Rank; ++__dim) {
+          // The last dimension takes the lowest bit, so it varies fastest.
+          if (__child & (std::size_t{1} << (_Rank - 1 - __dim))) {
+            __sub[__dim] += __half;
+          }
+        }
+        __bulk_md::__append_morton<_Rank>(__grid, __sub, __level - 1, __out);
+      }
+    }
+
+    template <std::size_t _Rank>
+    auto __morton_tiles(const mdshape<_Rank>& __shape, const mdshape<_Rank>& __tile)
+      -> std::vector<__index_t<_Rank>> {
+      __index_t<_Rank> __grid{};
+      std::size_t __count = 1;
+      std::size_t __side = 1;
+      std::size_t __level = 0;
+      for (std::size_t __dim = 0; __dim < _Rank; ++__dim) {
+        const std::size_t __t = (std::max) (__tile.extent(__dim), std::size_t{1});
+        __grid[__dim] = (__shape.extent(__dim) + __t - 1) / __t;
+        __count *= __grid[__dim];
+        while (__side < __grid[__dim]) {
+          __side *= 2;
+          ++__level;
+        }
+      }
+      std::vector<__index_t<_Rank>> __tiles;
+      if (__count != 0) {
+        __tiles.reserve(__count);
+        __bulk_md::__append_morton<_Rank>(__grid, __index_t<_Rank>{}, __level, __tiles);
+      }
+      return __tiles;
+    }
+
+    template <std::size_t _Rank, class _Fun>
+    struct __chunk_fn {
+      mdshape<_Rank> __shape_;
+      mdshape<_Rank> __tile_;
+      std::vector<__index_t<_Rank>> __tiles_;
+      _Fun __fun_;
+
+      template <std::size_t _Dim, class... _Args>
+      void __visit(
+        const __index_t<_Rank>& __lo,
+        const __index_t<_Rank>& __hi,
+        __index_t<_Rank>& __idx,
+        _Args&... __args) {
+        for (__idx[_Dim] = __lo[_Dim]; __idx[_Dim] != __hi[_Dim]; ++__idx[_Dim]) {
+          if constexpr (_Dim + 1 == _Rank) {
+            [&]<std::size_t... _Is>(std::index_sequence<_Is...>) {
+              __fun_(__idx[_Is]..., __args...);
+            }(std::make_index_sequence<_Rank>{});
+          } else {
+            this->template __visit<_Dim + 1>(__lo, __hi, __idx, __args...);
+          }
+        }
+      }
+
+      template <class... _Args>
+      void operator()(std::size_t __begin, std::size_t __end, _Args&... __args) {
+        for (std::size_t __t = __begin; __t != __end; ++__t) {
+          __index_t<_Rank> __lo{};
+          __index_t<_Rank> __hi{};
+          for (std::size_t __dim = 0; __dim < _Rank; ++__dim) {
+            __lo[__dim] = __tiles_[__t][__dim] * __tile_.extent(__dim);
+            __hi[__dim] = (std::min) (__lo[__dim] + __tile_.extent(__dim), __shape_.extent(__dim));
+          }
+          __index_t<_Rank> __idx{};
+          this->template __visit<0>(__lo, __hi, __idx, __args...);
+        }
+      }
+    };
+
+    template <std::size_t _Rank, class _Fun>
+    auto __make_chunk_fn(const mdshape<_Rank>& __shape, mdshape<_Rank> __tile, _Fun&& __fun)
+      -> __chunk_fn<_Rank, __decay_t<_Fun>> {
+      [&]<std::size_t... _Is>(std::index_sequence<_Is...>) {
+        __tile = mdshape<_Rank>{(std::max) (__tile.extent(_Is), std::size_t{1})...};
+      }(std::make_index_sequence<_Rank>{});
+      auto __tiles = __bulk_md::__morton_tiles(__shape, __tile);
+      return {__shape, __tile, std::move(__tiles), static_cast<_Fun&&>(__fun)};
+    }
+
+    struct bulk_md_t {
+      template <sender _Sender, class _Policy, std::size_t _Rank, copy_constructible _Fun>
+        requires is_execution_policy_v<std::remove_cvref_t<_Policy>>
+      auto operator()(
+        _Sender&& __sndr,
+        _Policy&& __pol,
+        mdshape<_Rank> __shape,
+        mdshape<_Rank> __tile,
+        _Fun __fun) const -> __well_formed_sender auto {
+        auto __chunk = __bulk_md::__make_chunk_fn(__shape, __tile, static_cast<_Fun&&>(__fun));
+        const std::size_t __num_tiles = __chunk.__tiles_.size();
+        return stdexec::bulk_chunked(
+          static_cast<_Sender&&>(__sndr),
+          static_cast<_Policy&&>(__pol),
+          __num_tiles,
+          std::move(__chunk));
+      }
+
+      template <sender _Sender, class _Policy, std::size_t _Rank, copy_constructible _Fun>
+        requires is_execution_policy_v<std::remove_cvref_t<_Policy>>
+      auto operator()(_Sender&& __sndr, _Policy&& __pol, mdshape<_Rank> __shape, _Fun __fun) const
+        -> __well_formed_sender auto {
+        return (*this)(
+          static_cast<_Sender&&>(__sndr),
+          static_cast<_Policy&&>(__pol),
+          __shape,
+          __default_tile<_Rank>(),
+          static_cast<_Fun&&>(__fun));
+      }
+
+      template <class _Policy, std::size_t _Rank, copy_constructible _Fun>
+        requires is_execution_policy_v<std::remove_cvref_t<_Policy>>
+      auto operator()(_Policy&& __pol, mdshape<_Rank> __shape, mdshape<_Rank> __tile, _Fun __fun)
+        const {
+        auto __chunk = __bulk_md::__make_chunk_fn(__shape, __tile, static_cast<_Fun&&>(__fun));
+        const std::size_t __num_tiles = __chunk.__tiles_.size();
+        return stdexec::bulk_chunked(
+          static_cast<_Policy&&>(__pol), __num_tiles, std::move(__chunk));
+      }
+
+      template <class _Policy, std::size_t _Rank, copy_constructible _Fun>
+        requires is_execution_policy_v<std::remove_cvref_t<_Policy>>
+      auto operator()(_Policy&& __pol, mdshape<_Rank> __shape, _Fun __fun) const {
+        return (*this)(
+          static_cast<_Policy&&>(__pol),
+          __shape,
+          __default_tile<_Rank>(),
+          static_cast<_Fun&&>(__fun));
+      }
+    };
+  } // namespace __bulk_md
+
+  using __bulk_md::bulk_md_t;
+  inline constexpr bulk_md_t bulk_md{};
+} // namespace exec
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // bulk_simd<Width>(sndr, policy, shape, fun)
+  //
+  // Like stdexec::bulk, but calls `fun(i, width, values...)` once per batch of `Width`
+  // consecutive indices starting at `i`, where `width` is a
+  // std::integral_constant<std::size_t, Width>. Indices that don't fill a whole batch -- at
+  // the edges of the chunk an execution agent is given -- are passed one at a time with
+  // `width` an std::integral_constant<std::size_t, 1>. Full batches always start at a multiple
+  // of `Width`, so a batch of a suitably aligned array is suitably aligned.
+  //
+  // `fun` is typically a generic lambda that loads, computes and stores a
+  // std::experimental::fixed_size_simd<T, width> (or hand-written vector code) per batch,
+  // and `Width` matches the native vector width of the element type.
+  namespace __bulk_simd {
+    using namespace stdexec;
+
+    template <std::size_t _Width, class _Shape, class _Fun>
+    struct __chunk_fn {
+      using __one_t = std::integral_constant<std::size_t, 1>;
+      using __width_t = std::integral_constant<std::size_t, _Width>;
+
+      _Fun __fun_;
+
+      template <class... _Args>
+      void operator()(_Shape __begin, _Shape __end, _Args&... __args) noexcept(
+        __nothrow_callable<_Fun&, _Shape, __one_t, _Args&...>
+        && __nothrow_callable<_Fun&, _Shape, __width_t, _Args&...>) {
+        constexpr auto __width = static_cast<_Shape>(_Width);
+        for (; __begin < __end && __begin % __width != 0; ++__begin) {
+          __fun_(__begin, __one_t{}, __args...);
+        }
+        for (; __end - __begin >= __width; __begin += __width) {
+          __fun_(__begin, __width_t{}, __args...);
+        }
+        for (; __begin < __end; ++__begin) {
+          __fun_(__begin, __one_t{}, __args...);
+        }
+      }
+    };
+
+    template <std::size_t _Width>
+    struct bulk_simd_t {
+      static_assert(_Width > 0, "The width of a bulk_simd batch must be positive.");
+
+      template <sender _Sender, class _Policy, integral _Shape, copy_constructible _Fun>
+        requires is_execution_policy_v<std::remove_cvref_t<_Policy>>
+      auto operator()(_Sender&& __sndr, _Policy&& __pol, _Shape __shape, _Fun __fun) const
+        -> __well_formed_sender auto {
+        return stdexec::bulk_chunked(
+          static_cast<_Sender&&>(__sndr),
+          static_cast<_Policy&&>(__pol),
+          __shape,
+          __chunk_fn<_Width, _Shape, _Fun>{static_cast<_Fun&&>(__fun)});
+      }
+
+      template <class _Policy, integral _Shape, copy_constructible _Fun>
+        requires is_execution_policy_v<std::remove_cvref_t<_Policy>>
+      auto operator()(_Policy&& __pol, _Shape __shape, _Fun __fun) const {
+        return stdexec::bulk_chunked(
+          static_cast<_Policy&&>(__pol),
+          __shape,
+          __chunk_fn<_Width, _Shape, _Fun>{static_cast<_Fun&&>(__fun)});
+      }
+    };
+  } // namespace __bulk_simd
+
+  using __bulk_simd::bulk_simd_t;
+
+  template <std::size_t _Width>
+  inline constexpr bulk_simd_t<_Width> bulk_simd{};
+} // namespace exec
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+
+#include "__detail/__parallel_blocks.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // exec::bulk_with_state(sndr, policy, shape, make_state, fun, merge)
+  //
+  // Like stdexec::bulk, but each execution agent gets a private scratch object -- a
+  // histogram, a buffer, a partial sum -- so the iterations don't have to share one behind
+  // atomics or a lock. `fun(i, state, values...)` is called for each i in [0, shape), with
+  // `state` the calling agent's object, created with `make_state()` the first time the agent
+  // has work. Once all iterations are done, the agents' objects are combined in a fixed order
+  // with `merge(State& into, State&& from)` and the sender completes with the result (or with
+  // `make_state()` if `shape` is zero). The predecessor's values are passed to `fun` by
+  // reference and are not forwarded.
+  //
+  // The index space is split into one block per execution agent, and the blocks are run with
+  // stdexec::bulk_chunked, so schedulers that customize bulk_chunked -- static_thread_pool,
+  // the parallel scheduler -- process them in parallel.
+  namespace __bulk_with_state {
+    using namespace stdexec;
+
+    template <class _State, class _Values>
+    struct __state {
+      _Values __values_;
+      std::vector<__blocks::__slot<_State>> __slots_;
+    };
+
+    template <class _State>
+    struct __make_op_state {
+      std::size_t __num_blocks_;
+
+      template <class... _Values>
+      auto operator()(_Values&&... __values) const {
+        return __state<_State, std::tuple<__decay_t<_Values>...>>{
+          {static_cast<_Values&&>(__values)...},
+          std::vector<__blocks::__slot<_State>>(__num_blocks_)};
+      }
+    };
+
+    template <class _Shape, class _MakeState, class _Fun>
+    struct __run_blocks {
+      _Shape __shape_;
+      _MakeState __make_state_;
+      _Fun __fun_;
+
+      template <class _State, class _Values>
+      void operator()(
+        std::size_t __first,
+        std::size_t __last,
+        __state<_State, _Values>& __state) {
+        const auto __size = static_cast<std::size_t>(__shape_);
+        for (std::size_t __block = __first; __block != __last; ++__block) {
+          auto [__begin, __end] = __blocks::__bounds(__size, __state.__slots_.size(), __block);
+          if (__begin == __end) {
+            continue;
+          }
+          _State& __scratch = __state.__slots_[__block].__value_.emplace(__make_state_());
+          std::apply(
+            [&](auto&... __values) {
+              for (std::size_t __i = __begin; __i != __end; ++__i) {
+                __fun_(static_cast<_Shape>(__i), __scratch, __values...);
+              }
+            },
+            __state.__values_);
+        }
+      }
+    };
+
+    template <class _MakeState, class _Merge>
+    struct __merge_blocks {
+      _MakeState __make_state_;
+      _Merge __merge_;
+
+      template <class _State, class _Values>
+      auto operator()(__state<_State, _Values>&& __state) -> _State {
+        auto __slot = __state.__slots_.begin();
+        const auto __end = __state.__slots_.end();
+        while (__slot != __end && !__slot->__value_) {
+          ++__slot;
+        }
+        if (__slot == __end) {
+          return __make_state_();
+        }
+        _State __result = std::move(*__slot->__value_);
+        for (++__slot; __slot != __end; ++__slot) {
+          if (__slot->__value_) {
+            __merge_(__result, std::move(*__slot->__value_));
+          }
+        }
+        return __result;
+      }
+    };
+
+    struct bulk_with_state_t {
+      template <
+        sender _Sender,
+        class _Policy,
+        integral _Shape,
+        copy_constructible _MakeState,
+        copy_constructible _Fun,
+        copy_constructible _Merge
+      >
+        requires is_execution_policy_v<std::remove_cvref_t<_Policy>>
+              && __callable<_MakeState&>
+      auto operator()(
+        _Sender&& __sndr,
+        _Policy&& __pol,
+        _Shape __shape,
+        _MakeState __make_state,
+        _Fun __fun,
+        _Merge __merge) const -> __well_formed_sender auto {
+        using __state_t = __decay_t<__call_result_t<_MakeState&>>;
+        const auto __size = static_cast<std::size_t>(__shape);
+        const std::size_t __num_blocks =
+          (std::min) (__blocks::__count_for(__sndr), (std::max) (__size, std::size_t{1}));
+        return static_cast<_Sender&&>(__sndr) | then(__make_op_state<__state_t>{__num_blocks})
+             | bulk_chunked(
+                 static_cast<_Policy&&>(__pol),
+                 __num_blocks,
+                 __run_blocks<_Shape, _MakeState, _Fun>{__shape, __make_state, std::move(__fun)})
+             | then(__merge_blocks<_MakeState, _Merge>{
+                 std::move(__make_state), std::move(__merge)});
+      }
+
+      template <
+        class _Policy,
+        integral _Shape,
+        copy_constructible _MakeState,
+        copy_constructible _Fun,
+        copy_constructible _Merge
+      >
+        requires is_execution_policy_v<std::remove_cvref_t<_Policy>>
+      STDEXEC_ATTRIBUTE(always_inline)
+      auto operator()(
+        _Policy&& __pol,
+        _Shape __shape,
+        _MakeState __make_state,
+        _Fun __fun,
+        _Merge __merge) const
+        -> __binder_back<bulk_with_state_t, _Policy, _Shape, _MakeState, _Fun, _Merge> {
+        return {
+          {static_cast<_Policy&&>(__pol),
+           __shape,
+           static_cast<_MakeState&&>(__make_state),
+           static_cast<_Fun&&>(__fun),
+           static_cast<_Merge&&>(__merge)},
+          {},
+          {}
+        };
+      }
+    };
+  } // namespace __bulk_with_state
+
+  using __bulk_with_state::bulk_with_state_t;
+  inline constexpr bulk_with_state_t bulk_with_state{};
+} // namespace exec
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../../stdexec/execution.hpp"
+
+#include "./safe_file_descriptor.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace exec {
+  //! A stdexec::run_loop that is driven by an existing poll/epoll based event loop instead of
+  //! a dedicated thread. Register native_handle() for readability and call run_some() when it
+  //! becomes readable; the descriptor is signalled whenever work is scheduled on an idle loop
+  //! and when finish() is called. It may be destroyed as soon as the work it was waiting for has
+  //! run, even if the threads that scheduled that work have not yet returned.
+  class eventfd_run_loop : stdexec::__immovable {
+   public:
+    eventfd_run_loop()
+      : __eventfd_{::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)} {
+      if (!__eventfd_) {
+        STDEXEC_THROW(std::system_error(errno, std::system_category()));
+      }
+    }
+
+    auto get_scheduler() noexcept {
+      return __loop_.get_scheduler();
+    }
+
+    //! The eventfd to poll for readability.
+    [[nodiscard]]
+    auto native_handle() const noexcept -> int {
+      return __eventfd_.native_handle();
+    }
+
+    //! Consumes a pending notification and executes at most __max tasks that are ready,
+    //! without blocking. Returns the number of tasks executed.
+    auto run_some(std::size_t __max = ~std::size_t{0}) -> std::size_t {
+      std::uint64_t __count = 0;
+      [[maybe_unused]]
+      auto __n = ::read(__eventfd_, &__count, sizeof(__count));
+      return __loop_.run_some(__max);
+    }
+
+    //! Executes one task if one is ready, without blocking.
+    auto run_one() -> bool {
+      return run_some(1) != 0;
+    }
+
+    //! Blocks the calling thread running tasks until finish() is called.
+    void run() {
+      __loop_.run();
+    }
+
+    void finish() {
+      __loop_.finish();
+    }
+
+   private:
+    static void __wakeup(void* __self) noexcept {
+      // The write can only fail if the counter would overflow, in which case the descriptor
+      // is readable anyway.
+      std::uint64_t __one = 1;
+      [[maybe_unused]]
+      auto __n = ::write(static_cast<eventfd_run_loop*>(__self)->__eventfd_, &__one, sizeof(__one));
+    }
+
+    // __loop_ is destroyed first. Its destructor waits for producers that are still writing
+    // to the descriptor, so the descriptor is closed only once nobody can write to it.
+    safe_file_descriptor __eventfd_;
+    stdexec::run_loop __loop_{&__wakeup, this};
+  };
+} // namespace exec
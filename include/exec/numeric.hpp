@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+
+#include "__detail/__parallel_blocks.hpp"
+
+#if STDEXEC_HAS_STD_RANGES()
+
+#  include <cstddef>
+#  include <functional>
+#  include <optional>
+#  include <ranges>
+#  include <type_traits>
+#  include <utility>
+#  include <vector>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // exec::reduce(sndr, init, fun = std::plus{})
+  // exec::inclusive_scan(sndr, fun = std::plus{})
+  // exec::exclusive_scan(sndr, init, fun = std::plus{})
+  //
+  // Parallel counterparts of the <numeric> algorithms for a random-access range sent by `sndr`.
+  // reduce completes with the reduction of the range, of the type of `init`. The scans
+  // overwrite the range with its prefix sums and complete with the range.
+  //
+  // The range is split into one block per execution agent. A first bulk_chunked pass reduces
+  // each block into its own cache-line-sized partial; the scans then turn the partials into
+  // block prefixes and, in a second bulk_chunked pass, scan each block starting from its
+  // prefix. Schedulers that customize bulk_chunked, like static_thread_pool and the parallel
+  // scheduler, run the passes in parallel; elsewhere they run sequentially. As with
+  // std::reduce, `fun` must be associative and accept the accumulator type and the range's
+  // reference type in either position, but it need not be commutative: blocks are always
+  // combined in order. To reduce the items of a sequence sender instead, see
+  // exec::reduce_each in <exec/sequence/fold.hpp>.
+  namespace __numeric {
+    using namespace stdexec;
+
+    // A range sent as an lvalue is referred to; anything else is moved into the operation.
+    template <class _Range>
+    using __stored_range_t = __if_c<
+      std::is_lvalue_reference_v<_Range> && !std::ranges::view<__decay_t<_Range>>,
+      std::ranges::ref_view<std::remove_reference_t<_Range>>,
+      __decay_t<_Range>
+    >;
+
+    template <class _Range, class _Ty>
+    struct __state {
+      _Range __range_;
+      std::vector<__blocks::__slot<_Ty>> __partials_;
+    };
+
+    template <class _Range>
+    auto __at(_Range& __range, std::size_t __i) -> decltype(auto) {
+      using __diff_t = std::ranges::range_difference_t<_Range>;
+      return std::ranges::begin(__range)[static_cast<__diff_t>(__i)];
+    }
+
+    // Moves the incoming range into a __state with one partial per block. _Ty is the type of
+    // the partials, or void for the range's value type.
+    template <class _Ty>
+    struct __make_state {
+      std::size_t __num_blocks_;
+
+      template <class _Range>
+        requires std::ranges::random_access_range<__stored_range_t<_Range>>
+              && std::ranges::sized_range<__stored_range_t<_Range>>
+      auto operator()(_Range&& __range) const {
+        using __range_t = __stored_range_t<_Range>;
+        using __value_t = __if_c<
+          __same_as<_Ty, void>,
+          std::ranges::range_value_t<__range_t>,
+          _Ty
+        >;
+        return __state<__range_t, __value_t>{
+          __range_t(static_cast<_Range&&>(__range)),
+          std::vector<__blocks::__slot<__value_t>>(__num_blocks_)};
+      }
+    };
+
+    // First pass: reduce each block into its partial.
+    template <class _Fun>
+    struct __reduce_blocks {
+      _Fun __fun_;
+
+      template <class _Range, class _Ty>
+      void
+        operator()(std::size_t __first, std::size_t __last, __state<_Range, _Ty>& __state) const {
+        const std::size_t __size = std::ranges::size(__state.__range_);
+        for (std::size_t __block = __first; __block != __last; ++__block) {
+          auto [__begin, __end] = __blocks::__bounds(__size, __state.__partials_.size(), __block);
+          if (__begin == __end) {
+            continue;
+          }
+          _Ty __acc(__numeric::__at(__state.__range_, __begin));
+          for (std::size_t __i = __begin + 1; __i != __end; ++__i) {
+            __acc = __fun_(std::move(__acc), __numeric::__at(__state.__range_, __i));
+          }
+          __state.__partials_[__block].__value_.emplace(std::move(__acc));
+        }
+      }
+    };
+
+    template <class _Ty, class _Fun>
+    struct __fold_partials {
+      _Ty __init_;
+      _Fun __fun_;
+
+      template <class _Range>
+      auto operator()(__state<_Range, _Ty>&& __state) -> _Ty {
+        _Ty __acc = std::move(__init_);
+        for (auto& __partial: __state.__partials_) {
+          if (__partial.__value_) {
+            __acc = __fun_(std::move(__acc), std::move(*__partial.__value_));
+          }
+        }
+        return __acc;
+      }
+    };
+
+    struct __no_init { };
+
+    // Between the passes: replace each block's partial with the combined partials of the
+    // blocks before it, starting from the initial value if there is one.
+    template <class _Init, class _Fun>
+    struct __scan_partials {
+      STDEXEC_ATTRIBUTE(no_unique_address) _Init __init_;
+      _Fun __fun_;
+
+      template <class _Range, class _Ty>
+      auto operator()(__state<_Range, _Ty>&& __state) -> __numeric::__state<_Range, _Ty> {
+        std::optional<_Ty> __acc;
+        if constexpr (!__same_as<_Init, __no_init>) {
+          __acc.emplace(std::move(__init_));
+        }
+        for (auto& __partial: __state.__partials_) {
+          std::optional<_Ty> __block = std::move(__partial.__value_);
+          __partial.__value_ = __acc;
+          if (__block) {
+            if (__acc) {
+              __acc.emplace(__fun_(std::move(*__acc), std::move(*__block)));
+            } else {
+              __acc = std::move(__block);
+            }
+          }
+        }
+        return std::move(__state);
+      }
+    };
+
+    // Second pass: scan each block in place, starting from its prefix.
+    template <class _Fun, bool _Inclusive>
+    struct __scan_blocks {
+      _Fun __fun_;
+
+      template <class _Range, class _Ty>
+      void
+        operator()(std::size_t __first, std::size_t __last, __state<_Range, _Ty>& __state) const {
+        const std::size_t __size = std::ranges::size(__state.__range_);
+        for (std::size_t __block = __first; __block != __last; ++__block) {
+          auto [__begin, __end] = __blocks::__bounds(__size, __state.__partials_.size(), __block);
+          if (__begin == __end) {
+            continue;
+          }
+          std::optional<_Ty>& __prefix = __state.__partials_[__block].__value_;
+          if constexpr (_Inclusive) {
+            auto&& __head = __numeric::__at(__state.__range_, __begin);
+            _Ty __acc = __prefix ? __fun_(std::move(*__prefix), __head) : _Ty(__head);
+            __head = __acc;
+            for (std::size_t __i = __begin + 1; __i != __end; ++__i) {
+              auto&& __elem = __numeric::__at(__state.__range_, __i);
+              __acc = __fun_(std::move(__acc), __elem);
+              __elem = __acc;
+            }
+          } else {
+            _Ty __acc = std::move(*__prefix);
+            for (std::size_t __i = __begin; __i != __end; ++__i) {
+              auto&& __elem = __numeric::__at(__state.__range_, __i);
+              _Ty __next = __fun_(__acc, __elem);
+              __elem = std::move(__acc);
+              __acc = std::move(__next);
+            }
+          }
+        }
+      }
+    };
+
+    struct __take_range {
+      template <class _Range, class _Ty>
+      auto operator()(__state<_Range, _Ty>&& __state) const -> _Range {
+        return std::move(__state.__range_);
+      }
+    };
+
+    struct reduce_t {
+      template <sender _Sender, __movable_value _Init, __movable_value _Fun = std::plus<>>
+      auto operator()(_Sender&& __sndr, _Init __init, _Fun __fun = {}) const
+        -> __well_formed_sender auto {
+        const std::size_t __num_blocks = __blocks::__count_for(__sndr);
+        return static_cast<_Sender&&>(__sndr) | then(__make_state<_Init>{__num_blocks})
+             | bulk_chunked(par, __num_blocks, __reduce_blocks<_Fun>{__fun})
+             | then(__fold_partials<_Init, _Fun>{static_cast<_Init&&>(__init), __fun});
+      }
+
+      template <__movable_value _Init, __movable_value _Fun = std::plus<>>
+      STDEXEC_ATTRIBUTE(always_inline)
+      auto operator()(_Init __init, _Fun __fun = {}) const -> __binder_back<reduce_t, _Init, _Fun> {
+        return {
+          {static_cast<_Init&&>(__init), static_cast<_Fun&&>(__fun)},
+          {},
+          {}
+        };
+      }
+    };
+
+    struct inclusive_scan_t {
+      template <sender _Sender, __movable_value _Fun = std::plus<>>
+      auto operator()(_Sender&& __sndr, _Fun __fun = {}) const -> __well_formed_sender auto {
+        const std::size_t __num_blocks = __blocks::__count_for(__sndr);
+        return static_cast<_Sender&&>(__sndr) | then(__make_state<void>{__num_blocks})
+             | bulk_chunked(par, __num_blocks, __reduce_blocks<_Fun>{__fun})
+             | then(__scan_partials<__no_init, _Fun>{{}, __fun})
+             | bulk_chunked(par, __num_blocks, __scan_blocks<_Fun, true>{__fun})
+             | then(__take_range{});
+      }
+
+      template <__movable_value _Fun = std::plus<>>
+      STDEXEC_ATTRIBUTE(always_inline)
+      auto operator()(_Fun __fun = {}) const -> __binder_back<inclusive_scan_t, _Fun> {
+        return {{static_cast<_Fun&&>(__fun)}, {}, {}};
+      }
+    };
+
+    struct exclusive_scan_t {
+      template <sender _Sender, __movable_value _Init, __movable_value _Fun = std::plus<>>
+      auto operator()(_Sender&& __sndr, _Init __init, _Fun __fun = {}) const
+        -> __well_formed_sender auto {
+        const std::size_t __num_blocks = __blocks::__count_for(__sndr);
+        return static_cast<_Sender&&>(__sndr) | then(__make_state<_Init>{__num_blocks})
+             | bulk_chunked(par, __num_blocks, __reduce_blocks<_Fun>{__fun})
+             | then(__scan_partials<_Init, _Fun>{static_cast<_Init&&>(__init), __fun})
+             | bulk_chunked(par, __num_blocks, __scan_blocks<_Fun, false>{__fun})
+             | then(__take_range{});
+      }
+
+      template <__movable_value _Init, __movable_value _Fun = std::plus<>>
+      STDEXEC_ATTRIBUTE(always_inline)
+      auto operator()(_Init __init, _Fun __fun = {}) const
+        -> __binder_back<exclusive_scan_t, _Init, _Fun> {
+        return {
+          {static_cast<_Init&&>(__init), static_cast<_Fun&&>(__fun)},
+          {},
+          {}
+        };
+      }
+    };
+  } // namespace __numeric
+
+  using __numeric::reduce_t;
+  using __numeric::inclusive_scan_t;
+  using __numeric::exclusive_scan_t;
+
+  inline constexpr reduce_t reduce{};
+  inline constexpr inclusive_scan_t inclusive_scan{};
+  inline constexpr exclusive_scan_t exclusive_scan{};
+} // namespace exec
+
+#endif // STDEXEC_HAS_STD_RANGES()
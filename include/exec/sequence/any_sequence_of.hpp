@@ -21,45 +21,482 @@
 #include "../sequence_senders.hpp"
 #include "../any_sender_of.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
 namespace exec {
   namespace __any {
     namespace __next {
-      template <__valid_completion_signatures _Sigs>
+      //! The default size of the inline buffers that hold the operation states of items.
+      inline constexpr std::size_t __default_inline_size = 16 * sizeof(void*);
+
+      // Recycles the memory of item operation states that do not fit into their inline buffer.
+      // A pool lives as long as its subscription, so a long-lived type-erased sequence only
+      // allocates while the number of concurrently active items grows. Blocks have power-of-two
+      // sizes and are aligned to their size, up to __max_align, so the size class of an operation
+      // state also accounts for its alignment.
+      class __item_pool : __immovable {
+        struct __block {
+          __block* __next_;
+        };
+
+        static constexpr std::size_t __num_classes = sizeof(std::size_t) * CHAR_BIT;
+
+       public:
+        //! The strictest alignment of pooled blocks. Operation states that are aligned more
+        //! strictly are allocated on their own.
+        static constexpr std::size_t __max_align = 8 * alignof(std::max_align_t);
+
+        static constexpr auto __block_align(std::size_t __class) noexcept -> std::size_t {
+          return std::min(std::size_t{1} << __class, __max_align);
+        }
+
+        static auto __size_class(std::size_t __size) noexcept -> std::size_t {
+          return static_cast<std::size_t>(
+            std::bit_width(std::max(__size, alignof(std::max_align_t)) - 1));
+        }
+
+        auto __allocate(std::size_t __size) -> void* {
+          const std::size_t __class = __size_class(__size);
+          {
+            std::lock_guard __guard{__mutex_};
+            if (__block* __head = __free_[__class]) {
+              __free_[__class] = __head->__next_;
+              return __head;
+            }
+          }
+          return __upstream_allocate_(*this, __class);
+        }
+
+        void __deallocate(void* __pointer, std::size_t __size) noexcept {
+          const std::size_t __class = __size_class(__size);
+          auto* __head = ::new (__pointer) __block{nullptr};
+          std::lock_guard __guard{__mutex_};
+          __head->__next_ = __free_[__class];
+          __free_[__class] = __head;
+        }
+
+       protected:
+        using __upstream_allocate_t = void* (*) (__item_pool&, std::size_t);
+        using __upstream_deallocate_t = void (*)(__item_pool&, std::size_t, void*) noexcept;
+
+        __item_pool(
+          __upstream_allocate_t __upstream_allocate,
+          __upstream_deallocate_t __upstream_deallocate) noexcept
+          : __upstream_allocate_{__upstream_allocate}
+          , __upstream_deallocate_{__upstream_deallocate} {
+        }
+
+        ~__item_pool() = default;
+
+        // Returns all blocks to the upstream allocator. Called by the derived class while its
+        // allocator is still alive.
+        void __release() noexcept {
+          for (std::size_t __class = 0; __class < __num_classes; ++__class) {
+            for (__block* __head = __free_[__class]; __head != nullptr;) {
+              __upstream_deallocate_(*this, __class, std::exchange(__head, __head->__next_));
+            }
+          }
+        }
+
+       private:
+        __upstream_allocate_t __upstream_allocate_;
+        __upstream_deallocate_t __upstream_deallocate_;
+        std::mutex __mutex_{};
+        __block* __free_[__num_classes]{};
+      };
+
+      // An __item_pool that takes its blocks from _Alloc, rebound to a type with the alignment
+      // of the block.
+      template <class _Alloc>
+      class __basic_item_pool : public __item_pool {
+        template <std::size_t _Align>
+        struct alignas(_Align) __chunk {
+          std::byte __bytes_[_Align];
+        };
+
+        template <std::size_t _Align>
+        using __chunk_alloc_t =
+          std::allocator_traits<_Alloc>::template rebind_alloc<__chunk<_Align>>;
+
+        template <std::size_t _Align>
+        auto __allocate_chunks(std::size_t __size) -> void* {
+          __chunk_alloc_t<_Align> __alloc{__alloc_};
+          return std::allocator_traits<__chunk_alloc_t<_Align>>::allocate(__alloc, __size / _Align);
+        }
+
+        template <std::size_t _Align>
+        void __deallocate_chunks(void* __pointer, std::size_t __size) noexcept {
+          __chunk_alloc_t<_Align> __alloc{__alloc_};
+          std::allocator_traits<__chunk_alloc_t<_Align>>::deallocate(
+            __alloc, static_cast<__chunk<_Align>*>(__pointer), __size / _Align);
+        }
+
+        template <std::size_t _Align>
+        using __align_t = std::integral_constant<std::size_t, _Align>;
+
+        // Calls __fun with the alignment of the blocks of the given class as a constant.
+        template <class _Fun>
+        static auto __with_block_align(std::size_t __class, _Fun __fun) -> decltype(auto) {
+          constexpr std::size_t __min = alignof(std::max_align_t);
+          static_assert(__max_align == 8 * __min);
+          switch (__block_align(__class) / __min) {
+          case 1:
+            return __fun(__align_t<__min>{});
+          case 2:
+            return __fun(__align_t<2 * __min>{});
+          case 4:
+            return __fun(__align_t<4 * __min>{});
+          default:
+            return __fun(__align_t<8 * __min>{});
+          }
+        }
+
+        static auto __upstream_allocate(__item_pool& __pool, std::size_t __class) -> void* {
+          auto& __self = static_cast<__basic_item_pool&>(__pool);
+          return __with_block_align(__class, [&]<std::size_t _Align>(__align_t<_Align>) {
+            return __self.template __allocate_chunks<_Align>(std::size_t{1} << __class);
+          });
+        }
+
+        static void __upstream_deallocate(
+          __item_pool& __pool,
+          std::size_t __class,
+          void* __pointer) noexcept {
+          auto& __self = static_cast<__basic_item_pool&>(__pool);
+          __with_block_align(__class, [&]<std::size_t _Align>(__align_t<_Align>) {
+            __self.template __deallocate_chunks<_Align>(__pointer, std::size_t{1} << __class);
+          });
+        }
+
+       public:
+        explicit __basic_item_pool(const _Alloc& __alloc) noexcept
+          : __item_pool{&__upstream_allocate, &__upstream_deallocate}
+          , __alloc_{__alloc} {
+        }
+
+        ~__basic_item_pool() {
+          this->__release();
+        }
+
+       private:
+        _Alloc __alloc_;
+      };
+
+      // Returns the allocator that the item pool of a subscription draws from.
+      template <class _Env>
+      auto __get_allocator(const _Env& __env) noexcept {
+        if constexpr (__callable<get_allocator_t, const _Env&>) {
+          return stdexec::get_allocator(__env);
+        } else {
+          return std::allocator<std::byte>{};
+        }
+      }
+
+      // Holds a type-erased operation state in an inline buffer. Operation states that do not fit
+      // are placed in memory from the pool of the subscription, if there is one.
+      template <std::size_t _InlineSize>
+      class __item_storage : __immovable {
+        static constexpr std::size_t __buffer_size = std::max(_InlineSize, sizeof(void*));
+
+        template <class _Op>
+        static constexpr bool __is_small = sizeof(_Op) <= __buffer_size
+                                        && alignof(_Op) <= alignof(std::max_align_t);
+
+        auto __allocate(std::size_t __size, std::size_t __align) -> void* {
+          if (__pool_ != nullptr && __align <= __item_pool::__max_align) {
+            return __pool_->__allocate(__size);
+          }
+          return ::operator new(__size, std::align_val_t{__align});
+        }
+
+        void __deallocate(void* __pointer, std::size_t __size, std::size_t __align) noexcept {
+          if (__pool_ != nullptr && __align <= __item_pool::__max_align) {
+            __pool_->__deallocate(__pointer, __size);
+          } else {
+            ::operator delete(__pointer, std::align_val_t{__align});
+          }
+        }
+
+       public:
+        explicit __item_storage(__item_pool* __pool) noexcept
+          : __pool_{__pool} {
+        }
+
+        ~__item_storage() {
+          if (__destroy_ != nullptr) {
+            __destroy_(*this);
+          }
+        }
+
+        template <class _Op, class _Fun>
+        void __emplace_from(_Fun&& __fun) {
+          STDEXEC_ASSERT(__op_ == nullptr);
+          if constexpr (__is_small<_Op>) {
+            __op_ = ::new (static_cast<void*>(__buffer_)) _Op(static_cast<_Fun&&>(__fun)());
+          } else {
+            void* __pointer = __allocate(sizeof(_Op), alignof(_Op));
+            STDEXEC_TRY {
+              __op_ = ::new (__pointer) _Op(static_cast<_Fun&&>(__fun)());
+            }
+            STDEXEC_CATCH_ALL {
+              __deallocate(__pointer, sizeof(_Op), alignof(_Op));
+              STDEXEC_THROW();
+            }
+          }
+          __start_ = [](void* __op) noexcept {
+            stdexec::start(*static_cast<_Op*>(__op));
+          };
+          __destroy_ = [](__item_storage& __self) noexcept {
+            static_cast<_Op*>(__self.__op_)->~_Op();
+            if constexpr (!__is_small<_Op>) {
+              __self.__deallocate(__self.__op_, sizeof(_Op), alignof(_Op));
+            }
+          };
+        }
+
+        void __start() noexcept {
+          STDEXEC_ASSERT(__start_ != nullptr);
+          __start_(__op_);
+        }
+
+       private:
+        __item_pool* __pool_;
+        void* __op_{nullptr};
+        void (*__start_)(void*) noexcept {nullptr};
+        void (*__destroy_)(__item_storage&) noexcept {nullptr};
+        alignas(std::max_align_t) std::byte __buffer_[__buffer_size];
+      };
+
+      // The part of an in-flight item that the type-erased item sender refers to.
+      template <class _Sigs, std::size_t _InlineSize>
+      struct __item_source {
+        using __receiver_ref_t = __any::__receiver_ref<_Sigs, __types<>>;
+
+        void (*__connect_)(__item_source*, __receiver_ref_t, __item_storage<_InlineSize>&);
+        __item_pool* __pool_;
+      };
+
+      template <class _Sigs, std::size_t _InlineSize, class _ReceiverId>
+      struct __item_operation {
+        using _Receiver = stdexec::__t<_ReceiverId>;
+        using __source_t = __item_source<_Sigs, _InlineSize>;
+
+        class __t : public __any::__operation_base<_Receiver> {
+         public:
+          using __id = __item_operation;
+
+          __t(__source_t* __source, _Receiver&& __rcvr)
+            : __any::__operation_base<_Receiver>{static_cast<_Receiver&&>(__rcvr)}
+            , __storage_{__source->__pool_} {
+            using __receiver_ref_t = __source_t::__receiver_ref_t;
+            __source->__connect_(__source, __receiver_ref_t{__rec_}, __storage_);
+          }
+
+          void start() & noexcept {
+            this->__on_stop_.emplace(
+              stdexec::get_stop_token(stdexec::get_env(this->__rcvr_)),
+              __any::__on_stop_t{this->__stop_source_});
+            __storage_.__start();
+          }
+
+         private:
+          __any::__stoppable_receiver_t<_ReceiverId> __rec_{this};
+          __item_storage<_InlineSize> __storage_;
+        };
+      };
+
+      // The item sender that is passed to the type-erased receiver. It refers to the item that
+      // is owned by the operation state of the next-sender and can be connected once.
+      template <class _Sigs, std::size_t _InlineSize>
+      struct __item_sender {
+        using __source_t = __item_source<_Sigs, _InlineSize>;
+
+        class __t {
+         public:
+          using __id = __item_sender;
+          using sender_concept = stdexec::sender_t;
+          using completion_signatures = _Sigs;
+
+          explicit __t(__source_t* __source) noexcept
+            : __source_{__source} {
+          }
+
+          __t(__t&& __other) noexcept
+            : __source_{std::exchange(__other.__source_, nullptr)} {
+          }
+
+          template <receiver_of<_Sigs> _Rcvr>
+          auto connect(_Rcvr __rcvr) && -> stdexec::__t<
+            __item_operation<_Sigs, _InlineSize, stdexec::__id<_Rcvr>>
+          > {
+            STDEXEC_ASSERT(__source_ != nullptr);
+            return {std::exchange(__source_, nullptr), static_cast<_Rcvr&&>(__rcvr)};
+          }
+
+          auto get_env() const noexcept -> env<> {
+            return {};
+          }
+
+         private:
+          __source_t* __source_;
+        };
+      };
+
+      template <class _Sigs, std::size_t _InlineSize>
       struct __rcvr_next_vfun {
         using __return_sigs = completion_signatures<set_value_t(), set_stopped_t()>;
-        using __void_sender = any_receiver_ref<__return_sigs>::template any_sender<>;
-        using __item_sender = any_receiver_ref<_Sigs>::template any_sender<>;
-        __void_sender (*__fn_)(void*, __item_sender&&) noexcept;
+        using __item_sender_t = stdexec::__t<__item_sender<_Sigs, _InlineSize>>;
+        using __next_receiver_t = __any::__receiver_ref<__return_sigs, __types<>>;
+
+        // Calls set_next on the type-erased receiver and connects the resulting sender to the
+        // given receiver, placing the operation state into the given storage.
+        void (*__fn_)(
+          void*,
+          __item_sender_t&&,
+          __next_receiver_t,
+          __item_storage<_InlineSize>&);
       };
 
-      template <class _Rcvr>
+      template <class _Rcvr, std::size_t _InlineSize>
       struct __rcvr_next_vfun_fn {
-        using __return_sigs = completion_signatures<set_value_t(), set_stopped_t()>;
-        using __void_sender = any_receiver_ref<__return_sigs>::template any_sender<>;
-
-        template <class _Sigs>
-        using __item_sender = any_receiver_ref<_Sigs>::template any_sender<>;
+        template <__valid_completion_signatures _Sigs>
+        using __vfun_t = __rcvr_next_vfun<_Sigs, _InlineSize>;
 
         template <__valid_completion_signatures _Sigs>
-        constexpr auto
-          operator()(_Sigs*) const -> __void_sender (*)(void*, __item_sender<_Sigs>&&) noexcept {
-          return +[](void* __rcvr, __item_sender<_Sigs>&& __sndr) noexcept -> __void_sender {
-            return __void_sender{
-              set_next(*static_cast<_Rcvr*>(__rcvr), static_cast<__item_sender<_Sigs>&&>(__sndr))};
+        constexpr auto operator()(_Sigs*) const -> void (*)(
+          void*,
+          typename __vfun_t<_Sigs>::__item_sender_t&&,
+          typename __vfun_t<_Sigs>::__next_receiver_t,
+          __item_storage<_InlineSize>&) {
+          using __item_sender_t = __vfun_t<_Sigs>::__item_sender_t;
+          using __next_receiver_t = __vfun_t<_Sigs>::__next_receiver_t;
+          return +[](
+                    void* __rcvr,
+                    __item_sender_t&& __sndr,
+                    __next_receiver_t __next_rcvr,
+                    __item_storage<_InlineSize>& __storage) {
+            using __next_t = __call_result_t<set_next_t, _Rcvr&, __item_sender_t>;
+            using __op_t = connect_result_t<__next_t, __next_receiver_t>;
+            __storage.template __emplace_from<__op_t>([&] {
+              return stdexec::connect(
+                exec::set_next(
+                  *static_cast<_Rcvr*>(__rcvr), static_cast<__item_sender_t&&>(__sndr)),
+                static_cast<__next_receiver_t&&>(__next_rcvr));
+            });
           };
         }
       };
 
-      template <class _NextSigs, class _Sigs, class... _Queries>
+      template <class _Item, class _Sigs, std::size_t _InlineSize, class _ReceiverId>
+      struct __next_operation {
+        using _Receiver = stdexec::__t<_ReceiverId>;
+        using __source_t = __item_source<_Sigs, _InlineSize>;
+        using __vfun_t = __rcvr_next_vfun<_Sigs, _InlineSize>;
+        using __item_receiver_t = __source_t::__receiver_ref_t;
+
+        class __t
+          : public __source_t
+          , public __any::__operation_base<_Receiver> {
+         public:
+          using __id = __next_operation;
+
+          __t(
+            _Item&& __item,
+            const __vfun_t* __vfun,
+            void* __next_rcvr,
+            __item_pool* __pool,
+            _Receiver&& __rcvr)
+            : __source_t{&__connect_item, __pool}
+            , __any::__operation_base<_Receiver>{static_cast<_Receiver&&>(__rcvr)}
+            , __item_(static_cast<_Item&&>(__item))
+            , __storage_{__pool} {
+            __vfun->__fn_(
+              __next_rcvr,
+              typename __vfun_t::__item_sender_t{this},
+              typename __vfun_t::__next_receiver_t{__rec_},
+              __storage_);
+          }
+
+          void start() & noexcept {
+            this->__on_stop_.emplace(
+              stdexec::get_stop_token(stdexec::get_env(this->__rcvr_)),
+              __any::__on_stop_t{this->__stop_source_});
+            __storage_.__start();
+          }
+
+         private:
+          static void __connect_item(
+            __source_t* __source,
+            __item_receiver_t __rcvr,
+            __item_storage<_InlineSize>& __storage) {
+            __t& __self = *static_cast<__t*>(__source);
+            using __op_t = connect_result_t<_Item, __item_receiver_t>;
+            __storage.template __emplace_from<__op_t>([&] {
+              return stdexec::connect(
+                static_cast<_Item&&>(__self.__item_), static_cast<__item_receiver_t&&>(__rcvr));
+            });
+          }
+
+          _Item __item_;
+          __any::__stoppable_receiver_t<_ReceiverId> __rec_{this};
+          __item_storage<_InlineSize> __storage_;
+        };
+      };
+
+      // The result of set_next on a type-erased receiver. It keeps the item by value and defers
+      // the type-erased call of set_next to connect, so the item and the operation states on
+      // both sides of the type erasure are stored inline without further allocations.
+      template <class _Item, class _Sigs, std::size_t _InlineSize>
+      struct __next_sender {
+        using __vfun_t = __rcvr_next_vfun<_Sigs, _InlineSize>;
+
+        struct __t {
+          using __id = __next_sender;
+          using sender_concept = stdexec::sender_t;
+          using completion_signatures =
+            stdexec::completion_signatures<set_value_t(), set_stopped_t()>;
+
+          _Item __item_;
+          const __vfun_t* __vfun_;
+          void* __rcvr_;
+          __item_pool* __pool_;
+
+          template <receiver_of<completion_signatures> _Rcvr>
+          auto connect(_Rcvr __rcvr) && -> stdexec::__t<
+            __next_operation<_Item, _Sigs, _InlineSize, stdexec::__id<_Rcvr>>
+          > {
+            return {
+              static_cast<_Item&&>(__item_),
+              __vfun_,
+              __rcvr_,
+              __pool_,
+              static_cast<_Rcvr&&>(__rcvr)};
+          }
+
+          auto get_env() const noexcept -> env<> {
+            return {};
+          }
+        };
+      };
+
+      template <class _NextSigs, class _Sigs, std::size_t _InlineSize, class... _Queries>
       struct __next_vtable;
 
-      template <class _NextSigs, class... _Sigs, class... _Queries>
-      struct __next_vtable<_NextSigs, completion_signatures<_Sigs...>, _Queries...> {
-        using __item_sender = any_receiver_ref<_NextSigs>::template any_sender<>;
-        using __item_types = item_types<__item_sender>;
+      template <class _NextSigs, class... _Sigs, std::size_t _InlineSize, class... _Queries>
+      struct __next_vtable<_NextSigs, completion_signatures<_Sigs...>, _InlineSize, _Queries...> {
+        using __item_sender_t = stdexec::__t<__item_sender<_NextSigs, _InlineSize>>;
+        using __item_types = item_types<__item_sender_t>;
 
         struct __t
-          : public __rcvr_next_vfun<_NextSigs>
+          : public __rcvr_next_vfun<_NextSigs, _InlineSize>
           , public __any_::__rcvr_vfun<_Sigs>...
           , public __query_vfun<_Queries>... {
           using __id = __next_vtable;
@@ -71,7 +508,7 @@ namespace exec {
           STDEXEC_MEMFN_DECL(auto __create_vtable)(this __mtype<__t>, __mtype<_Rcvr>) noexcept
             -> const __t* {
             static const __t __vtable_{
-              {__rcvr_next_vfun_fn<_Rcvr>{}(static_cast<_NextSigs*>(nullptr))},
+              {__rcvr_next_vfun_fn<_Rcvr, _InlineSize>{}(static_cast<_NextSigs*>(nullptr))},
               {__any_::__rcvr_vfun_fn(
                 static_cast<_Rcvr*>(nullptr), static_cast<_Sigs*>(nullptr))}...,
               {__query_vfun_fn<_Rcvr>{}(static_cast<_Queries>(nullptr))}...};
@@ -80,11 +517,11 @@ namespace exec {
         };
       };
 
-      template <class _Sigs, class... _Queries>
+      template <class _Sigs, std::size_t _InlineSize, class... _Queries>
       struct __env {
         using __sigs = __to_sequence_completions_t<_Sigs>;
 
-        using __vtable_t = stdexec::__t<__next_vtable<_Sigs, __sigs, _Queries...>>;
+        using __vtable_t = stdexec::__t<__next_vtable<_Sigs, __sigs, _InlineSize, _Queries...>>;
 
         struct __t {
           using __id = __env;
@@ -101,41 +538,51 @@ namespace exec {
         };
       };
 
-      template <class _Sigs, class... _Queries>
+      template <class _Sigs, std::size_t _InlineSize, class... _Queries>
       struct __receiver_ref;
 
-      template <class... _Sigs, class... _Queries>
-      struct __receiver_ref<completion_signatures<_Sigs...>, _Queries...> {
+      template <class... _Sigs, std::size_t _InlineSize, class... _Queries>
+      struct __receiver_ref<completion_signatures<_Sigs...>, _InlineSize, _Queries...> {
         struct __t {
-          using __return_sigs = completion_signatures<set_value_t(), set_stopped_t()>;
-          using __void_sender = any_receiver_ref<__return_sigs>::template any_sender<>;
           using __next_sigs = completion_signatures<_Sigs...>;
           using __sigs = __to_sequence_completions_t<__next_sigs>;
-          using __item_sender = any_receiver_ref<__next_sigs>::template any_sender<>;
-          using __item_types = item_types<__item_sender>;
+          using __item_sender_t = stdexec::__t<__item_sender<__next_sigs, _InlineSize>>;
+          using __item_receiver_t = __item_source<__next_sigs, _InlineSize>::__receiver_ref_t;
+          using __item_types = item_types<__item_sender_t>;
 
-          using __vtable_t = stdexec::__t<__next_vtable<__next_sigs, __sigs, _Queries...>>;
+          using __vtable_t =
+            stdexec::__t<__next_vtable<__next_sigs, __sigs, _InlineSize, _Queries...>>;
+
+          template <class _Item>
+          using __next_sender_t = stdexec::__t<__next_sender<_Item, __next_sigs, _InlineSize>>;
 
           template <class Sig>
           using __vfun = __any_::__rcvr_vfun<Sig>;
 
-          using __env_t = stdexec::__t<__env<__next_sigs, _Queries...>>;
+          using __env_t = stdexec::__t<__env<__next_sigs, _InlineSize, _Queries...>>;
           __env_t __env_;
+          __item_pool* __pool_{nullptr};
 
           using receiver_concept = stdexec::receiver_t;
 
           template <__none_of<__t, const __t, __env_t, const __env_t> _Rcvr>
             requires sequence_receiver_of<_Rcvr, __item_types>
                   && (__callable<__query_vfun_fn<_Rcvr>, _Queries> && ...)
-          __t(_Rcvr& __rcvr) noexcept
-            : __env_{__create_vtable(__mtype<__vtable_t>{}, __mtype<_Rcvr>{}), &__rcvr} {
+          __t(_Rcvr& __rcvr, __item_pool* __pool = nullptr) noexcept
+            : __env_{__create_vtable(__mtype<__vtable_t>{}, __mtype<_Rcvr>{}), &__rcvr}
+            , __pool_{__pool} {
           }
 
-          template <same_as<__t> _Self, class _Sender>
-            requires constructible_from<__item_sender, _Sender>
-          STDEXEC_MEMFN_DECL(auto set_next)(this _Self& __self, _Sender&& __sndr) -> __void_sender {
-            const __rcvr_next_vfun<__next_sigs>* __vfun = __self.__env_.__vtable_;
-            return __vfun->__fn_(__self.__env_.__rcvr_, static_cast<_Sender&&>(__sndr));
+          template <same_as<__t> _Self, sender _Sender>
+            requires constructible_from<__decay_t<_Sender>, _Sender>
+                  && sender_to<__decay_t<_Sender>, __item_receiver_t>
+          STDEXEC_MEMFN_DECL(auto set_next)(this _Self& __self, _Sender&& __sndr)
+            -> __next_sender_t<__decay_t<_Sender>> {
+            return {
+              static_cast<_Sender&&>(__sndr),
+              __self.__env_.__vtable_,
+              __self.__env_.__rcvr_,
+              __self.__pool_};
           }
 
           // set_value_t() is always valid for a sequence
@@ -165,14 +612,69 @@ namespace exec {
       };
     } // namespace __next
 
-    template <class _Sigs, class _Queries>
-    using __next_receiver_ref =
-      __mapply<__mbind_front<__q<__next::__receiver_ref>, _Sigs>, _Queries>;
+    template <class _Sigs, std::size_t _InlineSize, class _Queries>
+    struct __make_next_receiver_ref;
+
+    template <
+      class _Sigs,
+      std::size_t _InlineSize,
+      template <class...> class _List,
+      class... _Queries
+    >
+    struct __make_next_receiver_ref<_Sigs, _InlineSize, _List<_Queries...>> {
+      using __f = __next::__receiver_ref<_Sigs, _InlineSize, _Queries...>;
+    };
 
-    template <class _Sigs, class _SenderQueries, class _ReceiverQueries>
+    template <
+      class _Sigs,
+      class _Queries,
+      std::size_t _InlineSize = __next::__default_inline_size
+    >
+    using __next_receiver_ref = __make_next_receiver_ref<_Sigs, _InlineSize, _Queries>::__f;
+
+    template <class _ReceiverId, class _ReceiverRef>
+    struct __sequence_operation {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+
+      class __t : public __operation_base<_Receiver> {
+       public:
+        using __id = __sequence_operation;
+
+        template <class _Sender>
+        __t(_Sender&& __sender, _Receiver&& __receiver)
+          : __operation_base<_Receiver>{static_cast<_Receiver&&>(__receiver)}
+          , __pool_{__next::__get_allocator(stdexec::get_env(this->__rcvr_))}
+          , __storage_{__sender.__connect(_ReceiverRef{__rec_, &__pool_})} {
+        }
+
+        void start() & noexcept {
+          this->__on_stop_.emplace(
+            stdexec::get_stop_token(stdexec::get_env(this->__rcvr_)),
+            __on_stop_t{this->__stop_source_});
+          STDEXEC_ASSERT(__storage_.__get_vtable()->__start_);
+          __storage_.__get_vtable()->__start_(__storage_.__get_object_pointer());
+        }
+
+       private:
+        using __allocator_t =
+          decltype(__next::__get_allocator(stdexec::get_env(__declval<const _Receiver&>())));
+
+        __next::__basic_item_pool<__allocator_t> __pool_;
+        __stoppable_receiver_t<_ReceiverId> __rec_{this};
+        __immovable_operation_storage __storage_{};
+      };
+    };
+
+    template <
+      class _Sigs,
+      class _SenderQueries,
+      class _ReceiverQueries,
+      std::size_t _InlineSize = __next::__default_inline_size
+    >
     struct __sender_vtable {
       using __query_vtable_t = __query_vtable<_SenderQueries>;
-      using __receiver_ref_t = stdexec::__t<__next_receiver_ref<_Sigs, _ReceiverQueries>>;
+      using __receiver_ref_t =
+        stdexec::__t<__next_receiver_ref<_Sigs, _ReceiverQueries, _InlineSize>>;
 
       struct __t : public __query_vtable_t {
         auto queries() const noexcept -> const __query_vtable_t& {
@@ -202,10 +704,16 @@ namespace exec {
       };
     };
 
-    template <class _Sigs, class _SenderQueries, class _ReceiverQueries>
+    template <
+      class _Sigs,
+      class _SenderQueries,
+      class _ReceiverQueries,
+      std::size_t _InlineSize = __next::__default_inline_size
+    >
     struct __sender_env {
       using __query_vtable_t = __query_vtable<_SenderQueries>;
-      using __vtable_t = stdexec::__t<__sender_vtable<_Sigs, _SenderQueries, _ReceiverQueries>>;
+      using __vtable_t =
+        stdexec::__t<__sender_vtable<_Sigs, _SenderQueries, _ReceiverQueries, _InlineSize>>;
 
       struct __t {
        public:
@@ -227,13 +735,20 @@ namespace exec {
       };
     };
 
-    template <class _Sigs, class _SenderQueries = __types<>, class _ReceiverQueries = __types<>>
+    template <
+      class _Sigs,
+      class _SenderQueries = __types<>,
+      class _ReceiverQueries = __types<>,
+      std::size_t _InlineSize = __next::__default_inline_size
+    >
     struct __sequence_sender {
-      using __receiver_ref_t = stdexec::__t<__next_receiver_ref<_Sigs, _ReceiverQueries>>;
-      using __vtable_t = stdexec::__t<__sender_vtable<_Sigs, _SenderQueries, _ReceiverQueries>>;
+      using __receiver_ref_t =
+        stdexec::__t<__next_receiver_ref<_Sigs, _ReceiverQueries, _InlineSize>>;
+      using __vtable_t =
+        stdexec::__t<__sender_vtable<_Sigs, _SenderQueries, _ReceiverQueries, _InlineSize>>;
 
       using __sigs = __to_sequence_completions_t<_Sigs>;
-      using __item_sender = any_receiver_ref<_Sigs>::template any_sender<>;
+      using __item_sender = stdexec::__t<__next::__item_sender<_Sigs, _InlineSize>>;
 
       class __t {
        public:
@@ -263,11 +778,12 @@ namespace exec {
 
         template <same_as<__t> _Self, class _Rcvr>
         STDEXEC_MEMFN_DECL(auto subscribe)(this _Self&& __self, _Rcvr __rcvr)
-          -> stdexec::__t<__operation<stdexec::__id<_Rcvr>, true>> {
+          -> stdexec::__t<__sequence_operation<stdexec::__id<_Rcvr>, __receiver_ref_t>> {
           return {static_cast<_Self&&>(__self), static_cast<_Rcvr&&>(__rcvr)};
         }
 
-        using __env_t = stdexec::__t<__sender_env<_Sigs, _SenderQueries, _ReceiverQueries>>;
+        using __env_t =
+          stdexec::__t<__sender_env<_Sigs, _SenderQueries, _ReceiverQueries, _InlineSize>>;
 
         auto get_env() const noexcept -> __env_t {
           return {__storage_.__get_vtable(), __storage_.__get_object_pointer()};
@@ -276,15 +792,21 @@ namespace exec {
     };
   } // namespace __any
 
-  template <class _Completions, auto... _ReceiverQueries>
-  class any_sequence_receiver_ref {
-    using __receiver_base =
-      stdexec::__t<__any::__next_receiver_ref<_Completions, queries<_ReceiverQueries...>>>;
+  //! A type-erased reference to a sequence receiver. The operation states of items that are
+  //! passed through the type erasure are stored in buffers of `_InlineItemSize` bytes. Larger
+  //! operation states are recycled across the items of a subscription, in memory from the
+  //! allocator returned by `get_allocator` on the environment of the subscribing receiver, if
+  //! there is one.
+  template <class _Completions, std::size_t _InlineItemSize, auto... _ReceiverQueries>
+  class basic_any_sequence_receiver_ref {
+    using __receiver_base = stdexec::__t<
+      __any::__next_receiver_ref<_Completions, queries<_ReceiverQueries...>, _InlineItemSize>
+    >;
     using __env_t = stdexec::env_of_t<__receiver_base>;
     __receiver_base __receiver_;
    public:
-    using __id = any_sequence_receiver_ref;
-    using __t = any_sequence_receiver_ref;
+    using __id = basic_any_sequence_receiver_ref;
+    using __t = basic_any_sequence_receiver_ref;
     using receiver_concept = stdexec::receiver_t;
 
     template <auto... _SenderQueries>
@@ -292,7 +814,7 @@ namespace exec {
 
     template <stdexec::__not_decays_to<__t> _Receiver>
       requires sequence_receiver_of<_Receiver, _Completions>
-    any_sequence_receiver_ref(_Receiver& __receiver) noexcept
+    basic_any_sequence_receiver_ref(_Receiver& __receiver) noexcept
       : __receiver_(__receiver) {
     }
 
@@ -329,13 +851,15 @@ namespace exec {
     }
   };
 
-  template <class _Completions, auto... _ReceiverQueries>
+  template <class _Completions, std::size_t _InlineItemSize, auto... _ReceiverQueries>
   template <auto... _SenderQueries>
-  class any_sequence_receiver_ref<_Completions, _ReceiverQueries...>::any_sender {
+  class basic_any_sequence_receiver_ref<_Completions, _InlineItemSize, _ReceiverQueries...>::
+    any_sender {
     using __sender_base = stdexec::__t<__any::__sequence_sender<
       _Completions,
       queries<_SenderQueries...>,
-      queries<_ReceiverQueries...>
+      queries<_ReceiverQueries...>,
+      _InlineItemSize
     >>;
     __sender_base __sender_;
 
@@ -363,4 +887,10 @@ namespace exec {
     }
   };
 
+  template <class _Completions, auto... _ReceiverQueries>
+  using any_sequence_receiver_ref = basic_any_sequence_receiver_ref<
+    _Completions,
+    __any::__next::__default_inline_size,
+    _ReceiverQueries...
+  >;
 } // namespace exec
\ No newline at end of file
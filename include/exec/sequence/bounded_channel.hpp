@@ -0,0 +1,487 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../../stdexec/concepts.hpp"
+#include "../../stdexec/execution.hpp"
+#include "../../stdexec/__detail/__intrusive_queue.hpp"
+#include "../../stdexec/__detail/__manual_lifetime.hpp"
+#include "../../stdexec/__detail/__optional.hpp"
+#include "../sequence_senders.hpp"
+
+#include "../trampoline_scheduler.hpp"
+#include "../sequence.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <type_traits>
+
+namespace exec {
+  namespace __channel {
+    using namespace stdexec;
+
+    enum class __status {
+      __ready,
+      __closed,
+      __stopped
+    };
+
+    // A producer that is waiting for a free slot. The value stays in the operation state of the
+    // waiting `send` operation until a consumer makes room for it.
+    template <class _Ty>
+    struct __send_waiter {
+      __send_waiter* __next_{nullptr};
+      void (*__complete_)(__send_waiter*, __status) noexcept;
+      _Ty* __value_;
+    };
+
+    // A consumer that is waiting for an item. Producers hand their value over directly into
+    // __value_ before completing the waiter.
+    template <class _Ty>
+    struct __receive_waiter {
+      __receive_waiter* __next_{nullptr};
+      void (*__complete_)(__receive_waiter*, __status) noexcept;
+      __optional<_Ty> __value_{};
+    };
+
+    template <auto _Next, class _Item>
+    auto __erase(__intrusive_queue<_Next>& __queue, _Item* __item) noexcept -> bool {
+      bool __found = false;
+      __intrusive_queue<_Next> __rest;
+      while (!__queue.empty()) {
+        _Item* __front = __queue.pop_front();
+        if (__front == __item) {
+          __found = true;
+        } else {
+          __rest.push_back(__front);
+        }
+      }
+      __queue = static_cast<__intrusive_queue<_Next>&&>(__rest);
+      return __found;
+    }
+
+    // The part of the channel that does not depend on its capacity. The ring buffer storage is
+    // owned by the derived `bounded_channel` so that no allocation happens at any point.
+    //
+    // The ring and both waiter queues are guarded by one mutex rather than being lock-free: a
+    // consumer that finds the ring empty must enqueue itself in the same step in which a
+    // producer would otherwise fill the ring, or its wake-up is lost, and a lock-free scheme
+    // would need to update the ring indices and a waiter queue as one atomic unit. The mutex is
+    // only held for this bookkeeping, never while an operation completes, and a send or receive
+    // that has to wait parks its operation state in a queue instead of blocking its thread.
+    template <class _Ty>
+    class __channel_base : __immovable {
+     public:
+      using __send_waiter_t = __send_waiter<_Ty>;
+      using __receive_waiter_t = __receive_waiter<_Ty>;
+
+      __channel_base(__manual_lifetime<_Ty>* __slots, std::size_t __capacity) noexcept
+        : __slots_{__slots}
+        , __capacity_{__capacity} {
+      }
+
+      ~__channel_base() {
+        STDEXEC_ASSERT(__senders_.empty());
+        STDEXEC_ASSERT(__receivers_.empty());
+        STDEXEC_ASSERT(__size_ == 0);
+      }
+
+      // Marks the channel as closed. Consumers drain the remaining items and then complete their
+      // sequence with set_value(). Producers that are waiting for a free slot, and all later
+      // producers, complete with set_stopped().
+      void close() noexcept {
+        std::unique_lock __guard{__mutex_};
+        if (__closed_) {
+          return;
+        }
+        __closed_ = true;
+        auto __senders = static_cast<__intrusive_queue<&__send_waiter_t::__next_>&&>(__senders_);
+        auto __receivers =
+          static_cast<__intrusive_queue<&__receive_waiter_t::__next_>&&>(__receivers_);
+        __guard.unlock();
+        while (!__receivers.empty()) {
+          __receive_waiter_t* __receiver = __receivers.pop_front();
+          __receiver->__complete_(__receiver, __status::__closed);
+        }
+        while (!__senders.empty()) {
+          __send_waiter_t* __sender = __senders.pop_front();
+          __sender->__complete_(__sender, __status::__closed);
+        }
+      }
+
+      template <class _Token>
+      void __push(__send_waiter_t* __waiter, const _Token& __token) noexcept {
+        std::unique_lock __guard{__mutex_};
+        if (__closed_) {
+          __guard.unlock();
+          __waiter->__complete_(__waiter, __status::__closed);
+        } else if (!__receivers_.empty()) {
+          // The buffer is empty and a consumer is waiting: hand the value over directly.
+          __receive_waiter_t* __receiver = __receivers_.pop_front();
+          __guard.unlock();
+          __receiver->__value_.emplace(static_cast<_Ty&&>(*__waiter->__value_));
+          __receiver->__complete_(__receiver, __status::__ready);
+          __waiter->__complete_(__waiter, __status::__ready);
+        } else if (__size_ < __capacity_) {
+          __slots_[(__head_ + __size_) % __capacity_].__construct(
+            static_cast<_Ty&&>(*__waiter->__value_));
+          ++__size_;
+          __guard.unlock();
+          __waiter->__complete_(__waiter, __status::__ready);
+        } else if (__token.stop_requested()) {
+          __guard.unlock();
+          __waiter->__complete_(__waiter, __status::__stopped);
+        } else {
+          __senders_.push_back(__waiter);
+        }
+      }
+
+      template <class _Token>
+      void __pop(__receive_waiter_t* __waiter, const _Token& __token) noexcept {
+        // A consumer that is asked to stop takes no further items, even while producers keep
+        // the buffer filled.
+        if (__token.stop_requested()) {
+          __waiter->__complete_(__waiter, __status::__stopped);
+          return;
+        }
+        std::unique_lock __guard{__mutex_};
+        if (__size_ != 0) {
+          __manual_lifetime<_Ty>& __front = __slots_[__head_];
+          __waiter->__value_.emplace(static_cast<_Ty&&>(__front.__get()));
+          __front.__destroy();
+          __head_ = (__head_ + 1) % __capacity_;
+          --__size_;
+          // A slot became free: move the value of the oldest waiting producer into it.
+          __send_waiter_t* __sender = nullptr;
+          if (!__senders_.empty()) {
+            __sender = __senders_.pop_front();
+            __slots_[(__head_ + __size_) % __capacity_].__construct(
+              static_cast<_Ty&&>(*__sender->__value_));
+            ++__size_;
+          }
+          __guard.unlock();
+          if (__sender) {
+            __sender->__complete_(__sender, __status::__ready);
+          }
+          __waiter->__complete_(__waiter, __status::__ready);
+        } else if (__closed_) {
+          __guard.unlock();
+          __waiter->__complete_(__waiter, __status::__closed);
+        } else {
+          __receivers_.push_back(__waiter);
+        }
+      }
+
+      // Destroys the items that are still buffered. Called by the owner of the slots.
+      void __clear() noexcept {
+        for (std::size_t __i = 0; __i < __size_; ++__i) {
+          __slots_[(__head_ + __i) % __capacity_].__destroy();
+        }
+        __size_ = 0;
+      }
+
+      template <class _Waiter>
+      void __cancel(_Waiter* __waiter) noexcept {
+        std::unique_lock __guard{__mutex_};
+        bool __found = false;
+        if constexpr (same_as<_Waiter, __send_waiter_t>) {
+          __found = __channel::__erase(__senders_, __waiter);
+        } else {
+          __found = __channel::__erase(__receivers_, __waiter);
+        }
+        __guard.unlock();
+        if (__found) {
+          __waiter->__complete_(__waiter, __status::__stopped);
+        }
+      }
+
+     private:
+      std::mutex __mutex_;
+      __manual_lifetime<_Ty>* __slots_;
+      std::size_t __capacity_;
+      std::size_t __head_{0};
+      std::size_t __size_{0};
+      bool __closed_{false};
+      __intrusive_queue<&__send_waiter_t::__next_> __senders_;
+      __intrusive_queue<&__receive_waiter_t::__next_> __receivers_;
+    };
+
+    template <class _Waiter, class _Ty>
+    struct __on_stop_requested {
+      __channel_base<_Ty>* __channel_;
+      _Waiter* __waiter_;
+
+      void operator()() const noexcept {
+        __channel_->__cancel(__waiter_);
+      }
+    };
+
+    template <class _Receiver, class _Waiter, class _Ty>
+    using __on_stop_t = stop_callback_for_t<
+      stop_token_of_t<env_of_t<_Receiver>>,
+      __on_stop_requested<_Waiter, _Ty>
+    >;
+
+    template <class _Ty, class _ReceiverId>
+    struct __send_operation {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+
+      struct __t : __send_waiter<_Ty> {
+        using __id = __send_operation;
+
+        __channel_base<_Ty>* __channel_;
+        _Ty __item_;
+        _Receiver __rcvr_;
+        __optional<__on_stop_t<_Receiver, __send_waiter<_Ty>, _Ty>> __on_stop_{};
+
+        static void __complete(__send_waiter<_Ty>* __waiter, __status __stat) noexcept {
+          auto* __self = static_cast<__t*>(__waiter);
+          __self->__on_stop_.reset();
+          if (__stat == __status::__ready) {
+            stdexec::set_value(static_cast<_Receiver&&>(__self->__rcvr_));
+          } else {
+            stdexec::set_stopped(static_cast<_Receiver&&>(__self->__rcvr_));
+          }
+        }
+
+        __t(__channel_base<_Ty>* __channel, _Ty&& __item, _Receiver&& __rcvr) noexcept
+          : __send_waiter<_Ty>{nullptr, &__complete, &__item_}
+          , __channel_{__channel}
+          , __item_{static_cast<_Ty&&>(__item)}
+          , __rcvr_{static_cast<_Receiver&&>(__rcvr)} {
+        }
+
+        void start() & noexcept {
+          auto __token = stdexec::get_stop_token(stdexec::get_env(__rcvr_));
+          __on_stop_.emplace(
+            __token, __on_stop_requested<__send_waiter<_Ty>, _Ty>{__channel_, this});
+          __channel_->__push(this, __token);
+        }
+      };
+    };
+
+    template <class _Ty>
+    struct __send_sender {
+      struct __t {
+        using __id = __send_sender;
+        using sender_concept = stdexec::sender_t;
+        using completion_signatures =
+          stdexec::completion_signatures<set_value_t(), set_stopped_t()>;
+
+        template <class _Receiver>
+        using __operation_t = stdexec::__t<__send_operation<_Ty, stdexec::__id<_Receiver>>>;
+
+        __channel_base<_Ty>* __channel_;
+        _Ty __item_;
+
+        template <receiver_of<completion_signatures> _Receiver>
+        auto connect(_Receiver __rcvr) && noexcept -> __operation_t<_Receiver> {
+          return {__channel_, static_cast<_Ty&&>(__item_), static_cast<_Receiver&&>(__rcvr)};
+        }
+
+        template <receiver_of<completion_signatures> _Receiver>
+          requires copy_constructible<_Ty>
+        auto connect(_Receiver __rcvr) const & noexcept(__nothrow_copy_constructible<_Ty>)
+          -> __operation_t<_Receiver> {
+          return {__channel_, _Ty(__item_), static_cast<_Receiver&&>(__rcvr)};
+        }
+      };
+    };
+
+    template <class _Ty>
+    using __item_sender_t = __result_of<
+      exec::sequence,
+      schedule_result_t<trampoline_scheduler&>,
+      __result_of<stdexec::just, _Ty>
+    >;
+
+    template <class _Ty, class _ReceiverId>
+    struct __receive_operation {
+      struct __t;
+    };
+
+    template <class _Ty, class _ReceiverId>
+    struct __next_receiver {
+      struct __t {
+        using _Receiver = stdexec::__t<_ReceiverId>;
+        using __id = __next_receiver;
+        using receiver_concept = stdexec::receiver_t;
+        stdexec::__t<__receive_operation<_Ty, _ReceiverId>>* __op_;
+
+        void set_value() noexcept {
+          __op_->__receive_next();
+        }
+
+        void set_stopped() noexcept {
+          __op_->__on_stop_.reset();
+          __set_value_unless_stopped(static_cast<_Receiver&&>(__op_->__rcvr_));
+        }
+
+        auto get_env() const noexcept -> env_of_t<_Receiver> {
+          return stdexec::get_env(__op_->__rcvr_);
+        }
+      };
+    };
+
+    template <class _Ty, class _ReceiverId>
+    struct __receive_operation<_Ty, _ReceiverId>::__t : __receive_waiter<_Ty> {
+      using __id = __receive_operation;
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __next_receiver_t = stdexec::__t<__next_receiver<_Ty, _ReceiverId>>;
+
+      __channel_base<_Ty>* __channel_;
+      _Receiver __rcvr_;
+      __optional<__on_stop_t<_Receiver, __receive_waiter<_Ty>, _Ty>> __on_stop_{};
+      __optional<
+        connect_result_t<next_sender_of_t<_Receiver, __item_sender_t<_Ty>>, __next_receiver_t>
+      >
+        __op_{};
+      trampoline_scheduler __scheduler_{};
+
+      __t(__channel_base<_Ty>* __channel, _Receiver&& __rcvr)
+        noexcept(__nothrow_move_constructible<_Receiver>)
+        : __receive_waiter<_Ty>{nullptr, &__complete}
+        , __channel_{__channel}
+        , __rcvr_{static_cast<_Receiver&&>(__rcvr)} {
+      }
+
+      static void __complete(__receive_waiter<_Ty>* __waiter, __status __stat) noexcept {
+        auto* __self = static_cast<__t*>(__waiter);
+        if (__stat == __status::__ready) {
+          __self->__deliver();
+        } else {
+          __self->__on_stop_.reset();
+          if (__stat == __status::__closed) {
+            stdexec::set_value(static_cast<_Receiver&&>(__self->__rcvr_));
+          } else {
+            stdexec::set_stopped(static_cast<_Receiver&&>(__self->__rcvr_));
+          }
+        }
+      }
+
+      void __deliver() noexcept {
+        STDEXEC_TRY {
+          auto __item = stdexec::just(static_cast<_Ty&&>(*this->__value_));
+          this->__value_.reset();
+          stdexec::start(__op_.__emplace_from([&] {
+            return stdexec::connect(
+              exec::set_next(
+                __rcvr_, exec::sequence(stdexec::schedule(__scheduler_), std::move(__item))),
+              __next_receiver_t{this});
+          }));
+        }
+        STDEXEC_CATCH_ALL {
+          __on_stop_.reset();
+          stdexec::set_error(static_cast<_Receiver&&>(__rcvr_), std::current_exception());
+        }
+      }
+
+      void __receive_next() noexcept {
+        __channel_->__pop(this, stdexec::get_stop_token(stdexec::get_env(__rcvr_)));
+      }
+
+      void start() & noexcept {
+        __on_stop_.emplace(
+          stdexec::get_stop_token(stdexec::get_env(__rcvr_)),
+          __on_stop_requested<__receive_waiter<_Ty>, _Ty>{__channel_, this});
+        __receive_next();
+      }
+    };
+
+    template <class _Ty>
+    struct __receive_sender {
+      struct __t {
+        using __id = __receive_sender;
+        using sender_concept = sequence_sender_t;
+        using completion_signatures = stdexec::completion_signatures<
+          set_value_t(),
+          set_error_t(std::exception_ptr),
+          set_stopped_t()
+        >;
+        using item_types = exec::item_types<__item_sender_t<_Ty>>;
+
+        template <class _Receiver>
+        using __next_receiver_t = stdexec::__t<__next_receiver<_Ty, stdexec::__id<_Receiver>>>;
+
+        template <class _Receiver>
+        using __operation_t = stdexec::__t<__receive_operation<_Ty, stdexec::__id<_Receiver>>>;
+
+        __channel_base<_Ty>* __channel_;
+
+        template <__decays_to<__t> _Self, sequence_receiver_of<item_types> _Receiver>
+          requires sender_to<
+            next_sender_of_t<_Receiver, __item_sender_t<_Ty>>,
+            __next_receiver_t<_Receiver>
+          >
+        STDEXEC_MEMFN_DECL(auto subscribe)(this _Self&& __self, _Receiver __rcvr)
+          noexcept(__nothrow_move_constructible<_Receiver>) -> __operation_t<_Receiver> {
+          return {__self.__channel_, static_cast<_Receiver&&>(__rcvr)};
+        }
+      };
+    };
+  } // namespace __channel
+
+  //! A bounded multi-producer multi-consumer channel that connects senders running on different
+  //! execution contexts.
+  //!
+  //! Items are buffered in a ring of `_Capacity` pre-sized slots that is embedded in the channel
+  //! object, so neither sending nor receiving allocates. `send(value)` returns a sender that
+  //! completes once the value has been buffered or handed over to a waiting consumer; when the
+  //! buffer is full it suspends until a consumer makes room. `receive()` returns a sequence sender
+  //! that emits every item as `just(value)` until the channel is closed and drained.
+  //!
+  //! Both sides observe the stop token of their receiver. The channel must outlive every operation
+  //! that was started on it.
+  template <class _Ty, std::size_t _Capacity>
+  class bounded_channel : public __channel::__channel_base<_Ty> {
+    static_assert(_Capacity > 0, "A bounded_channel must have room for at least one item");
+    static_assert(
+      std::is_nothrow_move_constructible_v<_Ty>,
+      "The items of a bounded_channel must be nothrow move constructible");
+
+   public:
+    using value_type = _Ty;
+    using send_sender = stdexec::__t<__channel::__send_sender<_Ty>>;
+    using receive_sender = stdexec::__t<__channel::__receive_sender<_Ty>>;
+
+    bounded_channel() noexcept
+      : __channel::__channel_base<_Ty>{__slots_, _Capacity} {
+    }
+
+    ~bounded_channel() {
+      this->__clear();
+    }
+
+    [[nodiscard]]
+    static constexpr auto capacity() noexcept -> std::size_t {
+      return _Capacity;
+    }
+
+    [[nodiscard]]
+    auto send(_Ty __item) noexcept -> send_sender {
+      return {this, static_cast<_Ty&&>(__item)};
+    }
+
+    [[nodiscard]]
+    auto receive() noexcept -> receive_sender {
+      return {this};
+    }
+
+   private:
+    stdexec::__manual_lifetime<_Ty> __slots_[_Capacity];
+  };
+} // namespace exec
@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../../stdexec/concepts.hpp"
+#include "../../stdexec/execution.hpp"
+#include "../../stdexec/__detail/__optional.hpp"
+#include "../../stdexec/__detail/__scope.hpp"
+#include "../../stdexec/__detail/__spin_loop_pause.hpp"
+#include "../__detail/__thread_index.hpp"
+#include "../sequence_senders.hpp"
+#include "./ignore_all_values.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <variant>
+
+namespace exec {
+  namespace __fold {
+    using namespace stdexec;
+
+    // Accumulates items in the order in which they arrive. Concurrent items are serialized.
+    template <class _Ty, class _Fun>
+    struct __serial_accumulator {
+      std::mutex __mutex_{};
+      _Ty __acc_;
+      STDEXEC_ATTRIBUTE(no_unique_address) _Fun __fun_;
+
+      __serial_accumulator(_Ty&& __init, _Fun&& __fun)
+        : __acc_(static_cast<_Ty&&>(__init))
+        , __fun_(static_cast<_Fun&&>(__fun)) {
+      }
+
+      template <class... _Args>
+      void __accumulate(_Args&&... __args) {
+        std::lock_guard __guard{__mutex_};
+        __acc_ = __fun_(static_cast<_Ty&&>(__acc_), static_cast<_Args&&>(__args)...);
+      }
+
+      auto __result() -> _Ty {
+        return static_cast<_Ty&&>(__acc_);
+      }
+    };
+
+    // Accumulates items into per-thread partial results which live on separate cache lines.
+    // The partials are combined pairwise in a tree once the sequence has completed. This
+    // requires the function to be associative and commutative.
+    template <class _Ty, class _Fun>
+    struct __partitioned_accumulator {
+      struct alignas(64) __partial {
+        std::atomic_flag __lock_{};
+        __optional<_Ty> __value_{};
+
+        void __lock() noexcept {
+          while (__lock_.test_and_set(std::memory_order_acquire)) {
+            while (__lock_.test(std::memory_order_relaxed)) {
+              __spin_loop_pause();
+            }
+          }
+        }
+
+        void __unlock() noexcept {
+          __lock_.clear(std::memory_order_release);
+        }
+      };
+
+      _Ty __init_;
+      STDEXEC_ATTRIBUTE(no_unique_address) _Fun __fun_;
+      std::size_t __size_{std::max(1u, std::thread::hardware_concurrency())};
+      std::unique_ptr<__partial[]> __partials_{new __partial[__size_]};
+
+      __partitioned_accumulator(_Ty&& __init, _Fun&& __fun)
+        : __init_(static_cast<_Ty&&>(__init))
+        , __fun_(static_cast<_Fun&&>(__fun)) {
+      }
+
+      template <class... _Args>
+      void __accumulate(_Args&&... __args) {
+        _Ty __value(static_cast<_Args&&>(__args)...);
+        __partial& __part = __partials_[exec::__this_thread_index() % __size_];
+        __part.__lock();
+        __scope_guard __guard{[&]() noexcept { __part.__unlock(); }};
+        if (__part.__value_.has_value()) {
+          *__part.__value_ =
+            __fun_(static_cast<_Ty&&>(*__part.__value_), static_cast<_Ty&&>(__value));
+        } else {
+          __part.__value_.emplace(static_cast<_Ty&&>(__value));
+        }
+      }
+
+      auto __result() -> _Ty {
+        for (std::size_t __stride = 1; __stride < __size_; __stride *= 2) {
+          for (std::size_t __i = 0; __i + __stride < __size_; __i += 2 * __stride) {
+            __optional<_Ty>& __lhs = __partials_[__i].__value_;
+            __optional<_Ty>& __rhs = __partials_[__i + __stride].__value_;
+            if (!__rhs.has_value()) {
+              continue;
+            }
+            if (__lhs.has_value()) {
+              *__lhs = __fun_(static_cast<_Ty&&>(*__lhs), static_cast<_Ty&&>(*__rhs));
+            } else {
+              __lhs.emplace(static_cast<_Ty&&>(*__rhs));
+            }
+            __rhs.reset();
+          }
+        }
+        __optional<_Ty>& __total = __partials_[0].__value_;
+        if (__total.has_value()) {
+          return __fun_(static_cast<_Ty&&>(__init_), static_cast<_Ty&&>(*__total));
+        }
+        return static_cast<_Ty&&>(__init_);
+      }
+    };
+
+    template <class _Accumulator, class _ResultVariant>
+    struct __state : __ignore_all_values::__result_type<_ResultVariant> {
+      _Accumulator __acc_;
+
+      template <class _Ty, class _Fun>
+      __state(_Ty&& __init, _Fun&& __fun)
+        : __acc_(static_cast<_Ty&&>(__init), static_cast<_Fun&&>(__fun)) {
+      }
+
+      template <class _Receiver>
+      void __complete(_Receiver&& __rcvr) noexcept {
+        if (this->__emplaced_.load(std::memory_order_acquire) == 0) {
+          STDEXEC_TRY {
+            stdexec::set_value(static_cast<_Receiver&&>(__rcvr), __acc_.__result());
+          }
+          STDEXEC_CATCH_ALL {
+            stdexec::set_error(static_cast<_Receiver&&>(__rcvr), std::current_exception());
+          }
+          return;
+        }
+        std::visit(
+          [&]<class _Tuple>(_Tuple&& __tuple) noexcept {
+            if constexpr (__not_decays_to<_Tuple, std::monostate>) {
+              std::apply(
+                [&]<__completion_tag _Tag, class... _Args>(
+                  _Tag __completion, _Args&&... __args) noexcept {
+                  __completion(static_cast<_Receiver&&>(__rcvr), static_cast<_Args&&>(__args)...);
+                },
+                static_cast<_Tuple&&>(__tuple));
+            }
+          },
+          static_cast<_ResultVariant&&>(this->__result_));
+      }
+    };
+
+    template <class _ItemReceiver, class _State>
+    struct __item_operation_base {
+      STDEXEC_ATTRIBUTE(no_unique_address) _ItemReceiver __rcvr_;
+      _State* __state_;
+    };
+
+    template <class _ItemReceiver, class _State>
+    struct __item_receiver {
+      struct __t {
+        using __id = __item_receiver;
+        using receiver_concept = stdexec::receiver_t;
+        __item_operation_base<_ItemReceiver, _State>* __op_;
+
+        template <class... _Args>
+        void set_value(_Args&&... __args) noexcept {
+          STDEXEC_TRY {
+            __op_->__state_->__acc_.__accumulate(static_cast<_Args&&>(__args)...);
+            stdexec::set_value(static_cast<_ItemReceiver&&>(__op_->__rcvr_));
+          }
+          STDEXEC_CATCH_ALL {
+            __op_->__state_->__emplace(set_error_t(), std::current_exception());
+            stdexec::set_stopped(static_cast<_ItemReceiver&&>(__op_->__rcvr_));
+          }
+        }
+
+        template <class _Error>
+        void set_error(_Error&& __error) noexcept {
+          __op_->__state_->__emplace(set_error_t(), static_cast<_Error&&>(__error));
+          stdexec::set_stopped(static_cast<_ItemReceiver&&>(__op_->__rcvr_));
+        }
+
+        void set_stopped() noexcept {
+          __op_->__state_->__emplace(set_stopped_t());
+          stdexec::set_stopped(static_cast<_ItemReceiver&&>(__op_->__rcvr_));
+        }
+
+        auto get_env() const noexcept -> env_of_t<_ItemReceiver> {
+          return stdexec::get_env(__op_->__rcvr_);
+        }
+      };
+    };
+
+    template <class _Sender, class _ItemReceiver, class _State>
+    struct __item_operation {
+      using __base_t = __item_operation_base<_ItemReceiver, _State>;
+      using __item_receiver_t = stdexec::__t<__item_receiver<_ItemReceiver, _State>>;
+
+      struct __t : __base_t {
+        using __id = __item_operation;
+        connect_result_t<_Sender, __item_receiver_t> __op_;
+
+        __t(_State* __state, _Sender&& __sndr, _ItemReceiver __rcvr)
+          : __base_t{static_cast<_ItemReceiver&&>(__rcvr), __state}
+          , __op_{stdexec::connect(static_cast<_Sender&&>(__sndr), __item_receiver_t{this})} {
+        }
+
+        void start() & noexcept {
+          stdexec::start(__op_);
+        }
+      };
+    };
+
+    template <class _Sender, class _State>
+    struct __item_sender {
+      struct __t {
+        using __id = __item_sender;
+        using sender_concept = stdexec::sender_t;
+        using completion_signatures =
+          stdexec::completion_signatures<set_value_t(), set_stopped_t()>;
+
+        template <class _Self, class _Receiver>
+        using __operation_t =
+          stdexec::__t<__item_operation<__copy_cvref_t<_Self, _Sender>, _Receiver, _State>>;
+
+        template <class _Receiver>
+        using __item_receiver_t = stdexec::__t<__item_receiver<_Receiver, _State>>;
+
+        _Sender __sndr_;
+        _State* __state_;
+
+        template <__decays_to<__t> _Self, receiver_of<completion_signatures> _Receiver>
+          requires sender_to<__copy_cvref_t<_Self, _Sender>, __item_receiver_t<_Receiver>>
+        static auto connect(_Self&& __self, _Receiver __rcvr) -> __operation_t<_Self, _Receiver> {
+          return {
+            __self.__state_, static_cast<_Self&&>(__self).__sndr_, static_cast<_Receiver&&>(__rcvr)};
+        }
+      };
+    };
+
+    template <class _Receiver, class _State>
+    struct __operation_base : _State {
+      STDEXEC_ATTRIBUTE(no_unique_address) _Receiver __rcvr_;
+
+      template <class _Ty, class _Fun>
+      __operation_base(_Ty&& __init, _Fun&& __fun, _Receiver&& __rcvr)
+        : _State(static_cast<_Ty&&>(__init), static_cast<_Fun&&>(__fun))
+        , __rcvr_(static_cast<_Receiver&&>(__rcvr)) {
+      }
+    };
+
+    template <class _ReceiverId, class _State>
+    struct __receiver {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+
+      struct __t {
+        using __id = __receiver;
+        using receiver_concept = stdexec::receiver_t;
+        __operation_base<_Receiver, _State>* __op_;
+
+        template <sender _Item>
+        [[nodiscard]]
+        auto set_next(_Item&& __item) & noexcept(__nothrow_decay_copyable<_Item>)
+          -> stdexec::__t<__item_sender<__decay_t<_Item>, _State>> {
+          return {static_cast<_Item&&>(__item), __op_};
+        }
+
+        void set_value() noexcept {
+          __op_->__complete(static_cast<_Receiver&&>(__op_->__rcvr_));
+        }
+
+        template <class _Error>
+        void set_error(_Error&& __error) noexcept {
+          stdexec::set_error(
+            static_cast<_Receiver&&>(__op_->__rcvr_), static_cast<_Error&&>(__error));
+        }
+
+        void set_stopped() noexcept {
+          stdexec::set_stopped(static_cast<_Receiver&&>(__op_->__rcvr_));
+        }
+
+        auto get_env() const noexcept -> env_of_t<_Receiver> {
+          return stdexec::get_env(__op_->__rcvr_);
+        }
+      };
+    };
+
+    template <class _Sequence, class... _Env>
+    using __result_variant_t = __ignore_all_values::__result_variant_<__concat_completion_signatures<
+      __sequence_completion_signatures_of_t<_Sequence, _Env...>,
+      completion_signatures<set_error_t(std::exception_ptr)>
+    >>;
+
+    template <class _Accumulator, class _Sequence, class _Receiver>
+    using __state_t = __state<_Accumulator, __result_variant_t<_Sequence, env_of_t<_Receiver>>>;
+
+    template <class _Accumulator, class _Sequence, class _ReceiverId>
+    struct __operation {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using _State = __state_t<_Accumulator, _Sequence, _Receiver>;
+      using __base_t = __operation_base<_Receiver, _State>;
+      using __receiver_t = stdexec::__t<__receiver<_ReceiverId, _State>>;
+
+      struct __t : __base_t {
+        using __id = __operation;
+        subscribe_result_t<_Sequence, __receiver_t> __op_;
+
+        template <class _Ty, class _Fun>
+        __t(_Sequence&& __seq, _Ty&& __init, _Fun&& __fun, _Receiver __rcvr)
+          : __base_t(
+              static_cast<_Ty&&>(__init),
+              static_cast<_Fun&&>(__fun),
+              static_cast<_Receiver&&>(__rcvr))
+          , __op_{exec::subscribe(static_cast<_Sequence&&>(__seq), __receiver_t{this})} {
+        }
+
+        void start() & noexcept {
+          stdexec::start(__op_);
+        }
+      };
+    };
+
+    template <template <class, class> class _Accumulator, class _SequenceId, class _Ty, class _Fun>
+    struct __sender {
+      using _Sequence = stdexec::__t<_SequenceId>;
+      using __accumulator_t = _Accumulator<_Ty, _Fun>;
+
+      struct __t {
+        using __id = __sender;
+        using sender_concept = stdexec::sender_t;
+
+        template <class _Self, class... _Env>
+        using __completions_t = stdexec::transform_completion_signatures<
+          __sequence_completion_signatures_of_t<__copy_cvref_t<_Self, _Sequence>, _Env...>,
+          completion_signatures<set_value_t(_Ty), set_error_t(std::exception_ptr)>,
+          __mconst<completion_signatures<>>::__f
+        >;
+
+        template <class _Self, class _Receiver>
+        using __operation_t = stdexec::__t<
+          __operation<__accumulator_t, __copy_cvref_t<_Self, _Sequence>, stdexec::__id<_Receiver>>
+        >;
+
+        template <class _Self, class _Receiver>
+        using __receiver_t = stdexec::__t<__receiver<
+          stdexec::__id<_Receiver>,
+          __state_t<__accumulator_t, __copy_cvref_t<_Self, _Sequence>, _Receiver>
+        >>;
+
+        _Sequence __seq_;
+        _Ty __init_;
+        _Fun __fun_;
+
+        template <__decays_to<__t> _Self, class... _Env>
+        static auto get_completion_signatures(_Self&&, _Env&&...) noexcept
+          -> __completions_t<_Self, _Env...> {
+          return {};
+        }
+
+        template <__decays_to<__t> _Self, receiver _Receiver>
+          requires receiver_of<_Receiver, __completions_t<_Self, env_of_t<_Receiver>>>
+                && sequence_sender_to<
+                     __copy_cvref_t<_Self, _Sequence>,
+                     __receiver_t<_Self, _Receiver>
+                >
+        static auto connect(_Self&& __self, _Receiver __rcvr) -> __operation_t<_Self, _Receiver> {
+          return {
+            static_cast<_Self&&>(__self).__seq_,
+            static_cast<_Self&&>(__self).__init_,
+            static_cast<_Self&&>(__self).__fun_,
+            static_cast<_Receiver&&>(__rcvr)};
+        }
+
+        auto get_env() const noexcept -> env_of_t<const _Sequence&> {
+          return stdexec::get_env(__seq_);
+        }
+      };
+    };
+
+    template <class _Tag, template <class, class> class _Accumulator>
+    struct __fold_base_t {
+      template <class _Sequence, class _Ty, class _Fun>
+      using __sender_t =
+        stdexec::__t<__sender<_Accumulator, stdexec::__id<__decay_t<_Sequence>>, __decay_t<_Ty>, _Fun>>;
+
+      template <sender _Sequence, class _Ty, __movable_value _Fun>
+        requires move_constructible<__decay_t<_Ty>>
+      auto operator()(_Sequence&& __seq, _Ty&& __init, _Fun __fun) const
+        -> __sender_t<_Sequence, _Ty, _Fun> {
+        return {
+          static_cast<_Sequence&&>(__seq), static_cast<_Ty&&>(__init), static_cast<_Fun&&>(__fun)};
+      }
+
+      template <class _Ty, __movable_value _Fun>
+      STDEXEC_ATTRIBUTE(always_inline)
+      auto operator()(_Ty __init, _Fun __fun) const
+        -> __binder_back<_Tag, _Ty, _Fun> {
+        return {{static_cast<_Ty&&>(__init), static_cast<_Fun&&>(__fun)}, {}, {}};
+      }
+    };
+
+    //! `fold(seq, init, fun)` completes with `fun(...fun(fun(init, item0), item1)..., itemN)`
+    //! where the items are combined in the order in which they complete.
+    struct fold_t : __fold_base_t<fold_t, __serial_accumulator> { };
+
+    //! `reduce_each(seq, init, fun)` completes with the reduction of `init` and all items. `fun`
+    //! must be associative and commutative: items that complete concurrently are accumulated into
+    //! per-thread partial results, which are combined in a tree once the sequence completes.
+    struct reduce_each_t : __fold_base_t<reduce_each_t, __partitioned_accumulator> { };
+  } // namespace __fold
+
+  using __fold::fold_t;
+  inline constexpr fold_t fold{};
+
+  using __fold::reduce_each_t;
+  inline constexpr reduce_each_t reduce_each{};
+} // namespace exec
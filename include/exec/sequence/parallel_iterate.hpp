@@ -0,0 +1,449 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../../stdexec/__detail/__config.hpp"
+
+#if STDEXEC_HAS_STD_RANGES()
+
+#  include "../../stdexec/concepts.hpp"
+#  include "../../stdexec/execution.hpp"
+#  include "../../stdexec/__detail/__optional.hpp"
+#  include "../sequence_senders.hpp"
+
+#  include <algorithm>
+#  include <atomic>
+#  include <concepts>
+#  include <cstddef>
+#  include <exception>
+#  include <memory>
+#  include <ranges>
+
+namespace exec {
+  namespace __par_iterate {
+    using namespace stdexec;
+
+    template <class _Scheduler>
+    concept __has_available_parallelism = requires(const _Scheduler& __sched) {
+      { __sched.available_parallelism() } -> std::integral;
+    };
+
+    template <class _Scheduler>
+    auto __available_parallelism(const _Scheduler& __sched) noexcept -> std::size_t {
+      if constexpr (__has_available_parallelism<_Scheduler>) {
+        return std::max<std::size_t>(1, static_cast<std::size_t>(__sched.available_parallelism()));
+      } else {
+        return 1;
+      }
+    }
+
+    template <class _Receiver>
+    auto __get_allocator(const _Receiver& __rcvr) noexcept {
+      if constexpr (__callable<get_allocator_t, env_of_t<_Receiver>>) {
+        return stdexec::get_allocator(stdexec::get_env(__rcvr));
+      } else {
+        return std::allocator<char>{};
+      }
+    }
+
+    template <class _Range, class _Scheduler>
+    struct __operation_base {
+      _Range __range_;
+      _Scheduler __sched_;
+      std::ranges::iterator_t<_Range> __begin_{std::ranges::begin(__range_)};
+      std::size_t __size_{static_cast<std::size_t>(std::ranges::size(__range_))};
+      std::size_t __grain_;
+      alignas(64) std::atomic<std::size_t> __next_index_{0};
+      alignas(64) std::atomic<std::size_t> __active_agents_{0};
+      std::atomic<bool> __break_{false};
+      std::atomic<bool> __stopped_{false};
+      std::atomic<bool> __has_error_{false};
+      std::exception_ptr __error_{};
+
+      __operation_base(_Range&& __range, _Scheduler __sched, std::size_t __grain)
+        : __range_(static_cast<_Range&&>(__range))
+        , __sched_(static_cast<_Scheduler&&>(__sched))
+        , __grain_{__grain} {
+      }
+
+      void __set_error(std::exception_ptr __eptr) noexcept {
+        bool __expected = false;
+        if (__has_error_.compare_exchange_strong(__expected, true, std::memory_order_relaxed)) {
+          __error_ = static_cast<std::exception_ptr&&>(__eptr);
+        }
+      }
+    };
+
+    template <class _Range, class _Scheduler>
+    struct __item_operation_base {
+      __operation_base<_Range, _Scheduler>* __parent_;
+      std::size_t __index_;
+    };
+
+    template <class _Range, class _Scheduler, class _ItemRcvr>
+    struct __item_operation {
+      struct __t {
+        using __id = __item_operation;
+        STDEXEC_ATTRIBUTE(no_unique_address) _ItemRcvr __rcvr_;
+        __operation_base<_Range, _Scheduler>* __parent_;
+        std::size_t __index_;
+
+        void start() & noexcept {
+          stdexec::set_value(
+            static_cast<_ItemRcvr&&>(__rcvr_),
+            __parent_->__begin_[static_cast<std::ranges::range_difference_t<_Range>>(__index_)]);
+        }
+      };
+    };
+
+    template <class _Range, class _Scheduler>
+    struct __item_sender {
+      struct __t {
+        using __id = __item_sender;
+        using sender_concept = stdexec::sender_t;
+        using completion_signatures =
+          stdexec::completion_signatures<set_value_t(std::ranges::range_reference_t<_Range>)>;
+
+        __operation_base<_Range, _Scheduler>* __parent_;
+        std::size_t __index_;
+
+        struct __env {
+          _Scheduler __sched_;
+
+          auto query(get_completion_scheduler_t<set_value_t>) const noexcept -> _Scheduler {
+            return __sched_;
+          }
+        };
+
+        auto get_env() const noexcept -> __env {
+          return {__parent_->__sched_};
+        }
+
+        template <receiver_of<completion_signatures> _ItemRcvr>
+        auto connect(_ItemRcvr __rcvr) const & noexcept(__nothrow_decay_copyable<_ItemRcvr>)
+          -> stdexec::__t<__item_operation<_Range, _Scheduler, _ItemRcvr>> {
+          return {static_cast<_ItemRcvr&&>(__rcvr), __parent_, __index_};
+        }
+      };
+    };
+
+    template <class _Range, class _Scheduler, class _ReceiverId>
+    struct __operation {
+      struct __t;
+    };
+
+    template <class _Range, class _Scheduler, class _ReceiverId>
+    struct __agent {
+      struct __t;
+    };
+
+    // Receives the completion of the `schedule` sender that moves an agent onto the scheduler.
+    template <class _Range, class _Scheduler, class _ReceiverId>
+    struct __schedule_receiver {
+      struct __t {
+        using __id = __schedule_receiver;
+        using receiver_concept = stdexec::receiver_t;
+        using _Receiver = stdexec::__t<_ReceiverId>;
+        stdexec::__t<__agent<_Range, _Scheduler, _ReceiverId>>* __agent_;
+
+        void set_value() noexcept {
+          __agent_->__run();
+        }
+
+        template <class _Error>
+        void set_error(_Error&& __error) noexcept {
+          if constexpr (same_as<__decay_t<_Error>, std::exception_ptr>) {
+            __agent_->__parent_->__set_error(static_cast<_Error&&>(__error));
+          } else {
+            __agent_->__parent_->__set_error(
+              std::make_exception_ptr(static_cast<_Error&&>(__error)));
+          }
+          __agent_->__parent_->__agent_done();
+        }
+
+        void set_stopped() noexcept {
+          __agent_->__parent_->__stopped_.store(true, std::memory_order_relaxed);
+          __agent_->__parent_->__agent_done();
+        }
+
+        auto get_env() const noexcept -> env_of_t<_Receiver> {
+          return stdexec::get_env(__agent_->__parent_->__rcvr_);
+        }
+      };
+    };
+
+    // Receives the completion of the next-sender that the downstream receiver returned for an
+    // item.
+    template <class _Range, class _Scheduler, class _ReceiverId>
+    struct __next_receiver {
+      struct __t {
+        using __id = __next_receiver;
+        using receiver_concept = stdexec::receiver_t;
+        using _Receiver = stdexec::__t<_ReceiverId>;
+        stdexec::__t<__agent<_Range, _Scheduler, _ReceiverId>>* __agent_;
+
+        void set_value() noexcept {
+          __agent_->__item_done();
+        }
+
+        void set_stopped() noexcept {
+          __agent_->__parent_->__break_.store(true, std::memory_order_relaxed);
+          __agent_->__item_done();
+        }
+
+        auto get_env() const noexcept -> env_of_t<_Receiver> {
+          return stdexec::get_env(__agent_->__parent_->__rcvr_);
+        }
+      };
+    };
+
+    // An agent runs on the scheduler and repeatedly claims a chunk of `grain` consecutive
+    // elements from the shared index until the range is exhausted. Agents that finish early
+    // keep claiming chunks, which balances uneven per-element work across the agents.
+    template <class _Range, class _Scheduler, class _ReceiverId>
+    struct __agent<_Range, _Scheduler, _ReceiverId>::__t {
+      using __id = __agent;
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __operation_t = stdexec::__t<__operation<_Range, _Scheduler, _ReceiverId>>;
+      using __schedule_receiver_t =
+        stdexec::__t<__schedule_receiver<_Range, _Scheduler, _ReceiverId>>;
+      using __next_receiver_t = stdexec::__t<__next_receiver<_Range, _Scheduler, _ReceiverId>>;
+      using __item_sender_t = stdexec::__t<__item_sender<_Range, _Scheduler>>;
+      using __schedule_op_t = connect_result_t<schedule_result_t<_Scheduler&>, __schedule_receiver_t>;
+      using __next_op_t =
+        connect_result_t<next_sender_of_t<_Receiver, __item_sender_t>, __next_receiver_t>;
+
+      enum __state_t {
+        __starting,
+        __suspended,
+        __completed
+      };
+
+      __operation_t* __parent_;
+      std::size_t __index_{0};
+      std::size_t __end_{0};
+      std::atomic<__state_t> __state_{__starting};
+      __optional<__schedule_op_t> __schedule_op_{};
+      __optional<__next_op_t> __next_op_{};
+
+      explicit __t(__operation_t* __parent) noexcept
+        : __parent_{__parent} {
+      }
+
+      void start() & noexcept {
+        STDEXEC_TRY {
+          stdexec::start(__schedule_op_.__emplace_from([this] {
+            return stdexec::connect(
+              stdexec::schedule(__parent_->__sched_), __schedule_receiver_t{this});
+          }));
+        }
+        STDEXEC_CATCH_ALL {
+          __parent_->__set_error(std::current_exception());
+          __parent_->__agent_done();
+        }
+      }
+
+      // Starts the items of the claimed chunks one after another. If an item completes
+      // synchronously we loop instead of recursing; otherwise its completion resumes the loop.
+      void __run() noexcept {
+        do {
+          if (__index_ == __end_ && !__parent_->__claim(__index_, __end_)) {
+            __parent_->__agent_done();
+            return;
+          }
+          __state_.store(__starting, std::memory_order_relaxed);
+          STDEXEC_TRY {
+            stdexec::start(__next_op_.__emplace_from([this] {
+              return stdexec::connect(
+                exec::set_next(__parent_->__rcvr_, __item_sender_t{__parent_, __index_++}),
+                __next_receiver_t{this});
+            }));
+          }
+          STDEXEC_CATCH_ALL {
+            __parent_->__set_error(std::current_exception());
+            __parent_->__agent_done();
+            return;
+          }
+        } while (__state_.exchange(__suspended, std::memory_order_acq_rel) == __completed);
+      }
+
+      void __item_done() noexcept {
+        if (__state_.exchange(__completed, std::memory_order_acq_rel) == __suspended) {
+          __run();
+        }
+      }
+    };
+
+    template <class _Range, class _Scheduler, class _ReceiverId>
+    struct __operation<_Range, _Scheduler, _ReceiverId>::__t
+      : __operation_base<_Range, _Scheduler> {
+      using __id = __operation;
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __agent_t = stdexec::__t<__agent<_Range, _Scheduler, _ReceiverId>>;
+      using __allocator_t = std::allocator_traits<
+        decltype(__par_iterate::__get_allocator(__declval<const _Receiver&>()))
+      >::template rebind_alloc<__agent_t>;
+      using __alloc_traits = std::allocator_traits<__allocator_t>;
+
+      _Receiver __rcvr_;
+      std::size_t __num_agents_{0};
+      __allocator_t __allocator_;
+      __agent_t* __agents_{nullptr};
+
+      __t(_Range&& __range, _Scheduler __sched, std::size_t __grain, _Receiver&& __rcvr)
+        : __operation_base<_Range, _Scheduler>{
+            static_cast<_Range&&>(__range),
+            static_cast<_Scheduler&&>(__sched),
+            __grain}
+        , __rcvr_{static_cast<_Receiver&&>(__rcvr)}
+        , __allocator_(__par_iterate::__get_allocator(__rcvr_)) {
+        const std::size_t __parallelism = __par_iterate::__available_parallelism(this->__sched_);
+        if (this->__grain_ == 0) {
+          this->__grain_ = std::max<std::size_t>(1, this->__size_ / (4 * __parallelism));
+        }
+        const std::size_t __num_chunks = (this->__size_ + this->__grain_ - 1) / this->__grain_;
+        __num_agents_ = std::min(__parallelism, __num_chunks);
+        if (__num_agents_ != 0) {
+          __agents_ = __alloc_traits::allocate(__allocator_, __num_agents_);
+          for (std::size_t __i = 0; __i < __num_agents_; ++__i) {
+            std::construct_at(__agents_ + __i, this);
+          }
+        }
+      }
+
+      __t(__t&&) = delete;
+
+      ~__t() {
+        if (__agents_) {
+          std::destroy_n(__agents_, __num_agents_);
+          __alloc_traits::deallocate(__allocator_, __agents_, __num_agents_);
+        }
+      }
+
+      auto __claim(std::size_t& __begin, std::size_t& __end) noexcept -> bool {
+        if (
+          this->__break_.load(std::memory_order_relaxed)
+          || this->__has_error_.load(std::memory_order_relaxed)
+          || stdexec::get_stop_token(stdexec::get_env(__rcvr_)).stop_requested()) {
+          return false;
+        }
+        const std::size_t __first =
+          this->__next_index_.fetch_add(this->__grain_, std::memory_order_relaxed);
+        if (__first >= this->__size_) {
+          return false;
+        }
+        __begin = __first;
+        __end = std::min(__first + this->__grain_, this->__size_);
+        return true;
+      }
+
+      void __agent_done() noexcept {
+        if (this->__active_agents_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          __complete();
+        }
+      }
+
+      void __complete() noexcept {
+        if (this->__has_error_.load(std::memory_order_relaxed)) {
+          stdexec::set_error(
+            static_cast<_Receiver&&>(__rcvr_), static_cast<std::exception_ptr&&>(this->__error_));
+        } else if (this->__stopped_.load(std::memory_order_relaxed)) {
+          stdexec::set_stopped(static_cast<_Receiver&&>(__rcvr_));
+        } else {
+          __set_value_unless_stopped(static_cast<_Receiver&&>(__rcvr_));
+        }
+      }
+
+      void start() & noexcept {
+        if (__num_agents_ == 0) {
+          __complete();
+          return;
+        }
+        this->__active_agents_.store(__num_agents_, std::memory_order_relaxed);
+        // Agents may complete the whole operation before this loop ends, so we must not touch
+        // *this after starting the last agent.
+        __agent_t* __agents = __agents_;
+        const std::size_t __num_agents = __num_agents_;
+        for (std::size_t __i = 0; __i < __num_agents; ++__i) {
+          stdexec::start(__agents[__i]);
+        }
+      }
+    };
+
+    template <class _Range, class _Scheduler>
+    struct __sequence {
+      struct __t {
+        using __id = __sequence;
+        using sender_concept = sequence_sender_t;
+        using completion_signatures = stdexec::completion_signatures<
+          set_value_t(),
+          set_error_t(std::exception_ptr),
+          set_stopped_t()
+        >;
+        using __item_sender_t = stdexec::__t<__item_sender<_Range, _Scheduler>>;
+        using item_types = exec::item_types<__item_sender_t>;
+
+        template <class _Receiver>
+        using __operation_t = stdexec::__t<__operation<_Range, _Scheduler, stdexec::__id<_Receiver>>>;
+
+        template <class _Receiver>
+        using __next_receiver_t =
+          stdexec::__t<__next_receiver<_Range, _Scheduler, stdexec::__id<_Receiver>>>;
+
+        _Range __range_;
+        _Scheduler __sched_;
+        std::size_t __grain_;
+
+        template <exec::sequence_receiver_of<item_types> _Receiver>
+          requires sender_to<next_sender_of_t<_Receiver, __item_sender_t>, __next_receiver_t<_Receiver>>
+        auto subscribe(_Receiver __rcvr) && -> __operation_t<_Receiver> {
+          return {
+            static_cast<_Range&&>(__range_),
+            static_cast<_Scheduler&&>(__sched_),
+            __grain_,
+            static_cast<_Receiver&&>(__rcvr)};
+        }
+
+        template <exec::sequence_receiver_of<item_types> _Receiver>
+          requires __decay_copyable<const _Range&>
+                && sender_to<next_sender_of_t<_Receiver, __item_sender_t>, __next_receiver_t<_Receiver>>
+        auto subscribe(_Receiver __rcvr) const & -> __operation_t<_Receiver> {
+          return {_Range(__range_), _Scheduler(__sched_), __grain_, static_cast<_Receiver&&>(__rcvr)};
+        }
+      };
+    };
+
+    struct parallel_iterate_t {
+      //! Emits the elements of a random-access range as items that are processed concurrently on
+      //! `__sched`. The range is split into chunks of `__grain` consecutive elements (0 picks a
+      //! grain based on the scheduler's `available_parallelism()`), and up to
+      //! `available_parallelism()` agents claim and process chunks until the range is exhausted.
+      //! The sequence completes once every chunk has been processed.
+      template <std::ranges::random_access_range _Range, scheduler _Scheduler>
+        requires std::ranges::sized_range<_Range> && __decay_copyable<_Range>
+      auto operator()(_Range&& __range, _Scheduler __sched, std::size_t __grain = 0) const
+        -> stdexec::__t<__sequence<__decay_t<_Range>, _Scheduler>> {
+        return {
+          static_cast<_Range&&>(__range), static_cast<_Scheduler&&>(__sched), __grain};
+      }
+    };
+  } // namespace __par_iterate
+
+  using __par_iterate::parallel_iterate_t;
+  inline constexpr parallel_iterate_t parallel_iterate{};
+} // namespace exec
+
+#endif // STDEXEC_HAS_STD_RANGES()
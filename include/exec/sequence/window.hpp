@@ -0,0 +1,893 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../../stdexec/concepts.hpp"
+#include "../../stdexec/execution.hpp"
+#include "../../stdexec/__detail/__optional.hpp"
+#include "../sequence_senders.hpp"
+#include "../timed_scheduler.hpp"
+#include "./ignore_all_values.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace exec {
+  namespace __window {
+    using namespace stdexec;
+
+    struct __on_stop_requested {
+      inplace_stop_source& __stop_source_;
+
+      void operator()() noexcept {
+        __stop_source_.request_stop();
+      }
+    };
+
+    template <class _Env>
+    using __env_t = __join_env_t<prop<get_stop_token_t, inplace_stop_token>, _Env>;
+
+    // The pre-allocated accumulators of the windows that are currently open. A window is opened
+    // with a copy of the initial value and closed after it has counted `__length_` events.
+    template <class _Acc, class _Fun>
+    class __slots {
+      struct __slot {
+        __optional<_Acc> __acc_{};
+        std::size_t __events_{0};
+        std::size_t __items_{0};
+      };
+
+      _Acc __init_;
+      STDEXEC_ATTRIBUTE(no_unique_address) _Fun __fun_;
+      std::size_t __length_;
+      std::size_t __count_;
+      std::unique_ptr<__slot[]> __slots_;
+
+     public:
+      __slots(_Acc&& __init, _Fun&& __fun, std::size_t __length, std::size_t __count)
+        : __init_(static_cast<_Acc&&>(__init))
+        , __fun_(static_cast<_Fun&&>(__fun))
+        , __length_{__length}
+        , __count_{__count}
+        , __slots_{new __slot[__count]} {
+      }
+
+      void __open() {
+        for (std::size_t __i = 0; __i < __count_; ++__i) {
+          __slot& __s = __slots_[__i];
+          if (!__s.__acc_.has_value()) {
+            __s.__acc_.emplace(__init_);
+            __s.__events_ = 0;
+            __s.__items_ = 0;
+            return;
+          }
+        }
+        STDEXEC_ASSERT(!"window::__slots: no free slot");
+      }
+
+      template <class... _Args>
+      void __accumulate(_Args&... __args) {
+        for (std::size_t __i = 0; __i < __count_; ++__i) {
+          __slot& __s = __slots_[__i];
+          if (__s.__acc_.has_value()) {
+            *__s.__acc_ = __fun_(static_cast<_Acc&&>(*__s.__acc_), __args...);
+            ++__s.__items_;
+          }
+        }
+      }
+
+      // Counts an event for every open window and closes the window that reached its length.
+      void __advance(__optional<_Acc>& __closed) {
+        for (std::size_t __i = 0; __i < __count_; ++__i) {
+          __slot& __s = __slots_[__i];
+          if (__s.__acc_.has_value() && ++__s.__events_ == __length_) {
+            STDEXEC_ASSERT(!__closed.has_value());
+            __closed.emplace(static_cast<_Acc&&>(*__s.__acc_));
+            __s.__acc_.reset();
+          }
+        }
+      }
+
+      // Closes the oldest open window that has seen at least one item.
+      auto __flush(__optional<_Acc>& __closed) -> bool {
+        __slot* __oldest = nullptr;
+        for (std::size_t __i = 0; __i < __count_; ++__i) {
+          __slot& __s = __slots_[__i];
+          if (
+            __s.__acc_.has_value() && __s.__items_ != 0
+            && (__oldest == nullptr || __s.__events_ > __oldest->__events_)) {
+            __oldest = &__s;
+          }
+        }
+        if (__oldest == nullptr) {
+          return false;
+        }
+        __closed.emplace(static_cast<_Acc&&>(*__oldest->__acc_));
+        __oldest->__acc_.reset();
+        return true;
+      }
+    };
+
+    // Windows that close after `__size_` items. A new window opens every `__step_` items.
+    struct __by_count {
+      static constexpr bool __is_timed = false;
+
+      std::size_t __size_;
+      std::size_t __step_;
+
+      [[nodiscard]]
+      auto __length() const noexcept -> std::size_t {
+        return __size_;
+      }
+
+      [[nodiscard]]
+      auto __max_open() const noexcept -> std::size_t {
+        return (__size_ + __step_ - 1) / __step_;
+      }
+    };
+
+    // Windows that close after `__size_` has elapsed. A new window opens every `__step_`.
+    template <class _Scheduler>
+    struct __by_time {
+      static constexpr bool __is_timed = true;
+      using __duration_t = duration_of_t<_Scheduler>;
+
+      _Scheduler __sched_;
+      __duration_t __size_;
+      __duration_t __step_;
+
+      [[nodiscard]]
+      auto __length() const noexcept -> std::size_t {
+        auto __ticks = static_cast<std::size_t>((__size_ + __step_ - __duration_t{1}) / __step_);
+        return __ticks == 0 ? 1 : __ticks;
+      }
+
+      [[nodiscard]]
+      auto __max_open() const noexcept -> std::size_t {
+        return __length();
+      }
+    };
+
+    template <class _Acc>
+    using __window_sender_t = __call_result_t<just_t, _Acc>;
+
+    struct __emitter_base {
+      void (*__complete_)(void* __owner, bool __stopped) noexcept;
+      void* __owner_;
+    };
+
+    template <class _ReceiverId>
+    struct __emit_receiver {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+
+      struct __t {
+        using __id = __emit_receiver;
+        using receiver_concept = stdexec::receiver_t;
+        __emitter_base* __emitter_;
+        const _Receiver* __rcvr_;
+
+        void set_value() noexcept {
+          __emitter_->__complete_(__emitter_->__owner_, false);
+        }
+
+        void set_stopped() noexcept {
+          __emitter_->__complete_(__emitter_->__owner_, true);
+        }
+
+        auto get_env() const noexcept -> env_of_t<_Receiver> {
+          return stdexec::get_env(*__rcvr_);
+        }
+      };
+    };
+
+    // Passes a closed window to the downstream receiver and connects the resulting sender.
+    // `__complete_` is invoked with `__owner_` once that sender completes.
+    template <class _Receiver, class _Acc>
+    struct __emitter : __emitter_base {
+      using __emit_receiver_t = stdexec::__t<__emit_receiver<stdexec::__id<_Receiver>>>;
+      using __next_t = next_sender_of_t<_Receiver, __window_sender_t<_Acc>>;
+      using __op_t = connect_result_t<__next_t, __emit_receiver_t>;
+
+      __optional<__op_t> __op_{};
+
+      void __emit(_Receiver& __rcvr, _Acc&& __acc) {
+        __op_.__emplace_from([&] {
+          return stdexec::connect(
+            exec::set_next(__rcvr, stdexec::just(static_cast<_Acc&&>(__acc))),
+            __emit_receiver_t{this, &__rcvr});
+        });
+        stdexec::start(*__op_);
+      }
+    };
+
+    template <class _Base>
+    struct __timer_receiver {
+      struct __t {
+        using __id = __timer_receiver;
+        using receiver_concept = stdexec::receiver_t;
+        _Base* __op_;
+
+        void set_value() noexcept {
+          __op_->__on_tick();
+        }
+
+        template <class _Error>
+        void set_error(_Error&& __error) noexcept {
+          __op_->__fail(static_cast<_Error&&>(__error));
+          __op_->__finish_one();
+        }
+
+        void set_stopped() noexcept {
+          __op_->__finish_one();
+        }
+
+        auto get_env() const noexcept -> prop<get_stop_token_t, inplace_stop_token> {
+          return prop{get_stop_token, __op_->__stop_source_.get_token()};
+        }
+      };
+    };
+
+    using __timer_env_t = prop<get_stop_token_t, inplace_stop_token>;
+
+    template <class _Scheduler>
+    using __timer_sender_t =
+      __call_result_t<schedule_after_t, _Scheduler&, const duration_of_t<_Scheduler>&>;
+
+    // Count windows need no timer.
+    template <class _Policy, class _Base>
+    struct __timer_state { };
+
+    template <class _Scheduler, class _Base>
+    struct __timer_state<__by_time<_Scheduler>, _Base> {
+      using __receiver_t = stdexec::__t<__timer_receiver<_Base>>;
+      __optional<connect_result_t<__timer_sender_t<_Scheduler>, __receiver_t>> __op_{};
+    };
+
+    template <class _Policy, class _Env>
+    struct __timer_completions {
+      using __f = completion_signatures<>;
+    };
+
+    template <class _Scheduler, class _Env>
+    struct __timer_completions<__by_time<_Scheduler>, _Env> {
+      using __f = transform_completion_signatures_of<
+        __timer_sender_t<_Scheduler>,
+        __timer_env_t,
+        completion_signatures<>,
+        __mconst<completion_signatures<>>::__f
+      >;
+    };
+
+    template <class _Sequence, class _Policy, class _Env>
+    using __completions_t = __concat_completion_signatures<
+      __sequence_completion_signatures_of_t<_Sequence, __env_t<_Env>>,
+      typename __timer_completions<_Policy, _Env>::__f,
+      completion_signatures<set_value_t(), set_error_t(std::exception_ptr), set_stopped_t()>
+    >;
+
+    template <class _Receiver, class _Acc, class _Fun, class _Policy, class _ResultVariant>
+    struct __operation_base : __ignore_all_values::__result_type<_ResultVariant> {
+      using __on_stop_t = stop_callback_for_t<
+        stop_token_of_t<env_of_t<_Receiver>>,
+        __on_stop_requested
+      >;
+      using __receiver_t = _Receiver;
+      using __acc_t = _Acc;
+      using __policy_t = _Policy;
+
+      __operation_base(_Receiver&& __rcvr, _Acc&& __init, _Fun&& __fun, _Policy&& __policy)
+        : __rcvr_(static_cast<_Receiver&&>(__rcvr))
+        , __policy_(static_cast<_Policy&&>(__policy))
+        , __slots_(
+            static_cast<_Acc&&>(__init),
+            static_cast<_Fun&&>(__fun),
+            __policy_.__length(),
+            __policy_.__max_open()) {
+        if constexpr (_Policy::__is_timed) {
+          __slots_.__open();
+        }
+      }
+
+      STDEXEC_ATTRIBUTE(no_unique_address) _Receiver __rcvr_;
+      STDEXEC_ATTRIBUTE(no_unique_address) _Policy __policy_;
+      std::mutex __mutex_{};
+      __slots<_Acc, _Fun> __slots_;
+      std::size_t __index_{0};
+      inplace_stop_source __stop_source_{};
+      __optional<__on_stop_t> __on_stop_{};
+      std::atomic<int> __pending_{_Policy::__is_timed ? 2 : 1};
+      std::atomic<bool> __break_{false};
+      bool __upstream_stopped_{false};
+      __emitter<_Receiver, _Acc> __emitter_{};
+      STDEXEC_ATTRIBUTE(no_unique_address) __timer_state<_Policy, __operation_base> __timer_{};
+
+      void __start() noexcept {
+        __on_stop_.emplace(
+          stdexec::get_stop_token(stdexec::get_env(__rcvr_)),
+          __on_stop_requested{__stop_source_});
+        if constexpr (_Policy::__is_timed) {
+          __arm_timer();
+        }
+      }
+
+      // Accumulates an item into all open windows and returns the window that it closed, if any.
+      template <class... _Args>
+      void __on_item(__optional<_Acc>& __closed, _Args&... __args) {
+        std::lock_guard __guard{__mutex_};
+        if constexpr (!_Policy::__is_timed) {
+          if (__index_++ % __policy_.__step_ == 0) {
+            __slots_.__open();
+          }
+        }
+        __slots_.__accumulate(__args...);
+        if constexpr (!_Policy::__is_timed) {
+          __slots_.__advance(__closed);
+        }
+      }
+
+      void __arm_timer() noexcept {
+        if (__stop_source_.stop_requested()) {
+          __finish_one();
+          return;
+        }
+        using __receiver_t = __timer_state<_Policy, __operation_base>::__receiver_t;
+        STDEXEC_TRY {
+          __timer_.__op_.__emplace_from([this] {
+            return stdexec::connect(
+              exec::schedule_after(__policy_.__sched_, __policy_.__step_), __receiver_t{this});
+          });
+        }
+        STDEXEC_CATCH_ALL {
+          __fail(std::current_exception());
+          __finish_one();
+          return;
+        }
+        stdexec::start(*__timer_.__op_);
+      }
+
+      void __on_tick() noexcept {
+        __timer_.__op_.reset();
+        __optional<_Acc> __closed{};
+        STDEXEC_TRY {
+          std::lock_guard __guard{__mutex_};
+          __slots_.__advance(__closed);
+          __slots_.__open();
+        }
+        STDEXEC_CATCH_ALL {
+          __fail(std::current_exception());
+          __finish_one();
+          return;
+        }
+        if (!__closed.has_value()) {
+          __arm_timer();
+          return;
+        }
+        __emitter_.__complete_ = &__on_tick_emitted;
+        __emitter_.__owner_ = this;
+        STDEXEC_TRY {
+          __emitter_.__emit(__rcvr_, static_cast<_Acc&&>(*__closed));
+        }
+        STDEXEC_CATCH_ALL {
+          __fail(std::current_exception());
+          __finish_one();
+        }
+      }
+
+      static void __on_tick_emitted(void* __owner, bool __stopped) noexcept {
+        auto* __self = static_cast<__operation_base*>(__owner);
+        __self->__emitter_.__op_.reset();
+        if (__stopped) {
+          __self->__request_break();
+          __self->__finish_one();
+        } else {
+          __self->__arm_timer();
+        }
+      }
+
+      void __request_break() noexcept {
+        __break_.store(true, std::memory_order_relaxed);
+        __stop_source_.request_stop();
+      }
+
+      template <class _Error>
+      void __fail(_Error&& __error) noexcept {
+        this->__emplace(set_error_t(), static_cast<_Error&&>(__error));
+        __request_break();
+      }
+
+      void __upstream_complete(bool __stopped) noexcept {
+        __upstream_stopped_ = __stopped;
+        // Cancels the timer of time windows.
+        __stop_source_.request_stop();
+        __finish_one();
+      }
+
+      void __finish_one() noexcept {
+        if (__pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          __finalize();
+        }
+      }
+
+      void __finalize() noexcept {
+        __on_stop_.reset();
+        if (this->__emplaced_.load(std::memory_order_acquire) != 0) {
+          this->__visit_result(static_cast<_Receiver&&>(__rcvr_));
+        } else if (__upstream_stopped_) {
+          stdexec::set_stopped(static_cast<_Receiver&&>(__rcvr_));
+        } else if (__break_.load(std::memory_order_relaxed)) {
+          exec::__set_value_unless_stopped(static_cast<_Receiver&&>(__rcvr_));
+        } else {
+          __emitter_.__complete_ = &__on_flushed;
+          __emitter_.__owner_ = this;
+          __flush_next();
+        }
+      }
+
+      // Emits the remaining windows that have seen items, oldest first.
+      void __flush_next() noexcept {
+        __optional<_Acc> __closed{};
+        STDEXEC_TRY {
+          if (__slots_.__flush(__closed)) {
+            __emitter_.__emit(__rcvr_, static_cast<_Acc&&>(*__closed));
+            return;
+          }
+        }
+        STDEXEC_CATCH_ALL {
+          stdexec::set_error(static_cast<_Receiver&&>(__rcvr_), std::current_exception());
+          return;
+        }
+        exec::__set_value_unless_stopped(static_cast<_Receiver&&>(__rcvr_));
+      }
+
+      static void __on_flushed(void* __owner, bool __stopped) noexcept {
+        auto* __self = static_cast<__operation_base*>(__owner);
+        __self->__emitter_.__op_.reset();
+        if (__stopped) {
+          exec::__set_value_unless_stopped(static_cast<_Receiver&&>(__self->__rcvr_));
+        } else {
+          __self->__flush_next();
+        }
+      }
+    };
+
+    struct __no_emitter { };
+
+    // Items of count windows close windows themselves and emit them before completing.
+    template <class _ItemReceiver, class _Base>
+    struct __item_operation_base
+      : __if_c<
+          _Base::__policy_t::__is_timed,
+          __no_emitter,
+          __emitter<typename _Base::__receiver_t, typename _Base::__acc_t>
+        > {
+      using _Acc = _Base::__acc_t;
+
+      STDEXEC_ATTRIBUTE(no_unique_address) _ItemReceiver __rcvr_;
+      _Base* __base_;
+
+      __item_operation_base(_ItemReceiver&& __rcvr, _Base* __base)
+        : __rcvr_(static_cast<_ItemReceiver&&>(__rcvr))
+        , __base_{__base} {
+        if constexpr (!_Base::__policy_t::__is_timed) {
+          this->__complete_ = &__on_emitted;
+          this->__owner_ = this;
+        }
+      }
+
+      template <class... _Args>
+      void __on_value(_Args&... __args) noexcept {
+        __optional<_Acc> __closed{};
+        STDEXEC_TRY {
+          __base_->__on_item(__closed, __args...);
+          if constexpr (!_Base::__policy_t::__is_timed) {
+            if (__closed.has_value()) {
+              this->__emit(__base_->__rcvr_, static_cast<_Acc&&>(*__closed));
+              return;
+            }
+          }
+        }
+        STDEXEC_CATCH_ALL {
+          __base_->__fail(std::current_exception());
+          stdexec::set_stopped(static_cast<_ItemReceiver&&>(__rcvr_));
+          return;
+        }
+        stdexec::set_value(static_cast<_ItemReceiver&&>(__rcvr_));
+      }
+
+      static void __on_emitted(void* __owner, bool __stopped) noexcept {
+        auto* __self = static_cast<__item_operation_base*>(__owner);
+        __self->__op_.reset();
+        if (__stopped) {
+          __self->__base_->__request_break();
+          stdexec::set_stopped(static_cast<_ItemReceiver&&>(__self->__rcvr_));
+        } else {
+          stdexec::set_value(static_cast<_ItemReceiver&&>(__self->__rcvr_));
+        }
+      }
+    };
+
+    template <class _ItemReceiver, class _Base>
+    struct __item_receiver {
+      struct __t {
+        using __id = __item_receiver;
+        using receiver_concept = stdexec::receiver_t;
+        __item_operation_base<_ItemReceiver, _Base>* __op_;
+
+        template <class... _Args>
+        void set_value(_Args&&... __args) noexcept {
+          __op_->__on_value(__args...);
+        }
+
+        template <class _Error>
+        void set_error(_Error&& __error) noexcept {
+          __op_->__base_->__fail(static_cast<_Error&&>(__error));
+          stdexec::set_stopped(static_cast<_ItemReceiver&&>(__op_->__rcvr_));
+        }
+
+        void set_stopped() noexcept {
+          stdexec::set_stopped(static_cast<_ItemReceiver&&>(__op_->__rcvr_));
+        }
+
+        auto get_env() const noexcept -> env_of_t<_ItemReceiver> {
+          return stdexec::get_env(__op_->__rcvr_);
+        }
+      };
+    };
+
+    template <class _Sender, class _ItemReceiver, class _Base>
+    struct __item_operation {
+      using __base_t = __item_operation_base<_ItemReceiver, _Base>;
+      using __item_receiver_t = stdexec::__t<__item_receiver<_ItemReceiver, _Base>>;
+
+      struct __t : __base_t {
+        using __id = __item_operation;
+        connect_result_t<_Sender, __item_receiver_t> __item_op_;
+
+        __t(_Base* __base, _Sender&& __sndr, _ItemReceiver __rcvr)
+          : __base_t(static_cast<_ItemReceiver&&>(__rcvr), __base)
+          , __item_op_{stdexec::connect(static_cast<_Sender&&>(__sndr), __item_receiver_t{this})} {
+        }
+
+        void start() & noexcept {
+          stdexec::start(__item_op_);
+        }
+      };
+    };
+
+    template <class _Sender, class _Base>
+    struct __item_sender {
+      struct __t {
+        using __id = __item_sender;
+        using sender_concept = stdexec::sender_t;
+        using completion_signatures =
+          stdexec::completion_signatures<set_value_t(), set_stopped_t()>;
+
+        template <class _Self, class _Receiver>
+        using __operation_t =
+          stdexec::__t<__item_operation<__copy_cvref_t<_Self, _Sender>, _Receiver, _Base>>;
+
+        template <class _Receiver>
+        using __item_receiver_t = stdexec::__t<__item_receiver<_Receiver, _Base>>;
+
+        _Sender __sndr_;
+        _Base* __base_;
+
+        template <__decays_to<__t> _Self, receiver_of<completion_signatures> _Receiver>
+          requires sender_to<__copy_cvref_t<_Self, _Sender>, __item_receiver_t<_Receiver>>
+        static auto connect(_Self&& __self, _Receiver __rcvr) -> __operation_t<_Self, _Receiver> {
+          return {
+            __self.__base_, static_cast<_Self&&>(__self).__sndr_, static_cast<_Receiver&&>(__rcvr)};
+        }
+      };
+    };
+
+    template <class _Base>
+    struct __receiver {
+      using _Receiver = _Base::__receiver_t;
+
+      struct __t {
+        using __id = __receiver;
+        using receiver_concept = stdexec::receiver_t;
+        _Base* __op_;
+
+        template <sender _Item>
+        [[nodiscard]]
+        auto set_next(_Item&& __item) & noexcept(__nothrow_decay_copyable<_Item>)
+          -> stdexec::__t<__item_sender<__decay_t<_Item>, _Base>> {
+          return {static_cast<_Item&&>(__item), __op_};
+        }
+
+        void set_value() noexcept {
+          __op_->__upstream_complete(false);
+        }
+
+        template <class _Error>
+        void set_error(_Error&& __error) noexcept {
+          __op_->__fail(static_cast<_Error&&>(__error));
+          __op_->__upstream_complete(false);
+        }
+
+        void set_stopped() noexcept {
+          __op_->__upstream_complete(true);
+        }
+
+        auto get_env() const noexcept -> __env_t<env_of_t<_Receiver>> {
+          auto __token = prop{get_stop_token, __op_->__stop_source_.get_token()};
+          return __env::__join(std::move(__token), stdexec::get_env(__op_->__rcvr_));
+        }
+      };
+    };
+
+    template <class _Sequence, class _Acc, class _Fun, class _Policy, class _Receiver>
+    using __base_t = __operation_base<
+      _Receiver,
+      _Acc,
+      _Fun,
+      _Policy,
+      __ignore_all_values::__result_variant_<
+        __completions_t<_Sequence, _Policy, env_of_t<_Receiver>>
+      >
+    >;
+
+    template <class _Sequence, class _Acc, class _Fun, class _Policy, class _ReceiverId>
+    struct __operation {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __base_t = __window::__base_t<_Sequence, _Acc, _Fun, _Policy, _Receiver>;
+      using __receiver_t = stdexec::__t<__receiver<__base_t>>;
+
+      struct __t : __base_t {
+        using __id = __operation;
+        subscribe_result_t<_Sequence, __receiver_t> __op_;
+
+        __t(_Sequence&& __seq, _Acc&& __init, _Fun&& __fun, _Policy&& __policy, _Receiver __rcvr)
+          : __base_t(
+              static_cast<_Receiver&&>(__rcvr),
+              static_cast<_Acc&&>(__init),
+              static_cast<_Fun&&>(__fun),
+              static_cast<_Policy&&>(__policy))
+          , __op_{exec::subscribe(static_cast<_Sequence&&>(__seq), __receiver_t{this})} {
+        }
+
+        void start() & noexcept {
+          this->__start();
+          stdexec::start(__op_);
+        }
+      };
+    };
+
+    template <class _SequenceId, class _Acc, class _Fun, class _Policy>
+    struct __sequence {
+      using _Sequence = stdexec::__t<_SequenceId>;
+
+      struct __t {
+        using __id = __sequence;
+        using sender_concept = sequence_sender_t;
+        using item_types = exec::item_types<__window_sender_t<_Acc>>;
+
+        template <class _Self, class _Env>
+        using __completions_t =
+          __window::__completions_t<__copy_cvref_t<_Self, _Sequence>, _Policy, _Env>;
+
+        template <class _Self, class _Receiver>
+        using __operation_t = stdexec::__t<__operation<
+          __copy_cvref_t<_Self, _Sequence>,
+          _Acc,
+          _Fun,
+          _Policy,
+          stdexec::__id<_Receiver>
+        >>;
+
+        template <class _Self, class _Receiver>
+        using __receiver_t = stdexec::__t<__receiver<
+          __window::__base_t<__copy_cvref_t<_Self, _Sequence>, _Acc, _Fun, _Policy, _Receiver>
+        >>;
+
+        _Sequence __seq_;
+        _Acc __init_;
+        _Fun __fun_;
+        _Policy __policy_;
+
+        template <__decays_to<__t> _Self, class _Env>
+        static auto get_completion_signatures(_Self&&, _Env&&) noexcept
+          -> __completions_t<_Self, _Env> {
+          return {};
+        }
+
+        template <exec::sequence_receiver_of<item_types> _Receiver>
+          requires receiver_of<_Receiver, __completions_t<__t, env_of_t<_Receiver>>>
+                && sequence_sender_to<_Sequence, __receiver_t<__t, _Receiver>>
+        auto subscribe(_Receiver __rcvr) && -> __operation_t<__t, _Receiver> {
+          return {
+            static_cast<_Sequence&&>(__seq_),
+            static_cast<_Acc&&>(__init_),
+            static_cast<_Fun&&>(__fun_),
+            static_cast<_Policy&&>(__policy_),
+            static_cast<_Receiver&&>(__rcvr)};
+        }
+
+        template <exec::sequence_receiver_of<item_types> _Receiver>
+          requires __decay_copyable<const _Sequence&> && copy_constructible<_Fun>
+                && receiver_of<_Receiver, __completions_t<const __t&, env_of_t<_Receiver>>>
+                && sequence_sender_to<const _Sequence&, __receiver_t<const __t&, _Receiver>>
+        auto subscribe(_Receiver __rcvr) const & -> __operation_t<const __t&, _Receiver> {
+          return {__seq_, _Acc(__init_), _Fun(__fun_), _Policy(__policy_), static_cast<_Receiver&&>(__rcvr)};
+        }
+
+        auto get_env() const noexcept -> env_of_t<const _Sequence&> {
+          return stdexec::get_env(__seq_);
+        }
+      };
+    };
+
+    template <class _Sequence, class _Acc, class _Fun, class _Policy>
+    using __sequence_t =
+      stdexec::__t<__sequence<stdexec::__id<__decay_t<_Sequence>>, __decay_t<_Acc>, _Fun, _Policy>>;
+
+    struct window_by_count_t {
+      //! Groups the items of `__seq` into windows of `__size` items and emits one item per
+      //! window with the result of folding the window's values into a copy of `__init` with
+      //! `__fun(std::move(acc), values...)`. With a `__step` smaller than `__size`, a new window
+      //! opens every `__step` items and the windows overlap (sliding windows); otherwise each
+      //! item belongs to exactly one window (tumbling windows). When the sequence completes,
+      //! windows that are still open are emitted if they have seen any item.
+      template <sender _Sequence, class _Acc, __movable_value _Fun>
+        requires move_constructible<__decay_t<_Acc>> && copy_constructible<__decay_t<_Acc>>
+      auto operator()(
+        _Sequence&& __seq,
+        std::size_t __size,
+        std::size_t __step,
+        _Acc&& __init,
+        _Fun __fun) const -> __sequence_t<_Sequence, _Acc, _Fun, __by_count> {
+        STDEXEC_ASSERT(__size != 0 && __step != 0);
+        return {
+          static_cast<_Sequence&&>(__seq),
+          static_cast<_Acc&&>(__init),
+          static_cast<_Fun&&>(__fun),
+          __by_count{__size, __step}};
+      }
+
+      template <sender _Sequence, class _Acc, __movable_value _Fun>
+        requires move_constructible<__decay_t<_Acc>> && copy_constructible<__decay_t<_Acc>>
+      auto operator()(_Sequence&& __seq, std::size_t __size, _Acc&& __init, _Fun __fun) const
+        -> __sequence_t<_Sequence, _Acc, _Fun, __by_count> {
+        return (*this)(
+          static_cast<_Sequence&&>(__seq),
+          __size,
+          __size,
+          static_cast<_Acc&&>(__init),
+          static_cast<_Fun&&>(__fun));
+      }
+
+      template <class _Acc, __movable_value _Fun>
+      STDEXEC_ATTRIBUTE(always_inline)
+      auto operator()(std::size_t __size, std::size_t __step, _Acc __init, _Fun __fun) const
+        -> __binder_back<window_by_count_t, std::size_t, std::size_t, _Acc, _Fun> {
+        return {
+          {__size, __step, static_cast<_Acc&&>(__init), static_cast<_Fun&&>(__fun)}, {}, {}};
+      }
+
+      template <class _Acc, __movable_value _Fun>
+      STDEXEC_ATTRIBUTE(always_inline)
+      auto operator()(std::size_t __size, _Acc __init, _Fun __fun) const
+        -> __binder_back<window_by_count_t, std::size_t, std::size_t, _Acc, _Fun> {
+        return {{__size, __size, static_cast<_Acc&&>(__init), static_cast<_Fun&&>(__fun)}, {}, {}};
+      }
+    };
+
+    struct window_by_time_t {
+      //! Groups the items of `__seq` into windows that span `__size` on the clock of the timed
+      //! scheduler `__sched` and emits one item per window with the result of folding the
+      //! window's values into a copy of `__init`. A new window opens every `__step`; a `__step`
+      //! shorter than `__size` gives sliding windows, which close after `__size / __step` steps
+      //! rounded up. Windows are emitted from the timer's completion, and windows that are still
+      //! open when the sequence completes are emitted if they have seen any item.
+      template <sender _Sequence, __timed_scheduler _Scheduler, class _Acc, __movable_value _Fun>
+        requires move_constructible<__decay_t<_Acc>> && copy_constructible<__decay_t<_Acc>>
+      auto operator()(
+        _Sequence&& __seq,
+        _Scheduler __sched,
+        duration_of_t<_Scheduler> __size,
+        duration_of_t<_Scheduler> __step,
+        _Acc&& __init,
+        _Fun __fun) const -> __sequence_t<_Sequence, _Acc, _Fun, __by_time<_Scheduler>> {
+        [[maybe_unused]]
+        const bool __positive = __size > duration_of_t<_Scheduler>{}
+                             && __step > duration_of_t<_Scheduler>{};
+        STDEXEC_ASSERT(__positive);
+        return {
+          static_cast<_Sequence&&>(__seq),
+          static_cast<_Acc&&>(__init),
+          static_cast<_Fun&&>(__fun),
+          __by_time<_Scheduler>{static_cast<_Scheduler&&>(__sched), __size, __step}};
+      }
+
+      template <sender _Sequence, __timed_scheduler _Scheduler, class _Acc, __movable_value _Fun>
+        requires move_constructible<__decay_t<_Acc>> && copy_constructible<__decay_t<_Acc>>
+      auto operator()(
+        _Sequence&& __seq,
+        _Scheduler __sched,
+        duration_of_t<_Scheduler> __size,
+        _Acc&& __init,
+        _Fun __fun) const -> __sequence_t<_Sequence, _Acc, _Fun, __by_time<_Scheduler>> {
+        return (*this)(
+          static_cast<_Sequence&&>(__seq),
+          static_cast<_Scheduler&&>(__sched),
+          __size,
+          __size,
+          static_cast<_Acc&&>(__init),
+          static_cast<_Fun&&>(__fun));
+      }
+
+      template <__timed_scheduler _Scheduler, class _Acc, __movable_value _Fun>
+      STDEXEC_ATTRIBUTE(always_inline)
+      auto operator()(
+        _Scheduler __sched,
+        duration_of_t<_Scheduler> __size,
+        duration_of_t<_Scheduler> __step,
+        _Acc __init,
+        _Fun __fun) const -> __binder_back<
+        window_by_time_t,
+        _Scheduler,
+        duration_of_t<_Scheduler>,
+        duration_of_t<_Scheduler>,
+        _Acc,
+        _Fun
+      > {
+        return {
+          {static_cast<_Scheduler&&>(__sched),
+           __size,
+           __step,
+           static_cast<_Acc&&>(__init),
+           static_cast<_Fun&&>(__fun)},
+          {},
+          {}};
+      }
+
+      template <__timed_scheduler _Scheduler, class _Acc, __movable_value _Fun>
+      STDEXEC_ATTRIBUTE(always_inline)
+      auto operator()(
+        _Scheduler __sched,
+        duration_of_t<_Scheduler> __size,
+        _Acc __init,
+        _Fun __fun) const -> __binder_back<
+        window_by_time_t,
+        _Scheduler,
+        duration_of_t<_Scheduler>,
+        duration_of_t<_Scheduler>,
+        _Acc,
+        _Fun
+      > {
+        return {
+          {static_cast<_Scheduler&&>(__sched),
+           __size,
+           __size,
+           static_cast<_Acc&&>(__init),
+           static_cast<_Fun&&>(__fun)},
+          {},
+          {}};
+      }
+    };
+  } // namespace __window
+
+  using __window::window_by_count_t;
+  inline constexpr window_by_count_t window_by_count{};
+
+  using __window::window_by_time_t;
+  inline constexpr window_by_time_t window_by_time{};
+} // namespace exec
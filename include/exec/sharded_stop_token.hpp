@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/stop_token.hpp"
+#include "__detail/__thread_index.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+
+namespace exec {
+  class sharded_stop_source;
+  class sharded_stop_token;
+
+  template <class _Fun>
+  class sharded_stop_callback;
+
+  namespace __sharded_stop {
+    struct __callback_base {
+      void __execute() noexcept {
+        this->__execute_(this);
+      }
+
+     protected:
+      using __execute_fn_t = void(__callback_base*) noexcept;
+
+      explicit __callback_base(
+        const sharded_stop_source* __source,
+        __execute_fn_t* __execute) noexcept
+        : __source_(__source)
+        , __execute_(__execute) {
+      }
+
+      void __register_callback_() noexcept;
+
+      friend sharded_stop_source;
+
+      const sharded_stop_source* __source_;
+      __execute_fn_t* __execute_;
+      std::size_t __shard_ = 0;
+      __callback_base* __next_ = nullptr;
+      __callback_base** __prev_ptr_ = nullptr;
+      bool* __removed_during_callback_ = nullptr;
+      std::atomic<bool> __callback_completed_{false};
+    };
+  } // namespace __sharded_stop
+
+  //! A stop source for stop requests that many threads observe at once, e.g. the root of a
+  //! wide fan-out. It behaves like stdexec::inplace_stop_source, but its callback list is split
+  //! into `shard_count` shards, each on its own cache line and guarded by its own lock, and a
+  //! thread always registers its callbacks in the same shard. Registration and deregistration
+  //! from different threads thus rarely touch the same memory and don't spin on each other.
+  //! The price is size: a sharded_stop_source is about `shard_count` cache lines, so
+  //! inplace_stop_source remains the better choice for stop sources owned by one operation.
+  class sharded_stop_source {
+   public:
+    static constexpr std::size_t shard_count = 16;
+
+    sharded_stop_source() noexcept = default;
+    ~sharded_stop_source();
+    sharded_stop_source(sharded_stop_source&&) = delete;
+
+    auto get_token() const noexcept -> sharded_stop_token;
+
+    //! Requests stop and runs the registered callbacks on this thread. Returns `true` if this
+    //! call made the request, and `false` if stop had already been requested.
+    auto request_stop() noexcept -> bool;
+
+    auto stop_requested() const noexcept -> bool {
+      return __stop_requested_.load(std::memory_order_acquire);
+    }
+
+   private:
+    friend __sharded_stop::__callback_base;
+    template <class>
+    friend class sharded_stop_callback;
+
+    struct alignas(64) __shard {
+      void __lock() noexcept {
+        stdexec::__stok::__spin_wait __spin;
+        while (__locked_.exchange(true, std::memory_order_acquire)) {
+          while (__locked_.load(std::memory_order_relaxed)) {
+            __spin.__wait();
+          }
+        }
+      }
+
+      void __unlock() noexcept {
+        __locked_.store(false, std::memory_order_release);
+      }
+
+      std::atomic<bool> __locked_{false};
+      __sharded_stop::__callback_base* __callbacks_ = nullptr;
+    };
+
+    auto __try_add_callback_(__sharded_stop::__callback_base*) const noexcept -> bool;
+
+    void __remove_callback_(__sharded_stop::__callback_base*) const noexcept;
+
+    std::atomic<bool> __stop_requested_{false};
+    std::thread::id __notifying_thread_;
+    mutable __shard __shards_[shard_count];
+  };
+
+  //! The stop token of a sharded_stop_source.
+  class sharded_stop_token {
+   public:
+    template <class _Fun>
+    using callback_type = sharded_stop_callback<_Fun>;
+
+    sharded_stop_token() noexcept = default;
+
+    [[nodiscard]]
+    auto stop_requested() const noexcept -> bool {
+      return __source_ != nullptr && __source_->stop_requested();
+    }
+
+    [[nodiscard]]
+    auto stop_possible() const noexcept -> bool {
+      return __source_ != nullptr;
+    }
+
+    void swap(sharded_stop_token& __other) noexcept {
+      std::swap(__source_, __other.__source_);
+    }
+
+    auto operator==(const sharded_stop_token&) const noexcept -> bool = default;
+
+   private:
+    friend sharded_stop_source;
+    template <class>
+    friend class sharded_stop_callback;
+
+    explicit sharded_stop_token(const sharded_stop_source* __source) noexcept
+      : __source_(__source) {
+    }
+
+    const sharded_stop_source* __source_ = nullptr;
+  };
+
+  inline auto sharded_stop_source::get_token() const noexcept -> sharded_stop_token {
+    return sharded_stop_token{this};
+  }
+
+  //! The stop callback type of a sharded_stop_token.
+  template <class _Fun>
+  class sharded_stop_callback : __sharded_stop::__callback_base {
+   public:
+    template <class _Fun2>
+      requires stdexec::constructible_from<_Fun, _Fun2>
+    explicit sharded_stop_callback(sharded_stop_token __token, _Fun2&& __fun)
+      noexcept(stdexec::__nothrow_constructible_from<_Fun, _Fun2>)
+      : __sharded_stop::__callback_base(__token.__source_, &sharded_stop_callback::__execute_impl_)
+      , __fun_(static_cast<_Fun2&&>(__fun)) {
+      __register_callback_();
+    }
+
+    ~sharded_stop_callback() {
+      if (__source_ != nullptr)
+        __source_->__remove_callback_(this);
+    }
+
+   private:
+    static void __execute_impl_(__sharded_stop::__callback_base* __cb) noexcept {
+      std::move(static_cast<sharded_stop_callback*>(__cb)->__fun_)();
+    }
+
+    STDEXEC_ATTRIBUTE(no_unique_address) _Fun __fun_;
+  };
+
+  namespace __sharded_stop {
+    inline void __callback_base::__register_callback_() noexcept {
+      if (__source_ != nullptr) {
+        if (!__source_->__try_add_callback_(this)) {
+          __source_ = nullptr;
+          // Callback not registered because stop_requested() was true.
+          // Execute inline here.
+          __execute();
+        }
+      }
+    }
+  } // namespace __sharded_stop
+
+  inline sharded_stop_source::~sharded_stop_source() {
+    for ([[maybe_unused]] __shard& __s: __shards_) {
+      STDEXEC_ASSERT(!__s.__locked_.load(std::memory_order_relaxed));
+      STDEXEC_ASSERT(__s.__callbacks_ == nullptr);
+    }
+  }
+
+  inline auto sharded_stop_source::request_stop() noexcept -> bool {
+    if (__stop_requested_.exchange(true, std::memory_order_acq_rel)) {
+      return false;
+    }
+
+    __notifying_thread_ = std::this_thread::get_id();
+
+    // No callback can be added once the flag is set, so draining each shard once is enough.
+    for (__shard& __s: __shards_) {
+      __s.__lock();
+      while (__s.__callbacks_ != nullptr) {
+        auto* __callbk = __s.__callbacks_;
+        __callbk->__prev_ptr_ = nullptr;
+        __s.__callbacks_ = __callbk->__next_;
+        if (__s.__callbacks_ != nullptr)
+          __s.__callbacks_->__prev_ptr_ = &__s.__callbacks_;
+
+        __s.__unlock();
+
+        bool __removed_during_callback = false;
+        __callbk->__removed_during_callback_ = &__removed_during_callback;
+
+        __callbk->__execute();
+
+        if (!__removed_during_callback) {
+          __callbk->__removed_during_callback_ = nullptr;
+          __callbk->__callback_completed_.store(true, std::memory_order_release);
+        }
+
+        __s.__lock();
+      }
+      __s.__unlock();
+    }
+
+    return true;
+  }
+
+  inline auto sharded_stop_source::__try_add_callback_(
+    __sharded_stop::__callback_base* __callbk) const noexcept -> bool {
+    if (stop_requested()) {
+      return false;
+    }
+
+    __callbk->__shard_ = exec::__this_thread_index() % shard_count;
+    __shard& __s = __shards_[__callbk->__shard_];
+    __s.__lock();
+
+    // request_stop() sets the flag before it locks any shard, so either we see the flag here
+    // or it will find the callback when it drains this shard.
+    if (__stop_requested_.load(std::memory_order_relaxed)) {
+      __s.__unlock();
+      return false;
+    }
+
+    __callbk->__next_ = __s.__callbacks_;
+    __callbk->__prev_ptr_ = &__s.__callbacks_;
+    if (__s.__callbacks_ != nullptr) {
+      __s.__callbacks_->__prev_ptr_ = &__callbk->__next_;
+    }
+    __s.__callbacks_ = __callbk;
+
+    __s.__unlock();
+    return true;
+  }
+
+  inline void sharded_stop_source::__remove_callback_(
+    __sharded_stop::__callback_base* __callbk) const noexcept {
+    __shard& __s = __shards_[__callbk->__shard_];
+    __s.__lock();
+
+    if (__callbk->__prev_ptr_ != nullptr) {
+      // Callback has not been executed yet.
+      // Remove from the list.
+      *__callbk->__prev_ptr_ = __callbk->__next_;
+      if (__callbk->__next_ != nullptr) {
+        __callbk->__next_->__prev_ptr_ = __callbk->__prev_ptr_;
+      }
+      __s.__unlock();
+    } else {
+      auto __notifying_thread = __notifying_thread_;
+      __s.__unlock();
+
+      // Callback has either already been executed or is
+      // currently executing on another thread.
+      if (std::this_thread::get_id() == __notifying_thread) {
+        if (__callbk->__removed_during_callback_ != nullptr) {
+          *__callbk->__removed_during_callback_ = true;
+        }
+      } else {
+        // Concurrently executing on another thread.
+        // Wait until the other thread finishes executing the callback.
+        stdexec::__stok::__spin_wait __spin;
+        while (!__callbk->__callback_completed_.load(std::memory_order_acquire)) {
+          __spin.__wait();
+        }
+      }
+    }
+  }
+} // namespace exec
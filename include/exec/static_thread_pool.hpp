@@ -40,6 +40,7 @@
 #include <span>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace exec {
@@ -77,6 +78,10 @@ namespace exec {
       return std::make_pair(static_cast<Shape>(begin), static_cast<Shape>(end));
     }
 
+    // When a bulk operation can be stopped, each thread splits its share of the shape into this
+    // many chunks and checks for a stop request before starting each one.
+    inline constexpr std::size_t bulk_stop_check_chunks = 16;
+
 #if STDEXEC_HAS_STD_RANGES()
     namespace schedule_all_ {
       template <class Range>
@@ -164,6 +169,11 @@ namespace exec {
       }
     };
 
+    class fork_join_context;
+
+    template <class Fn>
+    class fork_join_child;
+
     class static_thread_pool_ {
       template <class ReceiverId>
       struct operation {
@@ -458,6 +468,11 @@ namespace exec {
         auto query(get_domain_t) const noexcept -> domain {
           return {};
         }
+
+        [[nodiscard]]
+        auto available_parallelism() const noexcept -> std::uint32_t {
+          return pool_->available_parallelism();
+        }
       };
 
       auto get_scheduler() noexcept -> scheduler {
@@ -490,7 +505,7 @@ namespace exec {
       void request_stop() noexcept;
 
       [[nodiscard]]
-      auto available_parallelism() const -> std::uint32_t {
+      auto available_parallelism() const noexcept -> std::uint32_t {
         return threadCount_;
       }
 
@@ -588,6 +603,11 @@ namespace exec {
         void push_local(task_base* task);
         void push_local(__intrusive_queue<&task_base::next>&& tasks);
 
+        // Non-blocking variants for fork_join_context, which must only be called from the
+        // thread that owns this state.
+        auto try_push_local(task_base* task) -> bool;
+        auto try_pop_or_steal() -> pop_result;
+
         auto notify() -> bool;
         void request_stop();
 
@@ -650,9 +670,14 @@ namespace exec {
         xorshift rng_{};
       };
 
+      friend fork_join_context;
+
       void run(std::uint32_t index) noexcept;
       void join() noexcept;
 
+      // The state of the worker thread running the calling code, if any.
+      static inline thread_local thread_state* current_thread_state_{nullptr};
+
       alignas(64) std::atomic<std::uint32_t> numActive_{};
       alignas(64) remote_queue_list remotes_;
       std::uint32_t threadCount_;
@@ -751,6 +776,7 @@ namespace exec {
       STDEXEC_ASSERT(threadIndex < threadCount_);
       // NOLINTNEXTLINE(bugprone-unused-return-value)
       numa_.bind_to_node(threadStates_[threadIndex]->numa_node());
+      current_thread_state_ = &*threadStates_[threadIndex];
       while (true) {
         // Make a blocking call to de-queue a task if we don't already have one.
         auto [task, queueIndex] = threadStates_[threadIndex]->pop();
@@ -969,6 +995,19 @@ namespace exec {
       pending_queue_.prepend(std::move(tasks));
     }
 
+    inline auto static_thread_pool_::thread_state::try_push_local(task_base* task) -> bool {
+      return local_queue_.push_back(task);
+    }
+
+    inline auto static_thread_pool_::thread_state::try_pop_or_steal()
+      -> static_thread_pool_::thread_state::pop_result {
+      pop_result result{.task = local_queue_.pop_back(), .queueIndex = index_};
+      if (result.task) {
+        return result;
+      }
+      return try_steal_any();
+    }
+
     inline void static_thread_pool_::thread_state::set_sleeping() {
       pool_->numActive_.fetch_sub(1u << 16u, std::memory_order_relaxed);
     }
@@ -1152,13 +1191,24 @@ namespace exec {
         __eptr_completion
       >;
 
+      // The bulk can be stopped early by a receiver whose stop token is stoppable.
+      template <class... Env>
+      using with_stopped_t = __if_c<
+        (unstoppable_token<stop_token_of_t<Env>> && ...),
+        completion_signatures<>,
+        completion_signatures<set_stopped_t()>
+      >;
+
       template <class... Tys>
       using set_value_t = completion_signatures<set_value_t(stdexec::__decay_t<Tys>...)>;
 
       template <class Self, class... Env>
       using __completions_t = stdexec::transform_completion_signatures<
         __completion_signatures_of_t<__copy_cvref_t<Self, Sender>, Env...>,
-        with_error_invoke_t<__copy_cvref_t<Self, Sender>, Env...>,
+        __concat_completion_signatures<
+          with_error_invoke_t<__copy_cvref_t<Self, Sender>, Env...>,
+          with_stopped_t<Env...>
+        >,
         set_value_t
       >;
 
@@ -1221,10 +1271,36 @@ namespace exec {
               // In the case that the shape is much larger than the total number of threads,
               // then each call to computation will call the function many times.
               auto [begin, end] = even_share(sh_state.shape_, tid, total_threads);
-              sh_state.fun_(begin, end, args...);
+              if constexpr (stoppable) {
+                // Split this thread's share into chunks and stop claiming them as soon as
+                // a stop is requested, or another thread has seen one.
+                auto stoken = stdexec::get_stop_token(stdexec::get_env(sh_state.rcvr_));
+                const Shape size = end - begin;
+                const auto chunks = static_cast<std::size_t>(
+                  (std::min) (size, static_cast<Shape>(bulk_stop_check_chunks)));
+                for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                  if (
+                    sh_state.stopped_.load(std::memory_order_relaxed)
+                    || stoken.stop_requested()) {
+                    sh_state.stopped_.store(true, std::memory_order_relaxed);
+                    break;
+                  }
+                  auto [first, last] = even_share(size, chunk, chunks);
+                  sh_state.fun_(
+                    static_cast<Shape>(begin + first), static_cast<Shape>(begin + last), args...);
+                }
+              } else {
+                sh_state.fun_(begin, end, args...);
+              }
             };
 
             auto completion = [&](auto&... args) {
+              if constexpr (stoppable) {
+                if (sh_state.stopped_.load(std::memory_order_relaxed)) {
+                  stdexec::set_stopped(static_cast<Receiver&&>(sh_state.rcvr_));
+                  return;
+                }
+              }
               stdexec::set_value(static_cast<Receiver&&>(sh_state.rcvr_), std::move(args)...);
             };
 
@@ -1273,6 +1349,11 @@ namespace exec {
         __q<__nullable_std_variant>
       >;
 
+      //! Whether the receiver can ask for the bulk to stop early. If so, the threads observe
+      //! its stop token between chunks of their share, and the operation completes with
+      //! `set_stopped` if any of them saw a stop request.
+      static constexpr bool stoppable = !unstoppable_token<stop_token_of_t<env_of_t<Receiver>>>;
+
       variant_t data_;
       static_thread_pool_& pool_;
       Receiver rcvr_;
@@ -1280,6 +1361,7 @@ namespace exec {
       Fun fun_;
 
       std::atomic<std::uint32_t> finished_threads_{0};
+      std::atomic<bool> stopped_{false};
       std::atomic<std::uint32_t> thread_with_exception_{0};
       std::exception_ptr exception_;
       std::vector<bulk_task> tasks_;
@@ -1368,6 +1450,13 @@ namespace exec {
           state.data_.template emplace<tuple_t>(static_cast<As&&>(as)...);
         }
 
+        if constexpr (shared_state::stoppable) {
+          if (stdexec::get_stop_token(stdexec::get_env(state.rcvr_)).stop_requested()) {
+            stdexec::set_stopped(static_cast<Receiver&&>(state.rcvr_));
+            return;
+          }
+        }
+
         if (state.shape_) {
           enqueue();
         } else {
@@ -1679,6 +1768,126 @@ namespace exec {
 
     struct schedule_all_t;
 #endif
+
+    // Structured fork-join for recursive, dynamically created work on a static_thread_pool:
+    //
+    // ```cpp
+    // void fib(exec::fork_join_context ctx, int n, long& result) {
+    //   if (n < 2) {
+    //     result = n;
+    //     return;
+    //   }
+    //   long a = 0, b = 0;
+    //   auto child = ctx.spawn_child([&](exec::fork_join_context c) { fib(c, n - 1, a); });
+    //   fib(ctx, n - 2, b);
+    //   ctx.sync(child);
+    //   result = a + b;
+    // }
+    // ```
+    //
+    // A child lives in the frame of the function that spawned it and is pushed to the local
+    // queue of the calling worker thread. Idle workers may steal it once the queue holds more
+    // than a block of tasks (see bwos_params::blockSize), so recursive algorithms expose their
+    // outermost, largest children to thieves first. sync() waits for a child by running tasks
+    // from the caller's own queue -- usually the child itself, which then runs inline -- or by
+    // stealing from other workers. Spawning and joining a child that is not stolen allocates
+    // nothing. Called on a thread outside of any pool, or when the local queue is full,
+    // spawn_child() runs the child inline.
+    class fork_join_context {
+     public:
+      // The context of the calling thread: that of the pool worker running it, if any.
+      static auto current() noexcept -> fork_join_context {
+        return fork_join_context{static_thread_pool_::current_thread_state_};
+      }
+
+      template <class Fn>
+        requires __callable<Fn&, fork_join_context>
+      [[nodiscard]]
+      auto spawn_child(Fn fn) const -> fork_join_child<Fn> {
+        return fork_join_child<Fn>{*this, static_cast<Fn&&>(fn)};
+      }
+
+      // Waits for `child` to complete and rethrows any exception that escaped it. Must be
+      // called on the thread that spawned `child`.
+      template <class Fn>
+      void sync(fork_join_child<Fn>& child) const;
+
+     private:
+      template <class>
+      friend class fork_join_child;
+
+      explicit fork_join_context(static_thread_pool_::thread_state* state) noexcept
+        : state_(state) {
+      }
+
+      static_thread_pool_::thread_state* state_;
+    };
+
+    template <class Fn>
+    class fork_join_child : task_base {
+     public:
+      fork_join_child(fork_join_child&&) = delete;
+
+      // A child that was not synced is joined here, and its exception, if any, is dropped.
+      ~fork_join_child() {
+        if (!joined_) {
+          STDEXEC_TRY {
+            owner_.sync(*this);
+          }
+          STDEXEC_CATCH_ALL {
+          }
+        }
+      }
+
+     private:
+      friend fork_join_context;
+
+      // Only reachable through spawn_child(), whose prvalue result is constructed in place, so
+      // the address pushed to the queue is the one the caller later syncs on.
+      fork_join_child(fork_join_context owner, Fn fn)
+        : fn_(static_cast<Fn&&>(fn))
+        , owner_(owner) {
+        this->__execute = &execute_;
+        if (owner_.state_ == nullptr || !owner_.state_->try_push_local(this)) {
+          execute_(this, 0);
+        }
+      }
+
+      static void execute_(task_base* task, std::uint32_t) noexcept {
+        auto& self = *static_cast<fork_join_child*>(task);
+        STDEXEC_TRY {
+          self.fn_(fork_join_context::current());
+        }
+        STDEXEC_CATCH_ALL {
+          self.exception_ = std::current_exception();
+        }
+        // The owner may destroy *this as soon as it observes this store.
+        self.done_.store(true, std::memory_order_release);
+      }
+
+      Fn fn_;
+      fork_join_context owner_;
+      std::exception_ptr exception_{};
+      std::atomic<bool> done_{false};
+      bool joined_{false};
+    };
+
+    template <class Fn>
+    void fork_join_context::sync(fork_join_child<Fn>& child) const {
+      STDEXEC_ASSERT(child.owner_.state_ == state_);
+      while (!child.done_.load(std::memory_order_acquire)) {
+        auto [task, queueIndex] = state_->try_pop_or_steal();
+        if (task) {
+          task->__execute(task, queueIndex);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      child.joined_ = true;
+      if (child.exception_) {
+        std::rethrow_exception(std::exchange(child.exception_, nullptr));
+      }
+    }
   } // namespace _pool_
 
   struct static_thread_pool : private _pool_::static_thread_pool_ {
@@ -1732,4 +1941,7 @@ namespace exec {
   inline constexpr _pool_::schedule_all_t schedule_all{};
 #endif
 
+  using _pool_::fork_join_context;
+  using _pool_::fork_join_child;
+
 } // namespace exec
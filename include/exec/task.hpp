@@ -17,7 +17,11 @@
 
 #include <any>
 #include <cassert>
+#include <cstddef>
 #include <exception>
+#include <memory>
+#include <new>
+#include <system_error>
 #include <utility>
 
 #include "../stdexec/execution.hpp"
@@ -25,6 +29,7 @@
 #include "../stdexec/__detail/__optional.hpp"
 #include "../stdexec/__detail/__variant.hpp"
 
+#include "__detail/__recycling_allocator.hpp"
 #include "any_sender_of.hpp"
 #include "at_coroutine_exit.hpp"
 #include "scope.hpp"
@@ -87,7 +92,10 @@ namespace exec {
       __sticky
     };
 
-    template <__scheduler_affinity _SchedulerAffinity = __scheduler_affinity::__sticky>
+    template <
+      __scheduler_affinity _SchedulerAffinity = __scheduler_affinity::__sticky,
+      class _FrameAllocator = std::allocator<std::byte>
+    >
     class __default_task_context_impl {
       template <class _ParentPromise>
       friend struct __default_awaiter_context;
@@ -99,6 +107,10 @@ namespace exec {
       inplace_stop_token __stop_token_;
 
      public:
+      // The allocator for the frames of coroutines that use this context, unless the coroutine
+      // is passed one explicitly with leading `std::allocator_arg, alloc` arguments.
+      using frame_allocator_type = _FrameAllocator;
+
       template <class _ParentPromise>
       explicit __default_task_context_impl(_ParentPromise& __parent) noexcept {
         if constexpr (_SchedulerAffinity == __scheduler_affinity::__sticky) {
@@ -155,9 +167,9 @@ namespace exec {
     // it does nothing.
     template <class _ParentPromise>
     struct __default_awaiter_context {
-      template <__scheduler_affinity _Affinity>
+      template <__scheduler_affinity _Affinity, class _Alloc>
       explicit __default_awaiter_context(
-        __default_task_context_impl<_Affinity>&,
+        __default_task_context_impl<_Affinity, _Alloc>&,
         _ParentPromise&) noexcept {
       }
     };
@@ -171,9 +183,9 @@ namespace exec {
       using __stop_token_t = stop_token_of_t<env_of_t<_ParentPromise>>;
       using __stop_callback_t = __stop_token_t::template callback_type<__forward_stop_request>;
 
-      template <__scheduler_affinity _Affinity>
+      template <__scheduler_affinity _Affinity, class _Alloc>
       explicit __default_awaiter_context(
-        __default_task_context_impl<_Affinity>& __self,
+        __default_task_context_impl<_Affinity, _Alloc>& __self,
         _ParentPromise& __parent) noexcept
         // Register a callback that will request stop on this basic_task's
         // stop_source when stop is requested on the parent coroutine's stop
@@ -198,9 +210,9 @@ namespace exec {
     template <__indirect_stop_token_provider _ParentPromise>
       requires std::same_as<inplace_stop_token, stop_token_of_t<env_of_t<_ParentPromise>>>
     struct __default_awaiter_context<_ParentPromise> {
-      template <__scheduler_affinity _Affinity>
+      template <__scheduler_affinity _Affinity, class _Alloc>
       explicit __default_awaiter_context(
-        __default_task_context_impl<_Affinity>& __self,
+        __default_task_context_impl<_Affinity, _Alloc>& __self,
         _ParentPromise& __parent) noexcept {
         __self.__stop_token_ = get_stop_token(get_env(__parent));
       }
@@ -211,9 +223,9 @@ namespace exec {
     template <__indirect_stop_token_provider _ParentPromise>
       requires unstoppable_token<stop_token_of_t<env_of_t<_ParentPromise>>>
     struct __default_awaiter_context<_ParentPromise> {
-      template <__scheduler_affinity _Affinity>
+      template <__scheduler_affinity _Affinity, class _Alloc>
       explicit __default_awaiter_context(
-        __default_task_context_impl<_Affinity>&,
+        __default_task_context_impl<_Affinity, _Alloc>&,
         _ParentPromise&) noexcept {
       }
     };
@@ -222,15 +234,19 @@ namespace exec {
     // worst and save a type-erased stop callback.
     template <>
     struct __default_awaiter_context<void> {
-      template <__scheduler_affinity _Affinity, class _ParentPromise>
+      template <__scheduler_affinity _Affinity, class _Alloc, class _ParentPromise>
       explicit __default_awaiter_context(
-        __default_task_context_impl<_Affinity>&,
+        __default_task_context_impl<_Affinity, _Alloc>&,
         _ParentPromise&) noexcept {
       }
 
-      template <__scheduler_affinity _Affinity, __indirect_stop_token_provider _ParentPromise>
+      template <
+        __scheduler_affinity _Affinity,
+        class _Alloc,
+        __indirect_stop_token_provider _ParentPromise
+      >
       explicit __default_awaiter_context(
-        __default_task_context_impl<_Affinity>& __self,
+        __default_task_context_impl<_Affinity, _Alloc>& __self,
         _ParentPromise& __parent) {
         // Register a callback that will request stop on this basic_task's
         // stop_source when stop is requested on the parent coroutine's stop
@@ -255,6 +271,84 @@ namespace exec {
     using awaiter_context_t =
       __decay_t<env_of_t<_Promise>>::template awaiter_context_t<_Promise, _ParentPromise>;
 
+    ////////////////////////////////////////////////////////////////////////////////
+    // Coroutine frame allocation. The frame is followed by a pointer to the function that
+    // frees it and by a copy of the allocator that it came from, so that the promise's
+    // operator delete can free frames whatever allocator they were allocated with.
+    struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) __frame_block {
+      unsigned char __data_[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+    };
+
+    using __frame_deallocate_fn = void(void*, std::size_t) noexcept;
+
+    constexpr auto __frame_round_up(std::size_t __size, std::size_t __align) noexcept
+      -> std::size_t {
+      return (__size + __align - 1) & ~(__align - 1);
+    }
+
+    constexpr auto __frame_trailer_offset(std::size_t __size) noexcept -> std::size_t {
+      return __frame_round_up(__size, alignof(__frame_deallocate_fn*));
+    }
+
+    template <class _Alloc>
+    struct __frame_allocation {
+      using __alloc_t = std::allocator_traits<_Alloc>::template rebind_alloc<__frame_block>;
+      using __traits_t = std::allocator_traits<__alloc_t>;
+
+      static_assert(alignof(__alloc_t) <= alignof(__frame_block));
+
+      static constexpr auto __alloc_offset(std::size_t __size) noexcept -> std::size_t {
+        return __frame_round_up(
+          __frame_trailer_offset(__size) + sizeof(__frame_deallocate_fn*), alignof(__alloc_t));
+      }
+
+      static constexpr auto __num_blocks(std::size_t __size) noexcept -> std::size_t {
+        return (__alloc_offset(__size) + sizeof(__alloc_t) + sizeof(__frame_block) - 1)
+             / sizeof(__frame_block);
+      }
+
+      static auto __allocate(std::size_t __size, const _Alloc& __alloc) -> void* {
+        __alloc_t __frame_alloc(__alloc);
+        void* __frame = __traits_t::allocate(__frame_alloc, __num_blocks(__size));
+        auto* __bytes = static_cast<unsigned char*>(__frame);
+        ::new (static_cast<void*>(__bytes + __frame_trailer_offset(__size)))
+          __frame_deallocate_fn*(&__deallocate);
+        ::new (static_cast<void*>(__bytes + __alloc_offset(__size)))
+          __alloc_t(static_cast<__alloc_t&&>(__frame_alloc));
+        return __frame;
+      }
+
+      static void __deallocate(void* __frame, std::size_t __size) noexcept {
+        auto* __bytes = static_cast<unsigned char*>(__frame);
+        auto* __stored =
+          std::launder(reinterpret_cast<__alloc_t*>(__bytes + __alloc_offset(__size)));
+        __alloc_t __frame_alloc(static_cast<__alloc_t&&>(*__stored));
+        std::destroy_at(__stored);
+        __traits_t::deallocate(
+          __frame_alloc, static_cast<__frame_block*>(__frame), __num_blocks(__size));
+      }
+    };
+
+    inline void __deallocate_frame(void* __frame, std::size_t __size) noexcept {
+      auto* __bytes = static_cast<unsigned char*>(__frame);
+      __frame_deallocate_fn* __deallocate = *std::launder(
+        reinterpret_cast<__frame_deallocate_fn**>(__bytes + __frame_trailer_offset(__size)));
+      __deallocate(__frame, __size);
+    }
+
+    template <class _Alloc>
+    concept __frame_allocator = requires(_Alloc& __alloc, std::size_t __n) {
+      typename _Alloc::value_type;
+      __alloc.allocate(__n);
+    };
+
+    template <class _Context>
+    using __frame_allocator_of_t = _Context::frame_allocator_type;
+
+    template <class _Context>
+    using __context_frame_allocator_t =
+      __meval_or<__frame_allocator_of_t, std::allocator<std::byte>, _Context>;
+
     ////////////////////////////////////////////////////////////////////////////////
     // In a base class so it can be specialized when _Ty is void:
     template <class _Ty>
@@ -290,12 +384,66 @@ namespace exec {
 
       [[nodiscard]]
       constexpr auto get_env() const noexcept {
-        return prop{get_completion_scheduler<set_value_t>, __sch_};
+        return env{
+          prop{get_completion_scheduler<set_value_t>, __sch_},
+          cprop<get_completion_behavior_t, completion_behavior::inline_completion>{}};
       }
 
       _Sch __sch_;
     };
 
+    template <class _Context>
+    inline constexpr bool __is_sticky_context = false;
+
+    template <class _FrameAllocator>
+    inline constexpr bool __is_sticky_context<
+      __default_task_context_impl<__scheduler_affinity::__sticky, _FrameAllocator>
+    > = true;
+
+    // Whether a sender's _Tag completions, if it has any, are known to happen on __sched.
+    template <class _Tag, class _Sender, class _Env, class _Scheduler>
+    auto __completes_on(const _Sender& __sndr, const _Scheduler& __sched) -> bool {
+      if constexpr (!__sends<_Tag, _Sender, _Env>) {
+        return true;
+      } else if constexpr (__callable<get_completion_scheduler_t<_Tag>, env_of_t<_Sender>>) {
+        auto&& __their_sched = get_completion_scheduler<_Tag>(stdexec::get_env(__sndr));
+        if constexpr (__same_as<__decay_t<decltype(__their_sched)>, _Scheduler>) {
+          return __their_sched == __sched;
+        } else if constexpr (
+          __same_as<_Scheduler, __any_scheduler>
+          && constructible_from<__any_scheduler, decltype(__their_sched)>) {
+          return __sched == __any_scheduler(__their_sched);
+        } else {
+          return false;
+        }
+      } else {
+        return false;
+      }
+    }
+
+    template <class _Sender, class _Env, class _Scheduler>
+    auto __completes_on_all(const _Sender& __sndr, const _Scheduler& __sched) -> bool {
+      return __task::__completes_on<set_value_t, _Sender, _Env>(__sndr, __sched)
+          && __task::__completes_on<set_error_t, _Sender, _Env>(__sndr, __sched)
+          && __task::__completes_on<set_stopped_t, _Sender, _Env>(__sndr, __sched);
+    }
+
+    // Calls an awaiter's await_suspend and maps its result onto a handle to transfer to.
+    template <class _Awaiter, class _Promise>
+    auto __await_suspend(_Awaiter& __awaiter, __coro::coroutine_handle<_Promise> __h)
+      -> __coro::coroutine_handle<> {
+      using __result_t = decltype(__awaiter.await_suspend(__h));
+      if constexpr (__same_as<__result_t, void>) {
+        __awaiter.await_suspend(__h);
+        return __coro::noop_coroutine();
+      } else if constexpr (__same_as<__result_t, bool>) {
+        return __awaiter.await_suspend(__h) ? __coro::noop_coroutine()
+                                            : __coro::coroutine_handle<>(__h);
+      } else {
+        return __awaiter.await_suspend(__h);
+      }
+    }
+
     enum class disposition : unsigned {
       stopped,
       succeeded,
@@ -353,11 +501,165 @@ namespace exec {
 
       using __promise_context_t = _Context::template promise_context_t<__promise>;
 
+      // Awaits a sender that completes inline, within start(). The sender is started from
+      // await_ready, so the coroutine does not suspend unless the sender is stopped, and
+      // a loop of such awaits does not nest a stack frame per iteration.
+      template <class _Sender>
+      struct __inline_awaitable
+        : __as_awaitable::__sender_awaitable_base<__as_awaitable::__value_t<_Sender, __promise>> {
+        using __value_t = __as_awaitable::__value_t<_Sender, __promise>;
+        using __result_t = __as_awaitable::__expected_t<__value_t>;
+
+        struct __receiver {
+          using receiver_concept = receiver_t;
+
+          template <class... _Us>
+            requires constructible_from<__as_awaitable::__value_or_void_t<__value_t>, _Us...>
+          void set_value(_Us&&... __us) noexcept {
+            STDEXEC_TRY {
+              __result_->template emplace<1>(static_cast<_Us&&>(__us)...);
+            }
+            STDEXEC_CATCH_ALL {
+              __result_->template emplace<2>(std::current_exception());
+            }
+          }
+
+          template <class _Error>
+          void set_error(_Error&& __err) noexcept {
+            if constexpr (__decays_to<_Error, std::exception_ptr>)
+              __result_->template emplace<2>(static_cast<_Error&&>(__err));
+            else if constexpr (__decays_to<_Error, std::error_code>)
+              __result_->template emplace<2>(std::make_exception_ptr(std::system_error(__err)));
+            else
+              __result_->template emplace<2>(std::make_exception_ptr(static_cast<_Error&&>(__err)));
+          }
+
+          // Leaves the result empty, which await_ready reports by suspending.
+          void set_stopped() noexcept {
+          }
+
+          auto get_env() const noexcept -> env_of_t<__promise&> {
+            return stdexec::get_env(*__promise_);
+          }
+
+          __result_t* __result_;
+          __promise* __promise_;
+        };
+
+        __inline_awaitable(_Sender&& __sndr, __promise& __self)
+          noexcept(__nothrow_connectable<_Sender, __receiver>)
+          : __op_(connect(static_cast<_Sender&&>(__sndr), __receiver{&this->__result_, &__self})) {
+        }
+
+        auto await_ready() noexcept -> bool {
+          stdexec::start(__op_);
+          return this->__result_.index() != 0;
+        }
+
+        static auto await_suspend(__coro::coroutine_handle<__promise> __h) noexcept
+          -> __coro::coroutine_handle<> {
+          return __h.promise().unhandled_stopped();
+        }
+
+        connect_result_t<_Sender, __receiver> __op_;
+      };
+
+      template <class _Sender>
+      using __direct_awaitable_t = __call_result_t<as_awaitable_t, _Sender, __promise&>;
+
+      template <class _Sender>
+      using __hop_awaitable_t = __call_result_t<
+        as_awaitable_t,
+        __call_result_t<continues_on_t, _Sender, __scheduler_t>,
+        __promise&
+      >;
+
+      template <class _Sender>
+      static constexpr bool __can_elide_hop_at_runtime = requires {
+        requires __same_as<__direct_awaitable_t<_Sender>, __decay_t<__direct_awaitable_t<_Sender>>>;
+        requires __same_as<__hop_awaitable_t<_Sender>, __decay_t<__hop_awaitable_t<_Sender>>>;
+        requires __same_as<
+          decltype(__declval<__direct_awaitable_t<_Sender>&>().await_resume()),
+          decltype(__declval<__hop_awaitable_t<_Sender>&>().await_resume())
+        >;
+      };
+
+      // Awaits a sender that may or may not complete on the task's scheduler. The hop back
+      // onto the scheduler is only added when the sender's completion schedulers do not say
+      // that it completes there already.
+      template <class _Sender>
+      struct __affine_awaitable {
+        __affine_awaitable(_Sender&& __sndr, __promise& __self) noexcept {
+          auto&& __sched = get_scheduler(*__self.__context_);
+          if (__task::__completes_on_all<_Sender, env_of_t<__promise&>>(__sndr, __sched)) {
+            __awaitable_.template emplace_from_at<0>(
+              stdexec::as_awaitable, static_cast<_Sender&&>(__sndr), __self);
+          } else {
+            __awaitable_.template emplace_from_at<1>([&] {
+              return stdexec::as_awaitable(
+                continues_on(static_cast<_Sender&&>(__sndr), __sched), __self);
+            });
+          }
+        }
+
+        auto await_ready() noexcept -> bool {
+          return __awaitable_.index() == 0 ? __awaitable_.template get<0>().await_ready()
+                                           : __awaitable_.template get<1>().await_ready();
+        }
+
+        auto await_suspend(__coro::coroutine_handle<__promise> __h) noexcept
+          -> __coro::coroutine_handle<> {
+          return __awaitable_.index() == 0
+                 ? __task::__await_suspend(__awaitable_.template get<0>(), __h)
+                 : __task::__await_suspend(__awaitable_.template get<1>(), __h);
+        }
+
+        auto await_resume() -> decltype(auto) {
+          if (__awaitable_.index() == 0) {
+            return __awaitable_.template get<0>().await_resume();
+          }
+          return __awaitable_.template get<1>().await_resume();
+        }
+
+        __variant_for<__direct_awaitable_t<_Sender>, __hop_awaitable_t<_Sender>> __awaitable_;
+      };
+
       struct __promise
         : __promise_base<_Ty>
         , with_awaitable_senders<__promise> {
         using __t = __promise;
         using __id = __promise;
+        using __frame_allocator_t = __context_frame_allocator_t<_Context>;
+
+        static auto operator new(std::size_t __size) -> void* {
+          return __frame_allocation<__frame_allocator_t>::__allocate(
+            __size, __frame_allocator_t());
+        }
+
+        // For coroutines called as `fn(std::allocator_arg, alloc, args...)`:
+        template <__frame_allocator _Alloc, class... _Args>
+        static auto operator new(
+          std::size_t __size,
+          std::allocator_arg_t,
+          const _Alloc& __alloc,
+          const _Args&...) -> void* {
+          return __frame_allocation<_Alloc>::__allocate(__size, __alloc);
+        }
+
+        // For member function coroutines called as `obj.fn(std::allocator_arg, alloc, args...)`:
+        template <class _This, __frame_allocator _Alloc, class... _Args>
+        static auto operator new(
+          std::size_t __size,
+          const _This&,
+          std::allocator_arg_t,
+          const _Alloc& __alloc,
+          const _Args&...) -> void* {
+          return __frame_allocation<_Alloc>::__allocate(__size, __alloc);
+        }
+
+        static void operator delete(void* __frame, std::size_t __size) noexcept {
+          __task::__deallocate_frame(__frame, __size);
+        }
 
         auto get_return_object() noexcept -> basic_task {
           return basic_task(__coro::coroutine_handle<__promise>::from_promise(*this));
@@ -391,11 +693,25 @@ namespace exec {
         template <sender _Awaitable>
           requires __scheduler_provider<_Context>
         auto await_transform(_Awaitable&& __awaitable) noexcept -> decltype(auto) {
-          // TODO: If we have a complete-where-it-starts query then we can optimize
-          // this to avoid the reschedule
-          return stdexec::as_awaitable(
-            continues_on(static_cast<_Awaitable&&>(__awaitable), get_scheduler(*__context_)),
-            *this);
+          if constexpr (
+            (__completes_inline<env_of_t<_Awaitable>>
+             || __completes_inline<env_of_t<_Awaitable>, env_of_t<__promise&>>)
+            && sender_to<_Awaitable, typename __inline_awaitable<_Awaitable>::__receiver>) {
+            // The sender completes within start() on this thread, which is on this task's
+            // scheduler.
+            return __inline_awaitable<_Awaitable>{static_cast<_Awaitable&&>(__awaitable), *this};
+          } else if constexpr (
+            __is_scheduler_affine<_Awaitable>
+            || __is_scheduler_affine<_Awaitable, env_of_t<__promise&>>) {
+            // The sender completes where it started, which is on this task's scheduler.
+            return stdexec::as_awaitable(static_cast<_Awaitable&&>(__awaitable), *this);
+          } else if constexpr (__can_elide_hop_at_runtime<_Awaitable>) {
+            return __affine_awaitable<_Awaitable>{static_cast<_Awaitable&&>(__awaitable), *this};
+          } else {
+            return stdexec::as_awaitable(
+              continues_on(static_cast<_Awaitable&&>(__awaitable), get_scheduler(*__context_)),
+              *this);
+          }
         }
 
         template <class _Scheduler>
@@ -474,7 +790,20 @@ namespace exec {
         }
       };
 
+      // A task whose context keeps it on its scheduler completes on the scheduler it was
+      // started on, so awaiting it from another such task needs no hop back.
+      struct __attrs {
+        static constexpr auto query(__is_scheduler_affine_t) noexcept -> bool {
+          return __is_sticky_context<_Context>;
+        }
+      };
+
      public:
+      [[nodiscard]]
+      auto get_env() const noexcept -> __attrs {
+        return {};
+      }
+
       // Make this task awaitable within a particular context:
       template <class _ParentPromise>
         requires constructible_from<
@@ -515,6 +844,22 @@ namespace exec {
   template <class _Ty>
   using task = basic_task<_Ty, default_task_context<_Ty>>;
 
+  //! The allocator of `recycling_task` frames. Frames are freed soon after they are allocated
+  //! and mostly on the thread that allocated them, which is what `recycling_allocator` suits.
+  template <class _Ty>
+  using recycling_frame_allocator = recycling_allocator<_Ty>;
+
+  //! A task context like `default_task_context<_Ty>` whose coroutines allocate their frames
+  //! with `_FrameAllocator`.
+  template <class _Ty, class _FrameAllocator>
+  using allocator_task_context =
+    __task::__default_task_context_impl<__task::__scheduler_affinity::__sticky, _FrameAllocator>;
+
+  //! A task whose frames come from the per-thread cache of `recycling_frame_allocator`.
+  template <class _Ty>
+  using recycling_task =
+    basic_task<_Ty, allocator_task_context<_Ty, recycling_frame_allocator<std::byte>>>;
+
   inline constexpr __task::__reschedule_coroutine_on reschedule_coroutine_on{};
 } // namespace exec
 
@@ -0,0 +1,473 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+#include "../stdexec/stop_token.hpp"
+#include "../stdexec/__detail/__optional.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <vector>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // exec::when_all_range(range-of-senders)
+  //
+  // Like stdexec::when_all, but over a number of senders that is only known at runtime. All
+  // senders in the range have the same type and complete with at most one value. The result is
+  // a std::vector holding the value of each sender in range order (or nothing, if the senders
+  // complete with set_value()). The first error or stop request cancels the remaining senders.
+  //
+  // The child operation states are connected into a single block obtained from the receiver's
+  // allocator when the when_all_range sender is connected.
+  namespace __when_all_range {
+    using namespace stdexec;
+
+    enum __state_t {
+      __started,
+      __error,
+      __stopped
+    };
+
+    struct __on_stop_requested {
+      inplace_stop_source& __stop_source_;
+
+      void operator()() noexcept {
+        __stop_source_.request_stop();
+      }
+    };
+
+    template <class _Env>
+    using __env_t = __join_env_t<prop<get_stop_token_t, inplace_stop_token>, _Env>;
+
+    template <class _Receiver>
+    auto __get_allocator(const _Receiver& __rcvr) noexcept {
+      if constexpr (__callable<get_allocator_t, env_of_t<_Receiver>>) {
+        return stdexec::get_allocator(stdexec::get_env(__rcvr));
+      } else {
+        return std::allocator<char>{};
+      }
+    }
+
+    // Maps zero or one types to that type, decayed, or to void.
+    template <class... _Ts>
+    struct __single_or_void;
+
+    template <>
+    struct __single_or_void<> {
+      using __t = void;
+    };
+
+    template <class _Ty>
+    struct __single_or_void<_Ty> {
+      using __t = __decay_t<_Ty>;
+    };
+
+    template <class... _Ts>
+    using __single_or_void_t = stdexec::__t<__single_or_void<_Ts...>>;
+
+    // The type that each child sends, or void.
+    template <class _CvrefSender, class _Env>
+    using __value_t = __value_types_of_t<
+      _CvrefSender,
+      __env_t<_Env>,
+      __q<__single_or_void_t>,
+      __q<__single_or_void_t>
+    >;
+
+    template <class _Value>
+    using __set_value_t = __if_c<
+      __same_as<_Value, void>,
+      completion_signatures<set_value_t()>,
+      completion_signatures<set_value_t(std::vector<_Value>)>
+    >;
+
+    template <class _Error>
+    using __set_error_t = completion_signatures<set_error_t(__decay_t<_Error>)>;
+
+    template <class _CvrefSender, class _Env>
+    using __completions_t = __concat_completion_signatures<
+      __set_value_t<__value_t<_CvrefSender, _Env>>,
+      completion_signatures<set_error_t(std::exception_ptr), set_stopped_t()>,
+      __transform_completion_signatures<
+        __completion_signatures_of_t<_CvrefSender, __env_t<_Env>>,
+        __mconst<completion_signatures<>>::__f,
+        __set_error_t,
+        completion_signatures<>,
+        __concat_completion_signatures
+      >
+    >;
+
+    template <class _CvrefSender, class _Env>
+    using __errors_variant_t = __minvoke<
+      __mconcat<__q<__uniqued_variant_for>>,
+      __types<std::exception_ptr>,
+      __error_types_of_t<_CvrefSender, __env_t<_Env>, __mtransform<__q<__decay_t>, __q<__types>>>
+    >;
+
+    // Where the values of the children go. A default-initializable value is written straight
+    // into its slot in the result vector, which is sized when the operation is connected.
+    // Otherwise each value is held in an optional and the result vector is built from them
+    // once every child has succeeded.
+    template <class _Value>
+    struct __values {
+      using __result_t = std::vector<_Value>;
+
+      explicit __values(std::size_t __size)
+        : __values_(__size) {
+      }
+
+      template <class... _Args>
+      static constexpr bool __nothrow_emplace =
+        __nothrow_constructible_from<_Value, _Args...>
+        && (!std::default_initializable<_Value> || std::is_nothrow_move_assignable_v<_Value>);
+
+      template <class... _Args>
+      void __emplace(std::size_t __index, _Args&&... __args) noexcept(__nothrow_emplace<_Args...>) {
+        if constexpr (std::default_initializable<_Value>) {
+          __values_[__index] = _Value(static_cast<_Args&&>(__args)...);
+        } else {
+          __values_[__index].emplace(static_cast<_Args&&>(__args)...);
+        }
+      }
+
+      auto __result() -> __result_t {
+        if constexpr (std::default_initializable<_Value>) {
+          return static_cast<__result_t&&>(__values_);
+        } else {
+          __result_t __result;
+          __result.reserve(__values_.size());
+          for (auto& __value: __values_) {
+            __result.push_back(static_cast<_Value&&>(*__value));
+          }
+          return __result;
+        }
+      }
+
+      static constexpr bool __nothrow_result = std::default_initializable<_Value>;
+
+      __if_c<std::default_initializable<_Value>, __result_t, std::vector<__optional<_Value>>>
+        __values_;
+    };
+
+    template <>
+    struct __values<void> {
+      explicit __values(std::size_t) noexcept {
+      }
+
+      template <class... _Args>
+      static constexpr bool __nothrow_emplace = true;
+
+      static void __emplace(std::size_t) noexcept {
+      }
+    };
+
+    template <class _Receiver, class _Value, class _ErrorsVariant>
+    struct __op_base : __immovable {
+      __op_base(_Receiver&& __rcvr, std::size_t __size)
+        : __count_{__size}
+        , __rcvr_{static_cast<_Receiver&&>(__rcvr)}
+        , __values_{__size} {
+      }
+
+      using __on_stop =
+        stop_callback_for_t<stop_token_of_t<env_of_t<_Receiver>&>, __on_stop_requested>;
+
+      template <class _Error>
+      void __set_error(_Error&& __err) noexcept {
+        // Only the first error is kept. It wins over a prior stop.
+        __state_t __prior = __state_.exchange(__error, std::memory_order_relaxed);
+        if (__prior == __error) {
+          return;
+        }
+        if constexpr (__nothrow_decay_copyable<_Error>) {
+          __errors_.template emplace<__decay_t<_Error>>(static_cast<_Error&&>(__err));
+        } else {
+          STDEXEC_TRY {
+            __errors_.template emplace<__decay_t<_Error>>(static_cast<_Error&&>(__err));
+          }
+          STDEXEC_CATCH_ALL {
+            __errors_.template emplace<std::exception_ptr>(std::current_exception());
+          }
+        }
+        if (__prior == __started) {
+          __stop_source_.request_stop();
+        }
+      }
+
+      void __set_stopped() noexcept {
+        __state_t __expected = __started;
+        if (__state_.compare_exchange_strong(__expected, __stopped, std::memory_order_relaxed)) {
+          __stop_source_.request_stop();
+        }
+      }
+
+      template <class... _Args>
+      void __set_value(std::size_t __index, _Args&&... __args) noexcept {
+        if (__state_.load(std::memory_order_relaxed) != __started) {
+          return;
+        }
+        if constexpr (__values<_Value>::template __nothrow_emplace<_Args...>) {
+          __values_.__emplace(__index, static_cast<_Args&&>(__args)...);
+        } else {
+          STDEXEC_TRY {
+            __values_.__emplace(__index, static_cast<_Args&&>(__args)...);
+          }
+          STDEXEC_CATCH_ALL {
+            __set_error(std::current_exception());
+          }
+        }
+      }
+
+      // Each child arrives exactly once. The release sequence on __count_ makes the values and
+      // the error stored by the children visible to whichever child arrives last.
+      void __arrive() noexcept {
+        if (__count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          __complete();
+        }
+      }
+
+      void __complete() noexcept {
+        __on_stop_.reset();
+        switch (__state_.load(std::memory_order_relaxed)) {
+        case __started:
+          if constexpr (__same_as<_Value, void>) {
+            stdexec::set_value(static_cast<_Receiver&&>(__rcvr_));
+          } else if constexpr (__values<_Value>::__nothrow_result) {
+            stdexec::set_value(static_cast<_Receiver&&>(__rcvr_), __values_.__result());
+          } else {
+            STDEXEC_TRY {
+              stdexec::set_value(static_cast<_Receiver&&>(__rcvr_), __values_.__result());
+            }
+            STDEXEC_CATCH_ALL {
+              stdexec::set_error(static_cast<_Receiver&&>(__rcvr_), std::current_exception());
+            }
+          }
+          break;
+        case __error:
+          __errors_.visit(
+            [this]<class _Error>(_Error&& __err) noexcept {
+              stdexec::set_error(static_cast<_Receiver&&>(__rcvr_), static_cast<_Error&&>(__err));
+            },
+            static_cast<_ErrorsVariant&&>(__errors_));
+          break;
+        case __stopped:
+          stdexec::set_stopped(static_cast<_Receiver&&>(__rcvr_));
+          break;
+        }
+      }
+
+      std::atomic<std::size_t> __count_;
+      std::atomic<__state_t> __state_{__started};
+      inplace_stop_source __stop_source_{};
+      __optional<__on_stop> __on_stop_{};
+      _Receiver __rcvr_;
+      STDEXEC_ATTRIBUTE(no_unique_address) __values<_Value> __values_;
+      _ErrorsVariant __errors_{};
+    };
+
+    template <class _Receiver, class _Value, class _ErrorsVariant>
+    struct __receiver {
+      class __t {
+       public:
+        using receiver_concept = stdexec::receiver_t;
+        using __id = __receiver;
+
+        explicit __t(__op_base<_Receiver, _Value, _ErrorsVariant>* __op, std::size_t __index)
+          noexcept
+          : __op_{__op}
+          , __index_{__index} {
+        }
+
+        auto get_env() const noexcept -> __env_t<env_of_t<_Receiver>> {
+          auto __token = prop{get_stop_token, __op_->__stop_source_.get_token()};
+          return __env::__join(std::move(__token), stdexec::get_env(__op_->__rcvr_));
+        }
+
+        template <class... _Args>
+        void set_value(_Args&&... __args) noexcept {
+          __op_->__set_value(__index_, static_cast<_Args&&>(__args)...);
+          __op_->__arrive();
+        }
+
+        template <class _Error>
+        void set_error(_Error&& __err) noexcept {
+          __op_->__set_error(static_cast<_Error&&>(__err));
+          __op_->__arrive();
+        }
+
+        void set_stopped() noexcept {
+          __op_->__set_stopped();
+          __op_->__arrive();
+        }
+
+       private:
+        __op_base<_Receiver, _Value, _ErrorsVariant>* __op_;
+        std::size_t __index_;
+      };
+    };
+
+    template <class _CvrefRangeId, class _ReceiverId>
+    struct __op {
+      using _CvrefRange = __cvref_t<_CvrefRangeId>;
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using _CvrefSender = __copy_cvref_t<_CvrefRange, std::ranges::range_value_t<_CvrefRange>>;
+      using _Value = __value_t<_CvrefSender, env_of_t<_Receiver>>;
+      using _ErrorsVariant = __errors_variant_t<_CvrefSender, env_of_t<_Receiver>>;
+      using __op_base_t = __op_base<_Receiver, _Value, _ErrorsVariant>;
+      using __receiver_t = stdexec::__t<__receiver<_Receiver, _Value, _ErrorsVariant>>;
+      using __child_op_t = connect_result_t<_CvrefSender, __receiver_t>;
+      using __allocator_t = std::allocator_traits<
+        decltype(__when_all_range::__get_allocator(__declval<const _Receiver&>()))
+      >::template rebind_alloc<__child_op_t>;
+      using __alloc_traits = std::allocator_traits<__allocator_t>;
+
+      class __t : __op_base_t {
+       public:
+        using __id = __op;
+
+        __t(_CvrefRange&& __range, _Receiver&& __rcvr)
+          : __op_base_t{
+              static_cast<_Receiver&&>(__rcvr),
+              static_cast<std::size_t>(std::ranges::distance(__range))}
+          , __allocator_(__when_all_range::__get_allocator(this->__rcvr_))
+          , __size_(this->__count_.load(std::memory_order_relaxed)) {
+          if (__size_ == 0) {
+            return;
+          }
+          __child_ops_ = __alloc_traits::allocate(__allocator_, __size_);
+          std::size_t __index = 0;
+          STDEXEC_TRY {
+            for (auto&& __sndr: __range) {
+              ::new (static_cast<void*>(__child_ops_ + __index)) __child_op_t(__emplace_from{[&] {
+                return stdexec::connect(
+                  static_cast<_CvrefSender&&>(__sndr), __receiver_t{this, __index});
+              }});
+              ++__index;
+            }
+          }
+          STDEXEC_CATCH_ALL {
+            __destroy(__index);
+            STDEXEC_THROW();
+          }
+        }
+
+        __t(__t&&) = delete;
+
+        ~__t() {
+          __destroy(__size_);
+        }
+
+        void start() & noexcept {
+          this->__on_stop_.emplace(
+            get_stop_token(stdexec::get_env(this->__rcvr_)),
+            __on_stop_requested{this->__stop_source_});
+          if (this->__stop_source_.stop_requested()) {
+            this->__on_stop_.reset();
+            stdexec::set_stopped(static_cast<_Receiver&&>(this->__rcvr_));
+          } else if (__size_ == 0) {
+            this->__complete();
+          } else {
+            for (std::size_t __i = 0; __i < __size_; ++__i) {
+              stdexec::start(__child_ops_[__i]);
+            }
+          }
+        }
+
+       private:
+        void __destroy(std::size_t __constructed) noexcept {
+          if (__child_ops_ == nullptr) {
+            return;
+          }
+          for (std::size_t __i = 0; __i < __constructed; ++__i) {
+            std::destroy_at(__child_ops_ + __i);
+          }
+          __alloc_traits::deallocate(__allocator_, __child_ops_, __size_);
+          __child_ops_ = nullptr;
+        }
+
+        __allocator_t __allocator_;
+        std::size_t __size_;
+        __child_op_t* __child_ops_{nullptr};
+      };
+    };
+
+    template <class _Range>
+    concept __range_of_senders = std::ranges::forward_range<_Range>
+                              && sender<std::ranges::range_value_t<_Range>>;
+
+    template <class _RangeId>
+    struct __sender {
+      using _Range = stdexec::__t<_RangeId>;
+
+      template <class _Self, class _Receiver>
+      using __op_t = stdexec::__t<__op<__copy_cvref_t<_Self, _RangeId>, __id<_Receiver>>>;
+
+      template <class _Self, class _Env>
+      using __completions_t = __when_all_range::__completions_t<
+        __copy_cvref_t<_Self, std::ranges::range_value_t<_Range>>,
+        _Env
+      >;
+
+      class __t {
+       public:
+        using __id = __sender;
+        using sender_concept = stdexec::sender_t;
+
+        template <__not_decays_to<__t> _CvrefRange>
+        explicit __t(_CvrefRange&& __range) noexcept(__nothrow_decay_copyable<_CvrefRange>)
+          : __range_{static_cast<_CvrefRange&&>(__range)} {
+        }
+
+        template <__decays_to<__t> _Self, receiver _Receiver>
+          requires receiver_of<_Receiver, __completions_t<_Self, env_of_t<_Receiver>>>
+        static auto connect(_Self&& __self, _Receiver __rcvr) -> __op_t<_Self, _Receiver> {
+          return __op_t<_Self, _Receiver>{
+            static_cast<_Self&&>(__self).__range_, static_cast<_Receiver&&>(__rcvr)};
+        }
+
+        template <__decays_to<__t> _Self, class _Env>
+        static auto get_completion_signatures(_Self&&, _Env&&) noexcept
+          -> __completions_t<_Self, _Env> {
+          return {};
+        }
+
+       private:
+        _Range __range_;
+      };
+    };
+
+    struct when_all_range_t {
+      template <class _Range>
+      using __sender_t = stdexec::__t<__sender<__id<__decay_t<_Range>>>>;
+
+      template <__range_of_senders _Range>
+      auto operator()(_Range&& __range) const noexcept(__nothrow_decay_copyable<_Range>)
+        -> __sender_t<_Range> {
+        return __sender_t<_Range>(static_cast<_Range&&>(__range));
+      }
+    };
+  } // namespace __when_all_range
+
+  using __when_all_range::when_all_range_t;
+  inline constexpr when_all_range_t when_all_range{};
+} // namespace exec
@@ -0,0 +1,451 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+#include "../stdexec/stop_token.hpp"
+#include "../stdexec/__detail/__optional.hpp"
+#include "timed_scheduler.hpp"
+
+#include <atomic>
+#include <exception>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // get_deadline(env)
+  //
+  // The point in time by which the operation receiving `env` should have completed, if there
+  // is one. It is a forwarding query, so every operation nested in a with_deadline sees the
+  // deadline of the innermost with_deadline enclosing it.
+  namespace __deadline {
+    using namespace stdexec;
+
+    struct get_deadline_t : __query<get_deadline_t> {
+      using __query<get_deadline_t>::operator();
+
+      STDEXEC_ATTRIBUTE(nodiscard, always_inline, host, device)
+      static consteval auto query(forwarding_query_t) noexcept -> bool {
+        return true;
+      }
+    };
+  } // namespace __deadline
+
+  using __deadline::get_deadline_t;
+  inline constexpr get_deadline_t get_deadline{};
+
+  /////////////////////////////////////////////////////////////////////////////
+  // with_deadline(sndr, [sched,] deadline)
+  //
+  // Runs `sndr` with a stop token that is triggered when the timed scheduler `sched` -- by
+  // default the receiver's get_scheduler -- reaches `deadline`, or when the receiver's own
+  // stop token is triggered, and completes with whatever `sndr` completes with. The child's
+  // environment answers get_deadline with the deadline.
+  //
+  // Deadlines nest: if the receiver's environment already has a deadline that is no later
+  // than `deadline`, the operation inherits it and arms no timer, since the enclosing
+  // with_deadline's timer will stop the whole tree. So a request tree with nested deadlines
+  // arms one timer per distinct, earlier deadline rather than one per stage. Such a stage also
+  // hands its child the receiver's stop token when that is an inplace_stop_token, as it is
+  // under another with_deadline, so it registers no stop callback either.
+  namespace __deadline {
+    struct __from_env { };
+
+    struct __on_stop_requested {
+      inplace_stop_source& __stop_source_;
+
+      void operator()() noexcept {
+        __stop_source_.request_stop();
+      }
+    };
+
+    template <class _TimePoint>
+    using __child_props_t =
+      env<prop<get_stop_token_t, inplace_stop_token>, prop<get_deadline_t, _TimePoint>>;
+
+    template <class _TimePoint, class _Env>
+    using __env_t = __join_env_t<__child_props_t<_TimePoint>, _Env>;
+
+    template <class... _Ts>
+    using __nothrow_decay_copyable_t = __mbool<(__nothrow_decay_copyable<_Ts> && ...)>;
+
+    template <class... _Args>
+    using __as_rvalues = set_value_t (*)(__decay_t<_Args>...);
+
+    template <class... _Error>
+    using __as_error = set_error_t (*)(__decay_t<_Error>...);
+
+    // Results are stored, decay-copied, while the timer is being cancelled.
+    template <class _TimePoint, class... _Env>
+    struct __completions_fn {
+      template <class _CvrefSender>
+      using __f = __mtry_q<__concat_completion_signatures>::__f<
+        __eptr_completion_if_t<__value_types_t<
+          __completion_signatures_of_t<_CvrefSender, __env_t<_TimePoint, _Env>...>,
+          __qq<__nothrow_decay_copyable_t>,
+          __qq<__mand_t>
+        >>,
+        __transform_completion_signatures<
+          __completion_signatures_of_t<_CvrefSender, __env_t<_TimePoint, _Env>...>,
+          __as_rvalues,
+          __as_error,
+          set_stopped_t (*)(),
+          __completion_signature_ptrs
+        >
+      >;
+    };
+
+    template <class _CvrefSender, class _TimePoint, class _Env>
+    using __result_variant_t = __for_each_completion_signature<
+      __minvoke<__completions_fn<_TimePoint, _Env>, _CvrefSender>,
+      __decayed_tuple,
+      __uniqued_variant_for
+    >;
+
+    template <class _Sched, class _Env>
+    auto __timer_scheduler(const _Sched& __sched, const _Env& __env) noexcept {
+      if constexpr (same_as<_Sched, __from_env>) {
+        return get_scheduler(__env);
+      } else {
+        return __sched;
+      }
+    }
+
+    template <class _Sched, class _Env>
+    using __timer_scheduler_t =
+      decltype(__deadline::__timer_scheduler(__declval<const _Sched&>(), __declval<const _Env&>()));
+
+    template <class _Receiver, class _TimePoint, class _ResultVariant>
+    struct __op_base : __immovable {
+      using __parent_token_t = stop_token_of_t<env_of_t<_Receiver>>;
+      using __on_stop = stop_callback_for_t<__parent_token_t, __on_stop_requested>;
+
+      // Whether an operation without a timer can give its child the receiver's stop token.
+      static constexpr bool __forwards_parent_token = same_as<__parent_token_t, inplace_stop_token>;
+
+      __op_base(_Receiver&& __rcvr, _TimePoint __deadline)
+        : __rcvr_{static_cast<_Receiver&&>(__rcvr)}
+        , __deadline_{__deadline} {
+        if constexpr (__callable<get_deadline_t, env_of_t<_Receiver>>) {
+          using __parent_t = __decay_t<__call_result_t<get_deadline_t, env_of_t<_Receiver>>>;
+          if constexpr (same_as<__parent_t, _TimePoint>) {
+            _TimePoint __parent = get_deadline(stdexec::get_env(__rcvr_));
+            if (!(__deadline_ < __parent)) {
+              __deadline_ = __parent;
+              __armed_ = false;
+            }
+          }
+        }
+      }
+
+      auto __child_env() const noexcept -> __env_t<_TimePoint, env_of_t<_Receiver>> {
+        return __env::__join(
+          __child_props_t<_TimePoint>{
+            prop{get_stop_token, __child_stop_token()},
+            prop{get_deadline, __deadline_}},
+          stdexec::get_env(__rcvr_));
+      }
+
+      auto __child_stop_token() const noexcept -> inplace_stop_token {
+        if constexpr (__forwards_parent_token) {
+          if (!__armed_) {
+            return get_stop_token(stdexec::get_env(__rcvr_));
+          }
+        }
+        return __stop_source_.get_token();
+      }
+
+      // Stop requests from the receiver are relayed to __stop_source_, unless the child uses the
+      // receiver's stop token directly, or the receiver's token can never be triggered.
+      void __register_stop_callback() noexcept {
+        if constexpr (!unstoppable_token<__parent_token_t>) {
+          if (!__forwards_parent_token || __armed_) {
+            __on_stop_.emplace(
+              get_stop_token(stdexec::get_env(__rcvr_)), __on_stop_requested{__stop_source_});
+          }
+        }
+      }
+
+      template <class _Tag, class... _Args>
+      void __complete(_Tag, _Args&&... __args) noexcept {
+        if (!__armed_) {
+          // No timer to wait for: complete right away, with the decayed arguments that our
+          // completion signatures promise.
+          __on_stop_.reset();
+          if constexpr ((__nothrow_decay_copyable<_Args> && ...)) {
+            _Tag()(
+              static_cast<_Receiver&&>(__rcvr_), __decay_t<_Args>(static_cast<_Args&&>(__args))...);
+          } else {
+            STDEXEC_TRY {
+              _Tag()(
+                static_cast<_Receiver&&>(__rcvr_),
+                __decay_t<_Args>(static_cast<_Args&&>(__args))...);
+            }
+            STDEXEC_CATCH_ALL {
+              stdexec::set_error(static_cast<_Receiver&&>(__rcvr_), std::current_exception());
+            }
+          }
+          return;
+        }
+        using __result_t = __decayed_tuple<_Tag, _Args...>;
+        if constexpr ((__nothrow_decay_copyable<_Args> && ...)) {
+          __result_.template emplace<__result_t>(_Tag(), static_cast<_Args&&>(__args)...);
+        } else {
+          STDEXEC_TRY {
+            __result_.template emplace<__result_t>(_Tag(), static_cast<_Args&&>(__args)...);
+          }
+          STDEXEC_CATCH_ALL {
+            using __error_t = __tuple_for<set_error_t, std::exception_ptr>;
+            __result_.template emplace<__error_t>(set_error_t(), std::current_exception());
+          }
+        }
+        __timer_stop_source_.request_stop();
+        __arrive();
+      }
+
+      void __on_deadline() noexcept {
+        __stop_source_.request_stop();
+        __arrive();
+      }
+
+      // Called once by the child and once by the timer, if there is one. The last to arrive
+      // forwards the child's result.
+      void __arrive() noexcept {
+        if (__count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          __on_stop_.reset();
+          STDEXEC_ASSERT(!__result_.is_valueless());
+          __result_.visit(
+            [this]<class _Tuple>(_Tuple&& __result) noexcept {
+              __result.apply(
+                [this]<class... _As>(auto __tag, _As&... __args) noexcept {
+                  __tag(static_cast<_Receiver&&>(__rcvr_), static_cast<_As&&>(__args)...);
+                },
+                __result);
+            },
+            static_cast<_ResultVariant&&>(__result_));
+        }
+      }
+
+      _Receiver __rcvr_;
+      _TimePoint __deadline_;
+      bool __armed_{true};
+      std::atomic<int> __count_{2};
+      inplace_stop_source __stop_source_{};
+      inplace_stop_source __timer_stop_source_{};
+      __optional<__on_stop> __on_stop_{};
+      _ResultVariant __result_{};
+    };
+
+    template <class _Receiver, class _TimePoint, class _ResultVariant>
+    struct __receiver {
+      class __t {
+       public:
+        using receiver_concept = receiver_t;
+        using __id = __receiver;
+
+        explicit __t(__op_base<_Receiver, _TimePoint, _ResultVariant>* __op) noexcept
+          : __op_{__op} {
+        }
+
+        template <class... _Args>
+        void set_value(_Args&&... __args) noexcept {
+          __op_->__complete(set_value_t(), static_cast<_Args&&>(__args)...);
+        }
+
+        template <class _Error>
+        void set_error(_Error&& __err) noexcept {
+          __op_->__complete(set_error_t(), static_cast<_Error&&>(__err));
+        }
+
+        void set_stopped() noexcept {
+          __op_->__complete(set_stopped_t());
+        }
+
+        auto get_env() const noexcept -> __env_t<_TimePoint, env_of_t<_Receiver>> {
+          return __op_->__child_env();
+        }
+
+       private:
+        __op_base<_Receiver, _TimePoint, _ResultVariant>* __op_;
+      };
+    };
+
+    // The timer stops the child when the deadline is reached. Its own stop token is
+    // triggered when the child completes first. A timer that fails is treated as one that
+    // never fires.
+    template <class _Receiver, class _TimePoint, class _ResultVariant>
+    struct __timer_receiver {
+      class __t {
+       public:
+        using receiver_concept = receiver_t;
+        using __id = __timer_receiver;
+
+        explicit __t(__op_base<_Receiver, _TimePoint, _ResultVariant>* __op) noexcept
+          : __op_{__op} {
+        }
+
+        void set_value() noexcept {
+          __op_->__on_deadline();
+        }
+
+        template <class _Error>
+        void set_error(_Error&&) noexcept {
+          __op_->__arrive();
+        }
+
+        void set_stopped() noexcept {
+          __op_->__arrive();
+        }
+
+        auto get_env() const noexcept -> prop<get_stop_token_t, inplace_stop_token> {
+          return prop{get_stop_token, __op_->__timer_stop_source_.get_token()};
+        }
+
+       private:
+        __op_base<_Receiver, _TimePoint, _ResultVariant>* __op_;
+      };
+    };
+
+    template <class _CvrefSenderId, class _ReceiverId, class _TimePoint, class _Sched>
+    struct __op {
+      using _CvrefSender = __cvref_t<_CvrefSenderId>;
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __result_t = __result_variant_t<_CvrefSender, _TimePoint, env_of_t<_Receiver>>;
+      using __base_t = __op_base<_Receiver, _TimePoint, __result_t>;
+      using __receiver_t = stdexec::__t<__receiver<_Receiver, _TimePoint, __result_t>>;
+      using __timer_receiver_t = stdexec::__t<__timer_receiver<_Receiver, _TimePoint, __result_t>>;
+      using __timer_sender_t = __call_result_t<
+        schedule_at_t,
+        __timer_scheduler_t<_Sched, env_of_t<_Receiver>>,
+        const _TimePoint&
+      >;
+
+      class __t : __base_t {
+       public:
+        using __id = __op;
+
+        __t(_CvrefSender&& __sndr, _Receiver __rcvr, _TimePoint __deadline, const _Sched& __sched)
+          : __base_t{static_cast<_Receiver&&>(__rcvr), __deadline}
+          , __child_op_{stdexec::connect(static_cast<_CvrefSender&&>(__sndr), __receiver_t{this})} {
+          if (this->__armed_) {
+            __timer_op_.__emplace_from([&] {
+              auto __timer_sched =
+                __deadline::__timer_scheduler(__sched, stdexec::get_env(this->__rcvr_));
+              return stdexec::connect(
+                exec::schedule_at(__timer_sched, this->__deadline_), __timer_receiver_t{this});
+            });
+          } else {
+            this->__count_.store(1, std::memory_order_relaxed);
+          }
+        }
+
+        void start() & noexcept {
+          this->__register_stop_callback();
+          if (__timer_op_.has_value()) {
+            stdexec::start(*__timer_op_);
+          }
+          stdexec::start(__child_op_);
+        }
+
+       private:
+        connect_result_t<_CvrefSender, __receiver_t> __child_op_;
+        __optional<connect_result_t<__timer_sender_t, __timer_receiver_t>> __timer_op_{};
+      };
+    };
+
+    template <class _SenderId, class _TimePoint, class _Sched>
+    struct __sender {
+      using _Sender = stdexec::__t<_SenderId>;
+
+      template <class _Self, class _Receiver>
+      using __op_t =
+        stdexec::__t<__op<__cvref_id<_Self, _Sender>, __id<_Receiver>, _TimePoint, _Sched>>;
+
+      template <class _Self, class... _Env>
+      using __completions_t =
+        __minvoke<__completions_fn<_TimePoint, _Env...>, __copy_cvref_t<_Self, _Sender>>;
+
+      class __t {
+       public:
+        using __id = __sender;
+        using sender_concept = sender_t;
+
+        template <class _Sndr>
+        __t(_Sndr&& __sndr, _TimePoint __deadline, _Sched __sched)
+          : __sndr_{static_cast<_Sndr&&>(__sndr)}
+          , __deadline_{__deadline}
+          , __sched_{static_cast<_Sched&&>(__sched)} {
+        }
+
+        template <__decays_to<__t> _Self, receiver _Receiver>
+          requires __timed_scheduler<__timer_scheduler_t<_Sched, env_of_t<_Receiver>>>
+        static auto connect(_Self&& __self, _Receiver __rcvr) -> __op_t<_Self, _Receiver> {
+          return {
+            static_cast<_Self&&>(__self).__sndr_,
+            static_cast<_Receiver&&>(__rcvr),
+            __self.__deadline_,
+            __self.__sched_};
+        }
+
+        template <__decays_to<__t> _Self, class... _Env>
+        static auto get_completion_signatures(_Self&&, _Env&&...) noexcept
+          -> __completions_t<_Self, _Env...> {
+          return {};
+        }
+
+        auto get_env() const noexcept -> __fwd_env_t<env_of_t<_Sender>> {
+          return __env::__fwd_fn()(stdexec::get_env(__sndr_));
+        }
+
+       private:
+        _Sender __sndr_;
+        _TimePoint __deadline_;
+        _Sched __sched_;
+      };
+    };
+
+    struct with_deadline_t {
+      template <sender _Sender, class _TimePoint>
+        requires __now::time_point<_TimePoint>
+      auto operator()(_Sender&& __sndr, _TimePoint __deadline) const
+        -> stdexec::__t<__sender<__id<__decay_t<_Sender>>, _TimePoint, __from_env>> {
+        return {static_cast<_Sender&&>(__sndr), __deadline, __from_env{}};
+      }
+
+      template <sender _Sender, __timed_scheduler _Sched>
+      auto operator()(_Sender&& __sndr, _Sched __sched, time_point_of_t<_Sched> __deadline) const
+        -> stdexec::__t<__sender<__id<__decay_t<_Sender>>, time_point_of_t<_Sched>, _Sched>> {
+        return {static_cast<_Sender&&>(__sndr), __deadline, static_cast<_Sched&&>(__sched)};
+      }
+
+      template <class _TimePoint>
+        requires __now::time_point<_TimePoint>
+      STDEXEC_ATTRIBUTE(always_inline)
+      auto operator()(_TimePoint __deadline) const -> __binder_back<with_deadline_t, _TimePoint> {
+        return {{static_cast<_TimePoint&&>(__deadline)}, {}, {}};
+      }
+
+      template <__timed_scheduler _Sched>
+      STDEXEC_ATTRIBUTE(always_inline)
+      auto operator()(_Sched __sched, time_point_of_t<_Sched> __deadline) const
+        -> __binder_back<with_deadline_t, _Sched, time_point_of_t<_Sched>> {
+        return {{static_cast<_Sched&&>(__sched), __deadline}, {}, {}};
+      }
+    };
+  } // namespace __deadline
+
+  using __deadline::with_deadline_t;
+  inline constexpr with_deadline_t with_deadline{};
+} // namespace exec
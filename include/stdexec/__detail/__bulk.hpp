@@ -109,6 +109,22 @@ namespace stdexec {
     template <class _Pol, class _Shape, class _Fun>
     __data(const _Pol&, _Shape, _Fun) -> __data<_Pol, _Shape, _Fun>;
 
+    template <class _Pol>
+    inline constexpr bool __is_unsequenced_policy =
+      __same_as<_Pol, unsequenced_policy> || __same_as<_Pol, parallel_unsequenced_policy>;
+
+    //! The iterations of an unsequenced bulk may be interleaved, so tell the compiler it can
+    //! vectorize the loop over a chunk.
+    template <class _Shape, class _Fun, class... _Args>
+    STDEXEC_ATTRIBUTE(always_inline)
+    void __unsequenced_loop(_Shape __begin, _Shape __end, _Fun& __fun, _Args&... __args)
+      noexcept(__nothrow_callable<_Fun&, _Shape, _Args&...>) {
+      STDEXEC_PRAGMA_SIMD()
+      for (_Shape __i = __begin; __i < __end; ++__i) {
+        __fun(__i, __args...);
+      }
+    }
+
     template <class _AlgoTag>
     struct __bulk_traits;
 
@@ -228,6 +244,7 @@ namespace stdexec {
       static auto __transform_sender_fn(const _Env&) {
         return [&]<class _Data, class _Child>(__ignore, _Data&& __data, _Child&& __child) {
           using __shape_t = std::remove_cvref_t<decltype(__data.__shape_)>;
+          using __policy_t = std::remove_cvref_t<decltype(__data.__pol_.__get())>;
           auto __new_f =
             [__func = std::move(
                __data.__fun_)](__shape_t __begin, __shape_t __end, auto&&... __vs) mutable
@@ -236,8 +253,12 @@ namespace stdexec {
             noexcept(noexcept(__data.__fun_(__begin++, __vs...)))
 #endif
           {
-            while (__begin != __end)
-              __func(__begin++, __vs...);
+            if constexpr (__is_unsequenced_policy<__policy_t>) {
+              __bulk::__unsequenced_loop(__begin, __end, __func, __vs...);
+            } else {
+              while (__begin != __end)
+                __func(__begin++, __vs...);
+            }
           };
 
           // Lower `bulk` to `bulk_chunked`. If `bulk_chunked` is customized, we will see the customization.
@@ -272,6 +272,25 @@ namespace __coro = std::experimental;
 #  define STDEXEC_PRAGMA_IGNORE_MSVC(...)
 #endif
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Placed before a loop whose iterations are unsequenced, i.e. carry no dependencies on each
+// other, to let the compiler vectorize it without first proving that its accesses don't alias.
+// With OpenMP (or -fopenmp-simd and STDEXEC_ENABLE_OPENMP_SIMD) this is `omp simd`, which
+// also overrides the compiler's cost model.
+#if STDEXEC_NVCC() || STDEXEC_EDG()
+#  define STDEXEC_PRAGMA_SIMD()
+#elif defined(_OPENMP) || defined(STDEXEC_ENABLE_OPENMP_SIMD)
+#  define STDEXEC_PRAGMA_SIMD() _Pragma("omp simd")
+#elif STDEXEC_CLANG()
+#  define STDEXEC_PRAGMA_SIMD() _Pragma("clang loop vectorize(assume_safety)")
+#elif STDEXEC_GCC()
+#  define STDEXEC_PRAGMA_SIMD() _Pragma("GCC ivdep")
+#elif STDEXEC_MSVC()
+#  define STDEXEC_PRAGMA_SIMD() __pragma(loop(ivdep))
+#else
+#  define STDEXEC_PRAGMA_SIMD()
+#endif
+
 #if !STDEXEC_MSVC() && defined(__has_builtin)
 #  define STDEXEC_HAS_BUILTIN __has_builtin
 #else
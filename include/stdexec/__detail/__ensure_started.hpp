@@ -69,8 +69,9 @@ namespace stdexec {
           static_cast<_Sender&&>(__sndr),
           [&]<class _Env, class _Child>(__ignore, _Env&& __env, _Child&& __child) {
             // The shared state starts life with a ref-count of one.
+            using __sh_state_t = __shared_state<_Child, __decay_t<_Env>>;
             auto* __sh_state =
-              new __shared_state{static_cast<_Child&&>(__child), static_cast<_Env&&>(__env)};
+              __sh_state_t::__make(static_cast<_Child&&>(__child), static_cast<_Env&&>(__env));
 
             // Eagerly start the work:
             __sh_state->__try_start(); // cannot throw
@@ -20,13 +20,19 @@
 // include these after __execution_fwd.hpp
 #include "__completion_signatures.hpp"
 #include "__env.hpp"
+#include "__intrusive_mpsc_queue.hpp"
 #include "__meta.hpp"
 #include "__receivers.hpp"
+#include "__spin_loop_pause.hpp"
 #include "__utility.hpp"
 
+#include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <mutex>
+#include <thread>
 #include <utility>
 
 namespace stdexec {
@@ -36,12 +42,8 @@ namespace stdexec {
     class run_loop;
 
     struct __task : __immovable {
-      __task* __next_ = this;
-
-      union {
-        __task* __tail_ = nullptr;
-        void (*__execute_)(__task*) noexcept;
-      };
+      std::atomic<void*> __next_{nullptr};
+      void (*__execute_)(__task*) noexcept = nullptr;
 
       void __execute() noexcept {
         (*__execute_)(this);
@@ -72,13 +74,8 @@ namespace stdexec {
           }
         }
 
-        explicit __t(__task* __tail) noexcept
-          : __task{{}, this, __tail} {
-        }
-
-        __t(__task* __next, run_loop* __loop, _Receiver __rcvr)
-          : __task{{}, __next, {}}
-          , __loop_{__loop}
+        __t(run_loop* __loop, _Receiver __rcvr)
+          : __loop_{__loop}
           , __rcvr_{static_cast<_Receiver&&>(__rcvr)} {
           __execute_ = &__execute_impl;
         }
@@ -108,7 +105,7 @@ namespace stdexec {
 
           template <class _Receiver>
           auto connect(_Receiver __rcvr) const -> __operation<_Receiver> {
-            return {&__loop_->__head_, __loop_, static_cast<_Receiver&&>(__rcvr)};
+            return {__loop_, static_cast<_Receiver&&>(__rcvr)};
           }
 
          private:
@@ -170,59 +167,206 @@ namespace stdexec {
         }
       };
 
+      run_loop() = default;
+
+      // NOT TO SPEC: when the queue runs dry, spin for up to __spin_count iterations waiting
+      // for more work before parking the thread. Useful when tasks arrive in quick bursts
+      // from other threads and the consumer has a core to itself.
+      explicit run_loop(std::size_t __spin_count) noexcept
+        : __spin_count_{__spin_count} {
+      }
+
+      // NOT TO SPEC: for driving the loop from an existing event loop with run_some() or
+      // run_one(). __wakeup(__wakeup_arg) is called, possibly from another thread, whenever
+      // work becomes available on a loop that has run out of it, and when finish() is called.
+      // It must not execute tasks itself; it should only arrange for the event loop to call
+      // run_some() soon, e.g. by writing to an eventfd.
+      run_loop(void (*__wakeup)(void*) noexcept, void* __wakeup_arg) noexcept
+        : __wakeup_{__wakeup}
+        , __wakeup_arg_{__wakeup_arg} {
+      }
+
+      // NOT TO SPEC: a producer that has just scheduled a task may still be inside the
+      // loop, e.g. calling the wakeup function, when the task has already run. The destructor
+      // waits for such producers to leave, so the loop may be destroyed as soon as the work it
+      // was waiting for has run, whether it was driven by run() or by run_some().
+      ~run_loop() {
+        __wait_for_producers_();
+      }
+
       auto get_scheduler() noexcept -> __scheduler {
         return __scheduler{this};
       }
 
+      //! Executes queued tasks until finish() has been called and the queue is empty. At most
+      //! one thread may be inside run() at a time.
       void run();
 
+      // NOT TO SPEC: executes at most __max tasks that are ready, without blocking, and
+      // returns how many were executed. Must not be called concurrently with run() or with
+      // another call to run_some() or run_one(). If it stops with work still queued, it calls
+      // the wakeup function so that the event loop comes back for the rest. Unlike run(), it
+      // does not wait for producers that are still inside the loop; ~run_loop() does.
+      auto run_some(std::size_t __max = ~std::size_t{0}) -> std::size_t;
+
+      // NOT TO SPEC: executes one task if one is ready, without blocking. Returns whether a
+      // task was executed.
+      auto run_one() -> bool;
+
       void finish();
 
      private:
-      void __push_back_(__task* __task);
-      auto __pop_front_() -> __task*;
-
+      // __state_ holds a "parked" flag in its low bit. The remaining bits count the threads
+      // that are inside __push_back_ or finish(). Neither run() nor the destructor returns
+      // until that count drops to zero, so a producer never touches a destroyed loop.
+      static constexpr std::uintptr_t __parked = 1;
+      static constexpr std::uintptr_t __producer = 2;
+
+      void __push_back_(__task* __task) noexcept;
+      auto __pop_front_() noexcept -> __task*;
+      void __release_producer_() noexcept;
+      auto __wait_for_work_() -> __task*;
+      void __wait_for_producers_() const noexcept;
+
+      __intrusive_mpsc_queue<&__task::__next_> __queue_;
+      std::atomic<std::uintptr_t> __state_{0};
+      std::atomic<bool> __finishing_{false};
+      std::size_t __spin_count_{0};
+      void (*__wakeup_)(void*) noexcept = nullptr;
+      void* __wakeup_arg_ = nullptr;
+      // A task run_some() dequeued but did not execute. Only the consumer touches it.
+      __task* __next_task_ = nullptr;
       std::mutex __mutex_;
       std::condition_variable __cv_;
-      __task __head_{{}, &__head_, {&__head_}};
-      bool __stop_ = false;
     };
 
     template <class _ReceiverId>
     inline void __operation<_ReceiverId>::__t::start() & noexcept {
-      STDEXEC_TRY {
-        __loop_->__push_back_(this);
-      }
-      STDEXEC_CATCH_ALL {
-        stdexec::set_error(static_cast<_Receiver&&>(__rcvr_), std::current_exception());
-      }
+      __loop_->__push_back_(this);
     }
 
     inline void run_loop::run() {
-      for (__task* __task; (__task = __pop_front_()) != &__head_;) {
+      for (;;) {
+        // Drain everything that is ready without touching the mutex.
+        while (__task* __task = __pop_front_()) {
+          __task->__execute();
+        }
+        __task* __task = __wait_for_work_();
+        if (__task == nullptr) {
+          return;
+        }
+        __task->__execute();
+      }
+    }
+
+    inline auto run_loop::run_some(std::size_t __max) -> std::size_t {
+      std::size_t __count = 0;
+      for (; __count < __max; ++__count) {
+        __task* __task = __pop_front_();
+        if (__task == nullptr) {
+          return __count;
+        }
         __task->__execute();
       }
+      // Producers only call the wakeup function when they find the queue empty, so if we
+      // leave work behind we have to ask for another turn ourselves.
+      if (__wakeup_ != nullptr && (__next_task_ = __pop_front_()) != nullptr) {
+        __wakeup_(__wakeup_arg_);
+      }
+      return __count;
+    }
+
+    inline auto run_loop::run_one() -> bool {
+      return run_some(1) != 0;
     }
 
     inline void run_loop::finish() {
-      std::unique_lock __lock{__mutex_};
-      __stop_ = true;
-      __cv_.notify_all();
+      __state_.fetch_add(__producer, std::memory_order_relaxed);
+      __finishing_.store(true, std::memory_order_release);
+      if (__wakeup_ != nullptr) {
+        __wakeup_(__wakeup_arg_);
+      }
+      __release_producer_();
+    }
+
+    inline void run_loop::__push_back_(__task* __task) noexcept {
+      __state_.fetch_add(__producer, std::memory_order_relaxed);
+      if (__queue_.push_back(__task) && __wakeup_ != nullptr) {
+        __wakeup_(__wakeup_arg_);
+      }
+      __release_producer_();
+    }
+
+    inline auto run_loop::__pop_front_() noexcept -> __task* {
+      if (__next_task_ != nullptr) {
+        return std::exchange(__next_task_, nullptr);
+      }
+      return __queue_.pop_front();
+    }
+
+    // Drops the count taken by __push_back_ or finish(), first waking the consumer if, and only
+    // if, it has parked. Both this and the consumer's parking go through read-modify-writes of
+    // __state_, so either the consumer sees our task (or the finishing flag) when it re-checks
+    // after setting its parked flag, or we see that flag here.
+    inline void run_loop::__release_producer_() noexcept {
+      auto __state = __state_.load(std::memory_order_relaxed);
+      while (!(__state & __parked)) {
+        if (__state_.compare_exchange_weak(
+              __state,
+              __state - __producer,
+              std::memory_order_acq_rel,
+              std::memory_order_relaxed)) {
+          return;
+        }
+      }
+      {
+        std::unique_lock __lock{__mutex_};
+        if (__state_.fetch_and(~__parked, std::memory_order_relaxed) & __parked) {
+          __cv_.notify_one();
+        }
+      }
+      __state_.fetch_sub(__producer, std::memory_order_release);
     }
 
-    inline void run_loop::__push_back_(__task* __task) {
-      std::unique_lock __lock{__mutex_};
-      __task->__next_ = &__head_;
-      __head_.__tail_ = __head_.__tail_->__next_ = __task;
-      __cv_.notify_one();
+    // Called by the consumer after the queue has run dry. Returns the next task to execute, or
+    // nullptr when finish() has been called and no more work is coming.
+    inline auto run_loop::__wait_for_work_() -> __task* {
+      for (std::size_t __i = 0; __i < __spin_count_; ++__i) {
+        if (__task* __task = __pop_front_()) {
+          return __task;
+        }
+        if (__finishing_.load(std::memory_order_acquire)) {
+          break;
+        }
+        __spin_loop_pause();
+      }
+
+      for (;;) {
+        if (__finishing_.load(std::memory_order_acquire)) {
+          __wait_for_producers_();
+          return __pop_front_();
+        }
+
+        std::unique_lock __lock{__mutex_};
+        __state_.fetch_or(__parked, std::memory_order_acq_rel);
+        if (__task* __task = __pop_front_()) {
+          __state_.fetch_and(~__parked, std::memory_order_relaxed);
+          return __task;
+        }
+        if (!__finishing_.load(std::memory_order_acquire)) {
+          __cv_.wait(__lock, [this] {
+            return !(__state_.load(std::memory_order_relaxed) & __parked);
+          });
+        } else {
+          __state_.fetch_and(~__parked, std::memory_order_relaxed);
+        }
+      }
     }
 
-    inline auto run_loop::__pop_front_() -> __task* {
-      std::unique_lock __lock{__mutex_};
-      __cv_.wait(__lock, [this] { return __head_.__next_ != &__head_ || __stop_; });
-      if (__head_.__tail_ == __head_.__next_)
-        __head_.__tail_ = &__head_;
-      return std::exchange(__head_.__next_, __head_.__next_->__next_);
+    inline void run_loop::__wait_for_producers_() const noexcept {
+      while (__state_.load(std::memory_order_acquire) >= __producer) {
+        std::this_thread::yield();
+      }
     }
   } // namespace __loop
 
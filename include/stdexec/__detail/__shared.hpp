@@ -20,10 +20,10 @@
 // include these after __execution_fwd.hpp
 #include "__basic_sender.hpp"
 #include "__env.hpp"
-#include "__intrusive_slist.hpp"
 #include "__optional.hpp"
 #include "__meta.hpp"
 #include "__receivers.hpp"
+#include "__scope.hpp"
 #include "__transform_completion_signatures.hpp"
 #include "__tuple.hpp"
 #include "__variant.hpp" // IWYU pragma: keep
@@ -32,6 +32,7 @@
 
 #include <atomic>
 #include <exception>
+#include <memory>
 #include <mutex>
 #include <type_traits>
 #include <utility>
@@ -56,6 +57,10 @@
 // The shared state should add-ref itself when the input async
 // operation is started and release itself when its completion
 // is notified.
+//
+// The shared state is allocated with the allocator returned by
+// get_allocator on the environment passed to split/ensure_started,
+// if there is one.
 namespace stdexec::__shared {
   template <class _BaseEnv>
   using __env_t = __join_env_t<
@@ -121,17 +126,16 @@ namespace stdexec::__shared {
     void operator()() noexcept {
       // We reach here when a split/ensure_started sender has received a stop request from the
       // receiver to which it is connected.
-      if (std::unique_lock __lock{__sh_state_->__mutex_}) {
-        // Remove this operation from the waiters list. Removal can fail if:
-        //   1. It was already removed by another thread, or
-        //   2. It hasn't been added yet (see `start` below), or
-        //   3. The underlying operation has already completed.
-
-        // In each case, the right thing to do is nothing. If (1) then we raced with another
-        // thread and lost. In that case, the other thread will take care of it. If (2) then
-        // `start` will take care of it. If (3) then this stop request is safe to ignore.
-        if (!__sh_state_->__waiters_.remove(this))
-          return;
+      // Remove this operation from the waiters list. Removal can fail if:
+      //   1. It was already removed by another thread, or
+      //   2. It hasn't been added yet (see `start` below), or
+      //   3. The underlying operation has already completed.
+
+      // In each case, the right thing to do is nothing. If (1) then we raced with another
+      // thread and lost. In that case, the other thread will take care of it. If (2) then
+      // `start` will take care of it. If (3) then this stop request is safe to ignore.
+      if (!__sh_state_->__try_remove_waiter(this)) {
+        return;
       }
 
       // The following code and the __notify function cannot both execute. This is because the
@@ -207,11 +211,19 @@ namespace stdexec::__shared {
     };
   };
 
+  template <class _Env>
+  auto __get_allocator(const _Env& __env) noexcept {
+    if constexpr (__callable<get_allocator_t, const _Env&>) {
+      return get_allocator(__env);
+    } else {
+      return std::allocator<std::byte>{};
+    }
+  }
+
   //! Heap-allocatable shared state for things like `stdexec::split`.
   template <class _CvrefSender, class _Env>
   struct __shared_state {
     using __receiver_t = __t<__receiver<__cvref_id<_CvrefSender>, __id<_Env>>>;
-    using __waiters_list_t = __intrusive_slist<&__local_state_base::__next_>;
 
     using __variant_t = __transform_completion_signatures<
       __completion_signatures_of_t<_CvrefSender, _Env>,
@@ -225,8 +237,11 @@ namespace stdexec::__shared {
     inplace_stop_source __stop_source_{};
     __env_t<_Env> __env_;
     __variant_t __results_{}; // Defaults to the "set_stopped" state
-    std::mutex __mutex_;      // This mutex guards access to __waiters_.
-    __waiters_list_t __waiters_{};
+    // An intrusive stack of waiters, or the address of __tombstone_ once the operation has
+    // completed. Waiters are pushed with a CAS; __remove_mutex_ serializes the removal of
+    // cancelled waiters with each other and with completion.
+    std::atomic<__local_state_base*> __waiters_{nullptr};
+    std::mutex __remove_mutex_{};
     connect_result_t<_CvrefSender, __receiver_t> __shared_op_;
     std::atomic_flag __started_{};
     std::atomic<std::size_t> __ref_count_{2};
@@ -252,9 +267,36 @@ namespace stdexec::__shared {
       __ref_count_.fetch_add(2ul, std::memory_order_relaxed);
     }
 
+    //! Allocates and constructs the shared state with the allocator of `__env`, if any.
+    static auto __make(_CvrefSender&& __sndr, _Env __env) -> __shared_state* {
+      auto __env_alloc = __shared::__get_allocator(__env);
+      using _Alloc = std::allocator_traits<
+        decltype(__env_alloc)
+      >::template rebind_alloc<__shared_state>;
+      _Alloc __alloc{__env_alloc};
+      auto* __self = std::allocator_traits<_Alloc>::allocate(__alloc, 1);
+      __scope_guard __guard{[&]() noexcept {
+        std::allocator_traits<_Alloc>::deallocate(__alloc, __self, 1);
+      }};
+      std::allocator_traits<_Alloc>::construct(
+        __alloc, __self, static_cast<_CvrefSender&&>(__sndr), static_cast<_Env&&>(__env));
+      __guard.__dismiss();
+      return __self;
+    }
+
+    void __destroy() noexcept {
+      auto __env_alloc = __shared::__get_allocator(__env_);
+      using _Alloc = std::allocator_traits<
+        decltype(__env_alloc)
+      >::template rebind_alloc<__shared_state>;
+      _Alloc __alloc{__env_alloc};
+      std::allocator_traits<_Alloc>::destroy(__alloc, this);
+      std::allocator_traits<_Alloc>::deallocate(__alloc, this, 1);
+    }
+
     void __dec_ref() noexcept {
       if (2ul == __ref_count_.fetch_sub(2ul, std::memory_order_acq_rel)) {
-        delete this;
+        __destroy();
       }
     }
 
@@ -268,7 +310,7 @@ namespace stdexec::__shared {
 
     void __set_completed() noexcept {
       if (1ul == __ref_count_.fetch_sub(1ul, std::memory_order_acq_rel)) {
-        delete this;
+        __destroy();
       }
     }
 
@@ -302,22 +344,54 @@ namespace stdexec::__shared {
       }
     }
 
+    // Pushes a waiter without taking a lock. Returns false if stop was requested and the waiter
+    // was taken back out, in which case the caller completes it with set_stopped.
     template <class _StopToken>
     auto __try_add_waiter(__local_state_base* __waiter, _StopToken __stok) noexcept -> bool {
-      std::unique_lock __lock{__mutex_};
-      if (__waiters_.front() == &__tombstone_) {
-        // The work has already completed. Notify the waiter immediately.
-        __lock.unlock();
-        __waiter->__notify();
-        return true;
-      } else if (__stok.stop_requested()) {
-        // Stop has been requested. Do not add the waiter.
+      // Acquire, so that a waiter that finds the tombstone sees the results.
+      __local_state_base* __head = __waiters_.load(std::memory_order_acquire);
+      do {
+        if (__head == &__tombstone_) {
+          // The work has already completed. Notify the waiter immediately.
+          __waiter->__notify();
+          return true;
+        }
+        __waiter->__next_ = __head;
+      } while (!__waiters_.compare_exchange_weak(
+        __head, __waiter, std::memory_order_acq_rel, std::memory_order_acquire));
+
+      // The stop callback was registered before the push. If it ran before the push, it did not
+      // find the waiter, so take the waiter back out here. Whoever removes it completes it.
+      if (__stok.stop_requested()) {
+        return !__try_remove_waiter(__waiter);
+      }
+      return true;
+    }
+
+    // Unlinks a waiter whose receiver asked to stop. Returns false if the waiter was not in the
+    // list, or the operation has already completed and is about to notify it. Removals hold
+    // __remove_mutex_, so pushes never wait for them.
+    auto __try_remove_waiter(__local_state_base* __waiter) noexcept -> bool {
+      std::lock_guard __guard{__remove_mutex_};
+      __local_state_base* __head = __waiters_.load(std::memory_order_acquire);
+      if (__head == __waiter) {
+        if (__waiters_.compare_exchange_strong(
+              __head, __waiter->__next_, std::memory_order_acq_rel, std::memory_order_acquire)) {
+          return true;
+        }
+        // A waiter was pushed in front of this one; unlink it from its predecessor below.
+      }
+      if (__head == &__tombstone_) {
         return false;
-      } else {
-        // Add the waiter to the list.
-        __waiters_.push_front(__waiter);
-        return true;
       }
+      // Concurrent pushes only change the head, so the rest of the list is stable.
+      for (auto* __prev = __head; __prev != nullptr; __prev = __prev->__next_) {
+        if (__prev->__next_ == __waiter) {
+          __prev->__next_ = __waiter->__next_;
+          return true;
+        }
+      }
+      return false;
     }
 
     /// @brief This is called when the shared async operation completes.
@@ -339,23 +413,22 @@ namespace stdexec::__shared {
     /// @brief This is called when the shared async operation completes.
     /// @post __waiters_ is set to a known "tombstone" value.
     void __notify_waiters() noexcept {
-      __waiters_list_t __waiters_copy{&__tombstone_};
-
-      // Set the waiters list to a known "tombstone" value that we can check later.
+      // Set the waiters list to a known "tombstone" value that we can check later. Doing this
+      // under __remove_mutex_ means that a concurrent removal either finishes first or sees the
+      // tombstone, so the detached list can be walked without a lock.
+      __local_state_base* __head = nullptr;
       {
-        std::lock_guard __lock{__mutex_};
-        __waiters_.swap(__waiters_copy);
+        std::lock_guard __guard{__remove_mutex_};
+        __head = __waiters_.exchange(&__tombstone_, std::memory_order_acq_rel);
       }
 
-      STDEXEC_ASSERT(__waiters_copy.front() != &__tombstone_);
-      for (auto __itr = __waiters_copy.begin(); __itr != __waiters_copy.end();) {
-        __local_state_base* __item = *__itr;
-
-        // We must increment the iterator before calling notify, since notify may end up
-        // triggering *__item to be destructed on another thread, and the intrusive slist's
-        // iterator increment relies on __item.
-        ++__itr;
+      STDEXEC_ASSERT(__head != &__tombstone_);
+      for (auto* __item = __head; __item != nullptr;) {
+        // We must read the next pointer before calling notify, since notify may end up
+        // triggering *__item to be destructed on another thread.
+        auto* __next = __item->__next_;
         __item->__notify();
+        __item = __next;
       }
 
       // Set the "is running" bit in the ref count to zero. Delete the shared state if the
@@ -39,19 +39,29 @@
 #include "../stop_token.hpp"
 
 #include <atomic>
+#include <cstddef>
 #include <exception>
+#include <memory>
+#include <new>
+#include <type_traits>
 
 namespace stdexec {
   /////////////////////////////////////////////////////////////////////////////
   // [execution.senders.adaptors.when_all]
   // [execution.senders.adaptors.when_all_with_variant]
   namespace __when_all {
-    enum __state_t {
-      __started,
-      __error,
-      __stopped
+    // The state lives in the low two bits of the same atomic word as the count of outstanding
+    // children. The encoding lets every transition be a single fetch_or: stopping only sets the
+    // low bit, and an error sets both so that it trumps cancellation.
+    enum __state_t : std::size_t {
+      __started = 0,
+      __stopped = 1,
+      __error = 3
     };
 
+    inline constexpr std::size_t __state_mask = 3;
+    inline constexpr std::size_t __count_one = 4;
+
     struct __on_stop_request {
       inplace_stop_source& __stop_source_;
 
@@ -61,14 +71,95 @@ namespace stdexec {
     };
 
     template <class _Env>
-    auto __mkenv(_Env&& __env, const inplace_stop_source& __stop_source) noexcept {
-      return __env::__join(
-        prop{get_stop_token, __stop_source.get_token()}, static_cast<_Env&&>(__env));
+    auto __mkenv(_Env&& __env, inplace_stop_token __stop_token) noexcept {
+      return __env::__join(prop{get_stop_token, __stop_token}, static_cast<_Env&&>(__env));
     }
 
     template <class _Env>
-    using __env_t =
-      decltype(__when_all::__mkenv(__declval<_Env>(), __declval<inplace_stop_source&>()));
+    using __env_t = decltype(__when_all::__mkenv(__declval<_Env>(), inplace_stop_token()));
+
+    // Forwards stop requests from the receiver to the children, and lets a child that fails
+    // cancel its siblings.
+    template <class _StopToken>
+    struct __forward_stop {
+      using __stop_callback_t = stop_callback_for_t<_StopToken, __on_stop_request>;
+
+      auto __get_token() const noexcept -> inplace_stop_token {
+        return __stop_source_.get_token();
+      }
+
+      auto __register(_StopToken __token) noexcept -> bool {
+        __on_stop_.emplace(static_cast<_StopToken&&>(__token), __on_stop_request{__stop_source_});
+        return __stop_source_.stop_requested();
+      }
+
+      void __unregister() noexcept {
+        __on_stop_.reset();
+      }
+
+      void __request_stop() noexcept {
+        __stop_source_.request_stop();
+      }
+
+      inplace_stop_source __stop_source_{};
+      __optional<__stop_callback_t> __on_stop_{};
+    };
+
+    // Used when the receiver's stop token is unstoppable and no child can complete with an
+    // error or with stopped: nothing can ever cancel the children, so they are given a token
+    // that is never stopped and the when_all operation carries no stop source at all.
+    struct __no_stop {
+      static auto __get_token() noexcept -> inplace_stop_token {
+        return {};
+      }
+
+      template <class _StopToken>
+      static auto __register(_StopToken) noexcept -> bool {
+        return false;
+      }
+
+      static void __unregister() noexcept {
+      }
+
+      static void __request_stop() noexcept {
+      }
+    };
+
+    // Storage for the values of one child. If the decayed values are trivially destructible,
+    // nothing needs to be cleaned up when the when_all fails, so the slot need not remember
+    // whether it was ever filled.
+    template <class _Tuple>
+    struct __trivial_value_slot {
+      __trivial_value_slot() noexcept {
+      }
+
+      template <class... _Args>
+      void emplace(_Args&&... __args) noexcept(__nothrow_constructible_from<_Tuple, _Args...>) {
+        ::new (static_cast<void*>(std::addressof(__value_)))
+          _Tuple{static_cast<_Args&&>(__args)...};
+      }
+
+      auto operator*() & noexcept -> _Tuple& {
+        return __value_;
+      }
+
+      auto operator*() && noexcept -> _Tuple&& {
+        return static_cast<_Tuple&&>(__value_);
+      }
+
+      // Left uninitialized until the child completes; trivially destructible, so the union
+      // needs no destructor.
+      union {
+        _Tuple __value_;
+      };
+    };
+
+    template <class _Tuple>
+    using __value_slot_t = __if_c<
+      std::is_trivially_destructible_v<_Tuple>,
+      __trivial_value_slot<_Tuple>,
+      __optional<_Tuple>
+    >;
 
     template <class _Sender, class _Env>
     concept __max1_sender =
@@ -161,11 +252,11 @@ namespace stdexec {
 
     template <class _Env, class _Sender>
     using __values_opt_tuple_t =
-      value_types_of_t<_Sender, __env_t<_Env>, __decayed_tuple, __optional>;
+      value_types_of_t<_Sender, __env_t<_Env>, __decayed_tuple, __value_slot_t>;
 
     template <class _Env, __max1_sender<__env_t<_Env>>... _Senders>
     struct __traits {
-      // tuple<optional<tuple<Vs1...>>, optional<tuple<Vs2...>>, ...>
+      // tuple<slot<tuple<Vs1...>>, slot<tuple<Vs2...>>, ...>
       using __values_tuple = __minvoke<
         __with_default<
           __mtransform<__mbind_front_q<__values_opt_tuple_t, _Env>, __q<__tuple_for>>,
@@ -187,17 +278,29 @@ namespace stdexec {
       >;
 
       using __errors_variant = __mapply<__q<__uniqued_variant_for>, __errors_list>;
+
+      static constexpr bool __needs_stop_source = !unstoppable_token<stop_token_of_t<_Env>>
+                                               || !__same_as<__errors_variant, __variant_for<>>
+                                               || (sends_stopped<_Senders, __env_t<_Env>> || ...);
     };
 
     struct _INVALID_ARGUMENTS_TO_WHEN_ALL_ { };
 
-    template <class _ErrorsVariant, class _ValuesTuple, class _StopToken>
+    template <class _ErrorsVariant, class _ValuesTuple, class _StopState>
     struct __when_all_state {
-      using __stop_callback_t = stop_callback_for_t<_StopToken, __on_stop_request>;
+      auto __state() const noexcept -> __state_t {
+        return static_cast<__state_t>(__count_.load(std::memory_order_relaxed) & __state_mask);
+      }
+
+      // Moves to the given state unless the current state already trumps it. Returns the
+      // prior state.
+      auto __transition(__state_t __new_state) noexcept -> __state_t {
+        return static_cast<__state_t>(__count_.fetch_or(__new_state) & __state_mask);
+      }
 
       template <class _Receiver>
       void __arrive(_Receiver& __rcvr) noexcept {
-        if (1 == __count_.fetch_sub(1)) {
+        if (__count_one == (__count_.fetch_sub(__count_one) & ~__state_mask)) {
           __complete(__rcvr);
         }
       }
@@ -205,9 +308,9 @@ namespace stdexec {
       template <class _Receiver>
       void __complete(_Receiver& __rcvr) noexcept {
         // Stop callback is no longer needed. Destroy it.
-        __on_stop_.reset();
+        __stop_.__unregister();
         // All child operations have completed and arrived at the barrier.
-        switch (__state_.load(std::memory_order_relaxed)) {
+        switch (__state()) {
         case __started:
           if constexpr (!same_as<_ValuesTuple, __ignore>) {
             // All child operations completed successfully:
@@ -228,13 +331,11 @@ namespace stdexec {
         }
       }
 
+      // The number of outstanding children times __count_one, plus the __state_t.
       std::atomic<std::size_t> __count_;
-      inplace_stop_source __stop_source_{};
-      // Could be non-atomic here and atomic_ref everywhere except __completion_fn
-      std::atomic<__state_t> __state_{__started};
-      _ErrorsVariant __errors_{};
+      STDEXEC_ATTRIBUTE(no_unique_address) _StopState __stop_ { };
+      STDEXEC_ATTRIBUTE(no_unique_address) _ErrorsVariant __errors_ { };
       STDEXEC_ATTRIBUTE(no_unique_address) _ValuesTuple __values_ { };
-      __optional<__stop_callback_t> __on_stop_{};
     };
 
     template <class _Env>
@@ -243,8 +344,13 @@ namespace stdexec {
         using _Traits = __traits<_Env, _Child...>;
         using _ErrorsVariant = _Traits::__errors_variant;
         using _ValuesTuple = _Traits::__values_tuple;
-        using _State = __when_all_state<_ErrorsVariant, _ValuesTuple, stop_token_of_t<_Env>>;
-        return _State{sizeof...(_Child)};
+        using _StopState = __if_c<
+          _Traits::__needs_stop_source,
+          __forward_stop<stop_token_of_t<_Env>>,
+          __no_stop
+        >;
+        using _State = __when_all_state<_ErrorsVariant, _ValuesTuple, _StopState>;
+        return _State{sizeof...(_Child) * __count_one};
       };
     }
 
@@ -292,7 +398,7 @@ namespace stdexec {
           __ignore,
           _State& __state,
           const _Receiver& __rcvr) noexcept -> __env_t<env_of_t<const _Receiver&>> {
-        return __mkenv(stdexec::get_env(__rcvr), __state.__stop_source_);
+        return __mkenv(stdexec::get_env(__rcvr), __state.__stop_.__get_token());
       };
 
       static constexpr auto get_state =
@@ -307,9 +413,7 @@ namespace stdexec {
                                       _Receiver& __rcvr,
                                       _Operations&... __child_ops) noexcept -> void {
         // register stop callback:
-        __state.__on_stop_.emplace(
-          get_stop_token(stdexec::get_env(__rcvr)), __on_stop_request{__state.__stop_source_});
-        if (__state.__stop_source_.stop_requested()) {
+        if (__state.__stop_.__register(get_stop_token(stdexec::get_env(__rcvr)))) {
           // Stop has already been requested. Don't bother starting
           // the child operations.
           stdexec::set_stopped(static_cast<_Receiver&&>(__rcvr));
@@ -323,13 +427,13 @@ namespace stdexec {
 
       template <class _State, class _Receiver, class _Error>
       static void __set_error(_State& __state, _Receiver&, _Error&& __err) noexcept {
-        // Transition to the "error" state and switch on the prior state.
-        // TODO: What memory orderings are actually needed here?
-        switch (__state.__state_.exchange(__error)) {
+        // Transition to the "error" state and switch on the prior state. The error is published
+        // to the last child to arrive by the release sequence on the count.
+        switch (__state.__transition(__error)) {
         case __started:
           // We must request stop. When the previous state is __error or __stopped, then stop has
           // already been requested.
-          __state.__stop_source_.request_stop();
+          __state.__stop_.__request_stop();
           [[fallthrough]];
         case __stopped:
           // We are the first child to complete with an error, so we must save the error. (Any
@@ -360,19 +464,21 @@ namespace stdexec {
         if constexpr (__same_as<_Set, set_error_t>) {
           __set_error(__state, __rcvr, static_cast<_Args&&>(__args)...);
         } else if constexpr (__same_as<_Set, set_stopped_t>) {
-          __state_t __expected = __started;
           // Transition to the "stopped" state if and only if we're in the
-          // "started" state. (If this fails, it's because we're in an
-          // error state, which trumps cancellation.)
-          if (__state.__state_.compare_exchange_strong(__expected, __stopped)) {
-            __state.__stop_source_.request_stop();
+          // "started" state. (Setting the stopped bit leaves an error state
+          // unchanged, since an error trumps cancellation.)
+          if (__state.__transition(__stopped) == __started) {
+            __state.__stop_.__request_stop();
           }
         } else if constexpr (!__same_as<_ValuesTuple, __ignore>) {
-          // We only need to bother recording the completion values
-          // if we're not already in the "error" or "stopped" state.
-          if (__state.__state_.load() == __started) {
+          using _Tuple = __decayed_tuple<_Args...>;
+          // We only need to bother recording the completion values if we're not already in
+          // the "error" or "stopped" state. Values that are cheap to store and need no cleanup
+          // are stored regardless, which spares a load of the contended count.
+          constexpr bool __store_always = std::is_trivially_destructible_v<_Tuple>
+                                       && (__nothrow_decay_copyable<_Args> && ...);
+          if (__store_always || __state.__state() == __started) {
             auto& __opt_values = _ValuesTuple::template __get<__v<_Index>>(__state.__values_);
-            using _Tuple = __decayed_tuple<_Args...>;
             static_assert(
               __same_as<decltype(*__opt_values), _Tuple&>,
               "One of the senders in this when_all() is fibbing about what types it sends");
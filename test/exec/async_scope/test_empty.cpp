@@ -1,5 +1,6 @@
 #include <catch2/catch.hpp>
 #include <exec/async_scope.hpp>
+#include <exec/static_thread_pool.hpp>
 #include "test_common/schedulers.hpp"
 #include "test_common/receivers.hpp"
 
@@ -171,4 +172,25 @@ namespace {
     REQUIRE(is_empty2);
   }
 #endif
+
+  TEST_CASE("empty waits for work spawned from many threads", "[async_scope][empty]") {
+    exec::static_thread_pool pool{4};
+    auto sch = pool.get_scheduler();
+    async_scope scope;
+    std::atomic<int> executed{0};
+
+    constexpr int num_spawners = 8;
+    constexpr int num_oper = 2'000;
+    for (int i = 0; i < num_spawners; ++i) {
+      scope.spawn(ex::starts_on(sch, ex::just() | ex::then([&] {
+                                  for (int j = 0; j < num_oper; ++j) {
+                                    scope.spawn(ex::starts_on(sch, ex::just() | ex::then([&] {
+                                                                     executed.fetch_add(1);
+                                                                   })));
+                                  }
+                                })));
+    }
+    sync_wait(scope.on_empty());
+    REQUIRE(executed == num_spawners * num_oper);
+  }
 } // namespace
@@ -1,9 +1,13 @@
 #include <catch2/catch.hpp>
 #include <exec/async_scope.hpp>
+#include <exec/static_thread_pool.hpp>
+#include "test_common/allocators.hpp"
 #include "test_common/schedulers.hpp"
 #include "test_common/receivers.hpp"
 #include "test_common/type_helpers.hpp"
 
+#include <atomic>
+
 namespace ex = stdexec;
 using exec::async_scope;
 using stdexec::sync_wait;
@@ -224,4 +228,66 @@ namespace {
     // TODO: reenable this
     // REQUIRE(P2519::__scope::empty(scope));
   }
+
+  TEST_CASE("spawn allocates with the allocator of the environment", "[async_scope][spawn]") {
+    impulse_scheduler sch;
+    allocation_counts counts;
+    int executed{0};
+    async_scope scope;
+
+    auto env = ex::prop{ex::get_allocator, counting_allocator<std::byte>{&counts}};
+    for (int i = 0; i < 3; ++i) {
+      scope.spawn(ex::starts_on(sch, ex::just() | ex::then([&] { ++executed; })), env);
+    }
+    REQUIRE(counts.allocated == 3);
+    REQUIRE(counts.deallocated == 0);
+
+    for (int i = 0; i < 3; ++i) {
+      sch.start_next();
+    }
+    REQUIRE(executed == 3);
+    REQUIRE(counts.deallocated == 3);
+    sync_wait(scope.on_empty());
+  }
+
+  TEST_CASE(
+    "spawn recycles operation states when spawning from many threads",
+    "[async_scope][spawn]") {
+    // The spawn pool is the kind a scope owns. Passing it explicitly lets the test count its
+    // allocations.
+    exec::__scope::__spawn_pool spawn_pool;
+    auto env = ex::prop{
+      ex::get_allocator, exec::__scope::__spawn_pool_allocator<std::byte>{&spawn_pool}};
+    exec::static_thread_pool pool{4};
+    std::atomic<int> executed{0};
+    async_scope scope;
+
+    // The operations are spawned on this thread and freed on the pool's threads. Every batch
+    // holds back its operations until all of them have been spawned, so each batch needs the
+    // same number of blocks. After the first batch has warmed up the spawn pool, the following
+    // batches reuse its blocks.
+    constexpr int num_batches = 100;
+    constexpr int batch_size = 100;
+    std::size_t allocations_after_warm_up = 0;
+    for (int batch = 0; batch < num_batches; ++batch) {
+      if (batch == 1) {
+        allocations_after_warm_up = spawn_pool.__num_allocations();
+        REQUIRE(allocations_after_warm_up > 0);
+      }
+      std::atomic<bool> released{false};
+      for (int i = 0; i < batch_size; ++i) {
+        scope.spawn(
+          ex::starts_on(pool.get_scheduler(), ex::just() | ex::then([&] {
+                                                 released.wait(false);
+                                                 executed.fetch_add(1);
+                                               })),
+          env);
+      }
+      released = true;
+      released.notify_all();
+      sync_wait(scope.on_empty());
+    }
+    REQUIRE(spawn_pool.__num_allocations() == allocations_after_warm_up);
+    REQUIRE(executed == num_batches * batch_size);
+  }
 } // namespace
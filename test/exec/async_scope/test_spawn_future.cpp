@@ -3,6 +3,7 @@
 #include <exec/just_from.hpp>
 #include <exec/static_thread_pool.hpp>
 #include <exec/just_from.hpp>
+#include "test_common/allocators.hpp"
 #include "test_common/schedulers.hpp"
 #include "test_common/receivers.hpp"
 
@@ -471,4 +472,59 @@ namespace {
     // ex::start(op);
     expect_empty(scope);
   }
+
+  TEST_CASE(
+    "spawn_future allocates with the allocator of the environment",
+    "[async_scope][spawn_future]") {
+    impulse_scheduler sch;
+    allocation_counts counts;
+    async_scope scope;
+
+    auto env = ex::prop{ex::get_allocator, counting_allocator<std::byte>{&counts}};
+    {
+      auto fut = scope.spawn_future(ex::starts_on(sch, ex::just(13)), env);
+      REQUIRE(counts.allocated == 1);
+      sch.start_next();
+      auto [value] = sync_wait(std::move(fut)).value();
+      REQUIRE(value == 13);
+    }
+    REQUIRE(counts.deallocated == 1);
+
+    {
+      // Drop the future before the work completes.
+      auto fut = scope.spawn_future(ex::starts_on(sch, ex::just(42)), env);
+      (void) fut;
+    }
+    REQUIRE(counts.allocated == 2);
+    REQUIRE(counts.deallocated == 1);
+    sch.start_next();
+    REQUIRE(counts.deallocated == 2);
+    expect_empty(scope);
+  }
+
+  TEST_CASE(
+    "spawn_future handles racing completion, subscription, and abandonment",
+    "[async_scope][spawn_future]") {
+    exec::static_thread_pool pool{4};
+    auto sch = pool.get_scheduler();
+    async_scope scope;
+    std::atomic<long> sum{0};
+    long expected = 0;
+
+    constexpr int num_futures = 20'000;
+    for (int i = 0; i < num_futures; ++i) {
+      auto fut = scope.spawn_future(ex::starts_on(sch, ex::just(i)));
+      if (i % 3 == 0) {
+        // Drop the future while the work may still be running.
+        continue;
+      }
+      // Connect and start the future on another thread while the work may be completing.
+      scope.spawn(ex::starts_on(sch, std::move(fut) | ex::then([&](int value) {
+                                        sum.fetch_add(value, std::memory_order_relaxed);
+                                      })));
+      expected += i;
+    }
+    sync_wait(scope.on_empty());
+    REQUIRE(sum == expected);
+  }
 } // namespace
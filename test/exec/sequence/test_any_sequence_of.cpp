@@ -18,8 +18,16 @@
 
 #include "exec/sequence/any_sequence_of.hpp"
 #include "exec/sequence/empty_sequence.hpp"
+#include "exec/sequence/ignore_all_values.hpp"
+#include "exec/sequence/iterate.hpp"
+#include "exec/sequence/transform_each.hpp"
 
 #include <catch2/catch.hpp>
+#include <test_common/allocators.hpp>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
 
 STDEXEC_PRAGMA_PUSH()
 STDEXEC_PRAGMA_IGNORE_GNU("-Wunused-function")
@@ -144,6 +152,102 @@ namespace {
         stdexec::__t<exec::__any::__sender_env<Completions, stdexec::__types<>, stdexec::__types<>>>
       >);
   }
+
+  // A sender whose operation state is aligned to Align, which is stricter than the alignment of
+  // std::max_align_t. It sends how far its operation state is off that alignment.
+  template <std::size_t Align>
+  struct over_aligned_sender {
+    using sender_concept = stdexec::sender_t;
+    using completion_signatures = stdexec::completion_signatures<stdexec::set_value_t(int)>;
+
+    template <class Receiver>
+    struct operation {
+      alignas(Align) Receiver rcvr;
+
+      void start() & noexcept {
+        const auto address = reinterpret_cast<std::uintptr_t>(this);
+        stdexec::set_value(static_cast<Receiver&&>(rcvr), static_cast<int>(address % Align));
+      }
+    };
+
+    template <class Receiver>
+    auto connect(Receiver rcvr) && -> operation<Receiver> {
+      return {static_cast<Receiver&&>(rcvr)};
+    }
+  };
+
+  template <std::size_t Align>
+  auto misalignment_of_item_operation() -> int {
+    using Completions = stdexec::completion_signatures<stdexec::set_value_t(int)>;
+    exec::any_sequence_receiver_ref<Completions>::any_sender<> any_sequence =
+      over_aligned_sender<Align>{};
+    int misalignment = -1;
+    auto sndr = exec::ignore_all_values(exec::transform_each(
+      std::move(any_sequence), stdexec::then([&](int value) { misalignment = value; })));
+    CHECK(stdexec::sync_wait(std::move(sndr)));
+    return misalignment;
+  }
+
+  TEST_CASE(
+    "any_sequence_of - aligns over-aligned item operations",
+    "[sequence_senders][any_sequence_of]") {
+    CHECK(misalignment_of_item_operation<4 * alignof(std::max_align_t)>() == 0);
+    CHECK(misalignment_of_item_operation<4096>() == 0);
+  }
+
+#if STDEXEC_HAS_STD_RANGES()
+  template <class AnySequence>
+  auto sum_of(AnySequence sequence) -> int {
+    int sum = 0;
+    auto sndr = exec::ignore_all_values(
+      exec::transform_each(std::move(sequence), stdexec::then([&](int value) { sum += value; })));
+    CHECK(stdexec::sync_wait(std::move(sndr)));
+    return sum;
+  }
+
+  TEST_CASE("any_sequence_of - forwards many items", "[sequence_senders][any_sequence_of]") {
+    using Completions = stdexec::completion_signatures<
+      stdexec::set_value_t(int&),
+      stdexec::set_error_t(std::exception_ptr),
+      stdexec::set_stopped_t()
+    >;
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+    exec::any_sequence_receiver_ref<Completions>::any_sender<> any_sequence =
+      exec::iterate(std::views::all(values));
+    CHECK(sum_of(std::move(any_sequence)) == 999 * 1000 / 2);
+  }
+
+  TEST_CASE(
+    "any_sequence_of - recycles item operations that exceed the inline buffer",
+    "[sequence_senders][any_sequence_of]") {
+    using Completions = stdexec::completion_signatures<
+      stdexec::set_value_t(int&),
+      stdexec::set_error_t(std::exception_ptr),
+      stdexec::set_stopped_t()
+    >;
+    using receiver_ref = exec::basic_any_sequence_receiver_ref<Completions, 0>;
+    // Returns the allocations of the item pool while forwarding the given number of items.
+    auto count_allocations = [](int n_items) {
+      std::vector<int> values(static_cast<std::size_t>(n_items));
+      std::iota(values.begin(), values.end(), 0);
+      receiver_ref::any_sender<> any_sequence = exec::iterate(std::views::all(values));
+      int sum = 0;
+      allocation_counts counts;
+      auto sndr = stdexec::write_env(
+        exec::ignore_all_values(exec::transform_each(
+          std::move(any_sequence), stdexec::then([&](int value) { sum += value; }))),
+        stdexec::prop{stdexec::get_allocator, counting_allocator<std::byte>{&counts}});
+      CHECK(stdexec::sync_wait(std::move(sndr)));
+      CHECK(sum == n_items * (n_items - 1) / 2);
+      CHECK(counts.deallocated == counts.allocated);
+      return counts.allocated;
+    };
+    const int for_one_item = count_allocations(1);
+    CHECK(for_one_item > 0);
+    CHECK(count_allocations(1000) == for_one_item);
+  }
+#endif
 } // namespace
 
 STDEXEC_PRAGMA_POP()
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "exec/repeat_n.hpp"
+#include "exec/sequence/bounded_channel.hpp"
+#include "exec/sequence/ignore_all_values.hpp"
+#include "exec/sequence/transform_each.hpp"
+#include "exec/static_thread_pool.hpp"
+#include "stdexec/execution.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <test_common/receivers.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  TEST_CASE(
+    "bounded_channel - receive is a sequence sender",
+    "[sequence_senders][bounded_channel]") {
+    exec::bounded_channel<int, 4> channel;
+    using Sequence = decltype(channel.receive());
+    STATIC_REQUIRE(exec::sequence_sender_in<Sequence, ex::env<>>);
+    STATIC_REQUIRE(ex::sender_of<decltype(channel.send(1)), ex::set_value_t()>);
+  }
+
+  TEST_CASE(
+    "bounded_channel - buffered items are received in order",
+    "[sequence_senders][bounded_channel]") {
+    exec::bounded_channel<int, 4> channel;
+    CHECK(ex::sync_wait(channel.send(1)));
+    CHECK(ex::sync_wait(channel.send(2)));
+    CHECK(ex::sync_wait(channel.send(3)));
+    channel.close();
+
+    std::vector<int> items;
+    auto consumer = exec::ignore_all_values(
+      exec::transform_each(channel.receive(), ex::then([&](int value) { items.push_back(value); })));
+    CHECK(ex::sync_wait(std::move(consumer)));
+    CHECK(items == std::vector<int>{1, 2, 3});
+  }
+
+  TEST_CASE(
+    "bounded_channel - send suspends while the buffer is full",
+    "[sequence_senders][bounded_channel]") {
+    exec::bounded_channel<int, 1> channel;
+    CHECK(ex::sync_wait(channel.send(1)));
+
+    bool sent = false;
+    auto op = ex::connect(channel.send(2), expect_void_receiver{});
+    auto op2 = ex::connect(channel.send(3) | ex::then([&] { sent = true; }), expect_void_receiver{});
+    ex::start(op);
+    ex::start(op2);
+    CHECK_FALSE(sent);
+
+    std::vector<int> items;
+    auto consumer = exec::ignore_all_values(
+      exec::transform_each(channel.receive(), ex::then([&](int value) {
+                             items.push_back(value);
+                             if (value == 3) {
+                               channel.close();
+                             }
+                           })));
+    CHECK(ex::sync_wait(std::move(consumer)));
+    CHECK(sent);
+    CHECK(items == std::vector<int>{1, 2, 3});
+  }
+
+  TEST_CASE(
+    "bounded_channel - a waiting send completes with set_stopped when stop is requested",
+    "[sequence_senders][bounded_channel]") {
+    exec::bounded_channel<int, 1> channel;
+    CHECK(ex::sync_wait(channel.send(1)));
+
+    ex::inplace_stop_source stop_source;
+    auto env = ex::prop{ex::get_stop_token, stop_source.get_token()};
+    auto op = ex::connect(channel.send(2), expect_stopped_receiver{env});
+    ex::start(op);
+    stop_source.request_stop();
+    channel.close();
+  }
+
+  TEST_CASE(
+    "bounded_channel - send completes with set_stopped after close",
+    "[sequence_senders][bounded_channel]") {
+    exec::bounded_channel<int, 2> channel;
+    channel.close();
+    auto op = ex::connect(channel.send(42), expect_stopped_receiver{});
+    ex::start(op);
+  }
+
+  TEST_CASE(
+    "bounded_channel - a waiting receive completes with set_stopped when stop is requested",
+    "[sequence_senders][bounded_channel]") {
+    exec::bounded_channel<int, 2> channel;
+    ex::inplace_stop_source stop_source;
+    auto env = ex::prop{ex::get_stop_token, stop_source.get_token()};
+    auto op = ex::connect(exec::ignore_all_values(channel.receive()), expect_stopped_receiver{env});
+    ex::start(op);
+    stop_source.request_stop();
+  }
+
+  TEST_CASE(
+    "bounded_channel - a receive that is asked to stop takes no more buffered items",
+    "[sequence_senders][bounded_channel]") {
+    exec::bounded_channel<int, 4> channel;
+    for (int i = 0; i < 4; ++i) {
+      CHECK(ex::sync_wait(channel.send(i)));
+    }
+    ex::inplace_stop_source stop_source;
+    auto env = ex::prop{ex::get_stop_token, stop_source.get_token()};
+    int received = 0;
+    // The items themselves ignore the stop request, so only the channel can end the sequence.
+    auto take_item = ex::then([&](int) {
+      ++received;
+      stop_source.request_stop();
+    });
+    auto consumer = exec::ignore_all_values(exec::transform_each(
+      channel.receive(),
+      std::move(take_item) | ex::write_env(ex::prop{ex::get_stop_token, ex::never_stop_token{}})));
+    auto op = ex::connect(std::move(consumer), expect_stopped_receiver{env});
+    ex::start(op);
+    CHECK(received == 1);
+  }
+
+  TEST_CASE(
+    "bounded_channel - producers and consumers on a thread pool",
+    "[sequence_senders][bounded_channel]") {
+    constexpr int n_items = 1000;
+    exec::static_thread_pool pool{2};
+    exec::bounded_channel<int, 2> channel;
+
+    // Each producer is a chain of asynchronous sends on the pool. When the buffer is full a
+    // send suspends without blocking its pool thread and is resumed by the consumer.
+    int next[2] = {0, 1};
+    std::atomic<int> sent{0};
+    auto produce = [&](int first) {
+      return ex::starts_on(
+        pool.get_scheduler(),
+        exec::repeat_n(
+          ex::let_value(
+            ex::just(),
+            [&channel, &next, &sent, first] {
+              int value = next[first];
+              next[first] += 2;
+              return channel.send(value) | ex::then([&sent] { ++sent; });
+            }),
+          n_items / 2));
+    };
+
+    auto producers = ex::ensure_started(
+      ex::when_all(produce(0), produce(1)) | ex::then([&] { channel.close(); }));
+
+    // With no consumer yet, the producers fill the buffer and then suspend. The pool threads
+    // stay free to run other work meanwhile.
+    while (sent.load() < 2) {
+      std::this_thread::yield();
+    }
+    CHECK(ex::sync_wait(ex::schedule(pool.get_scheduler())));
+    CHECK(sent.load() == 2);
+
+    std::atomic<long> sum{0};
+    auto consume = exec::ignore_all_values(
+      exec::transform_each(channel.receive(), ex::then([&](int value) { sum += value; })));
+
+    CHECK(ex::sync_wait(ex::when_all(std::move(producers), std::move(consume))));
+    CHECK(sent.load() == n_items);
+    CHECK(sum == static_cast<long>(n_items) * (n_items - 1) / 2);
+  }
+} // namespace
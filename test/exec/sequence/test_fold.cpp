@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "exec/sequence/fold.hpp"
+#include "exec/sequence/empty_sequence.hpp"
+#include "exec/sequence/iterate.hpp"
+#include "exec/sequence/parallel_iterate.hpp"
+#include "exec/sequence/transform_each.hpp"
+#include "exec/static_thread_pool.hpp"
+#include "stdexec/execution.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+  TEST_CASE("fold - empty sequence completes with init", "[sequence_senders][fold]") {
+    auto sndr = exec::fold(exec::empty_sequence(), 42, std::plus<>{});
+    STATIC_REQUIRE(stdexec::sender_of<decltype(sndr), stdexec::set_value_t(int)>);
+    auto [result] = stdexec::sync_wait(std::move(sndr)).value();
+    CHECK(result == 42);
+  }
+
+#if STDEXEC_HAS_STD_RANGES()
+  TEST_CASE("fold - combines items in order", "[sequence_senders][fold]") {
+    std::vector<int> values{1, 2, 3, 4};
+    auto sndr = exec::iterate(std::views::all(values))
+              | exec::fold(std::string{}, [](std::string acc, int value) {
+                  return std::move(acc) + std::to_string(value);
+                });
+    auto [result] = stdexec::sync_wait(std::move(sndr)).value();
+    CHECK(result == "1234");
+  }
+
+  TEST_CASE("fold - an exception from the function is reported as an error", "[sequence_senders][fold]") {
+    std::vector<int> values{1, 2, 3};
+    auto sndr = exec::fold(exec::iterate(std::views::all(values)), 0, [](int acc, int value) {
+      if (value == 2) {
+        throw std::runtime_error("fold");
+      }
+      return acc + value;
+    });
+    CHECK_THROWS_AS(stdexec::sync_wait(std::move(sndr)), std::runtime_error);
+  }
+
+  TEST_CASE("fold - a stopped item stops the fold", "[sequence_senders][fold]") {
+    std::vector<int> values{1, 2, 3};
+    auto sndr = exec::fold(
+      exec::transform_each(
+        exec::iterate(std::views::all(values)),
+        stdexec::let_value([](int) { return stdexec::just_stopped(); })),
+      0,
+      std::plus<>{});
+    CHECK_FALSE(stdexec::sync_wait(std::move(sndr)));
+  }
+
+  TEST_CASE("reduce_each - sums a sequence", "[sequence_senders][reduce_each]") {
+    std::vector<int> values(100);
+    std::iota(values.begin(), values.end(), 1);
+    auto sndr = exec::reduce_each(exec::iterate(std::views::all(values)), 10, std::plus<>{});
+    auto [result] = stdexec::sync_wait(std::move(sndr)).value();
+    CHECK(result == 10 + 100 * 101 / 2);
+  }
+
+  TEST_CASE(
+    "reduce_each - combines concurrent items from a thread pool",
+    "[sequence_senders][reduce_each]") {
+    exec::static_thread_pool pool{4};
+    std::vector<long> values(100'000);
+    std::iota(values.begin(), values.end(), 0L);
+    auto sndr = exec::parallel_iterate(std::views::all(values), pool.get_scheduler(), 128)
+              | exec::reduce_each(0L, std::plus<>{});
+    auto [result] = stdexec::sync_wait(std::move(sndr)).value();
+    CHECK(result == 99'999L * 100'000L / 2);
+  }
+#endif
+} // namespace
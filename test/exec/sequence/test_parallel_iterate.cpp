@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "exec/sequence/parallel_iterate.hpp"
+#include "exec/sequence/ignore_all_values.hpp"
+#include "exec/sequence/transform_each.hpp"
+#include "exec/inline_scheduler.hpp"
+#include "exec/static_thread_pool.hpp"
+#include "stdexec/execution.hpp"
+
+#if STDEXEC_HAS_STD_RANGES()
+
+#  include <catch2/catch.hpp>
+
+#  include <atomic>
+#  include <numeric>
+#  include <thread>
+#  include <vector>
+
+namespace {
+
+  TEST_CASE(
+    "parallel_iterate - is a sequence sender",
+    "[sequence_senders][parallel_iterate]") {
+    std::vector<int> values(10);
+    auto seq = exec::parallel_iterate(std::views::all(values), exec::inline_scheduler{});
+    STATIC_REQUIRE(exec::sequence_sender_in<decltype(seq), stdexec::env<>>);
+  }
+
+  TEST_CASE(
+    "parallel_iterate - visits every element on an inline scheduler",
+    "[sequence_senders][parallel_iterate]") {
+    std::vector<int> values(100);
+    std::iota(values.begin(), values.end(), 0);
+    int sum = 0;
+    auto sndr = exec::ignore_all_values(exec::transform_each(
+      exec::parallel_iterate(std::views::all(values), exec::inline_scheduler{}, 7),
+      stdexec::then([&](int value) { sum += value; })));
+    CHECK(stdexec::sync_wait(std::move(sndr)));
+    CHECK(sum == 99 * 100 / 2);
+  }
+
+  TEST_CASE(
+    "parallel_iterate - an empty range completes immediately",
+    "[sequence_senders][parallel_iterate]") {
+    std::vector<int> values;
+    exec::static_thread_pool pool{2};
+    auto sndr = exec::ignore_all_values(
+      exec::parallel_iterate(std::views::all(values), pool.get_scheduler()));
+    CHECK(stdexec::sync_wait(std::move(sndr)));
+  }
+
+  TEST_CASE(
+    "parallel_iterate - processes chunks concurrently on a static_thread_pool",
+    "[sequence_senders][parallel_iterate]") {
+    exec::static_thread_pool pool{4};
+    std::vector<int> values(10'000);
+    std::iota(values.begin(), values.end(), 0);
+    std::vector<std::atomic<int>> visited(values.size());
+    std::atomic<long> sum{0};
+    auto sndr = exec::ignore_all_values(exec::transform_each(
+      exec::parallel_iterate(std::views::all(values), pool.get_scheduler(), 64),
+      stdexec::then([&](int& value) {
+        sum += value;
+        visited[static_cast<std::size_t>(value)] += 1;
+      })));
+    CHECK(stdexec::sync_wait(std::move(sndr)));
+    CHECK(sum == 9'999L * 10'000L / 2);
+    CHECK(std::ranges::all_of(visited, [](const std::atomic<int>& n) { return n == 1; }));
+  }
+
+  TEST_CASE(
+    "parallel_iterate - a stopped item ends the sequence",
+    "[sequence_senders][parallel_iterate]") {
+    exec::static_thread_pool pool{2};
+    std::vector<int> values(1'000);
+    std::iota(values.begin(), values.end(), 0);
+    std::atomic<int> count{0};
+    auto sndr = exec::ignore_all_values(exec::transform_each(
+      exec::parallel_iterate(std::views::all(values), pool.get_scheduler(), 1),
+      stdexec::let_value([&](int) {
+        count += 1;
+        return stdexec::just_stopped();
+      })));
+    CHECK_FALSE(stdexec::sync_wait(std::move(sndr)));
+    CHECK(count < 1'000);
+  }
+} // namespace
+
+#endif // STDEXEC_HAS_STD_RANGES()
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "exec/sequence/window.hpp"
+#include "exec/sequence/ignore_all_values.hpp"
+#include "exec/sequence/iterate.hpp"
+#include "exec/sequence/transform_each.hpp"
+#include "exec/timed_thread_scheduler.hpp"
+#include "stdexec/execution.hpp"
+
+#if STDEXEC_HAS_STD_RANGES()
+
+#  include <catch2/catch.hpp>
+
+#  include <array>
+#  include <chrono>
+#  include <mutex>
+#  include <numeric>
+#  include <vector>
+
+namespace {
+  constexpr auto plus = [](int acc, int value) {
+    return acc + value;
+  };
+
+  template <class _Sequence>
+  auto collect(_Sequence&& seq) -> std::vector<int> {
+    std::vector<int> windows;
+    std::mutex mutex;
+    auto sndr = exec::ignore_all_values(exec::transform_each(
+      static_cast<_Sequence&&>(seq), stdexec::then([&](int window) {
+        std::lock_guard guard{mutex};
+        windows.push_back(window);
+      })));
+    CHECK(stdexec::sync_wait(std::move(sndr)));
+    return windows;
+  }
+
+  TEST_CASE("window_by_count - is a sequence sender", "[sequence_senders][window]") {
+    std::array<int, 3> values{1, 2, 3};
+    auto seq = exec::window_by_count(exec::iterate(std::views::all(values)), 2, 0, plus);
+    STATIC_REQUIRE(exec::sequence_sender_in<decltype(seq), stdexec::env<>>);
+  }
+
+  TEST_CASE("window_by_count - tumbling windows", "[sequence_senders][window]") {
+    std::array<int, 6> values{1, 2, 3, 4, 5, 6};
+    auto windows = collect(exec::window_by_count(exec::iterate(std::views::all(values)), 2, 0, plus));
+    CHECK(windows == std::vector<int>{3, 7, 11});
+  }
+
+  TEST_CASE("window_by_count - a partial trailing window is flushed", "[sequence_senders][window]") {
+    std::array<int, 5> values{1, 2, 3, 4, 5};
+    auto windows = collect(
+      exec::iterate(std::views::all(values)) | exec::window_by_count(3, 0, plus));
+    CHECK(windows == std::vector<int>{6, 9});
+  }
+
+  TEST_CASE("window_by_count - sliding windows", "[sequence_senders][window]") {
+    std::array<int, 5> values{1, 2, 3, 4, 5};
+    auto windows = collect(
+      exec::window_by_count(exec::iterate(std::views::all(values)), 3, 1, 0, plus));
+    // Full windows close in order, the open windows are flushed oldest first.
+    CHECK(windows == std::vector<int>{6, 9, 12, 9, 5});
+  }
+
+  TEST_CASE("window_by_count - an empty sequence emits no window", "[sequence_senders][window]") {
+    std::vector<int> values;
+    auto windows = collect(exec::window_by_count(exec::iterate(std::views::all(values)), 2, 0, plus));
+    CHECK(windows.empty());
+  }
+
+  TEST_CASE("window_by_count - a stopped window ends the sequence", "[sequence_senders][window]") {
+    std::array<int, 6> values{1, 2, 3, 4, 5, 6};
+    int count = 0;
+    auto sndr = exec::ignore_all_values(exec::transform_each(
+      exec::window_by_count(exec::iterate(std::views::all(values)), 2, 0, plus),
+      stdexec::let_value([&](int) {
+        ++count;
+        return stdexec::just_stopped();
+      })));
+    CHECK_FALSE(stdexec::sync_wait(std::move(sndr)));
+    CHECK(count == 1);
+  }
+
+  TEST_CASE("window_by_time - windows span the items of each period", "[sequence_senders][window]") {
+    using namespace std::chrono_literals;
+    exec::timed_thread_context context;
+    auto sched = context.get_scheduler();
+    std::array<int, 6> values{1, 2, 3, 4, 5, 6};
+    auto delayed = exec::transform_each(
+      exec::iterate(std::views::all(values)), stdexec::let_value([sched](int value) {
+        return exec::schedule_after(sched, 5ms) | stdexec::then([value] { return value; });
+      }));
+    auto windows = collect(exec::window_by_time(std::move(delayed), sched, 10ms, 0, plus));
+    CHECK(!windows.empty());
+    CHECK(std::accumulate(windows.begin(), windows.end(), 0) == 21);
+  }
+
+  TEST_CASE("window_by_time - a fast sequence is flushed on completion", "[sequence_senders][window]") {
+    using namespace std::chrono_literals;
+    exec::timed_thread_context context;
+    std::array<int, 4> values{1, 2, 3, 4};
+    auto windows = collect(
+      exec::iterate(std::views::all(values))
+      | exec::window_by_time(context.get_scheduler(), 1h, 30min, 0, plus));
+    CHECK(windows == std::vector<int>{10});
+  }
+} // namespace
+
+#endif // STDEXEC_HAS_STD_RANGES()
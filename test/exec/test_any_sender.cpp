@@ -21,11 +21,14 @@
 #include <exec/static_thread_pool.hpp>
 #include <stdexec/stop_token.hpp>
 
+#include <test_common/allocators.hpp>
 #include <test_common/schedulers.hpp>
 #include <test_common/receivers.hpp>
 
 #include <catch2/catch.hpp>
 
+#include <array>
+
 using namespace stdexec;
 using namespace exec;
 
@@ -767,4 +770,159 @@ namespace {
     }
     CHECK(counting_scheduler::count == 0);
   }
+
+  ///////////////////////////////////////////////////////////////////////////////
+  //                                                        any_sender_storage
+
+  allocation_counts storage_counts;
+
+  template <class T>
+  using storage_counting_allocator = bound_counting_allocator<T, &storage_counts>;
+
+  template <class Storage>
+  using storage_sender_of =
+    basic_any_receiver_ref<completion_signatures<set_value_t()>, Storage>::template any_sender<>;
+
+  auto make_big_sender(int& value) {
+    return just() | then([&value, payload = std::array<int, 32>{42}]() noexcept {
+             value = payload[0];
+           });
+  }
+
+  TEST_CASE(
+    "any_sender allocates what does not fit inline with the storage's allocator",
+    "[types][any_sender]") {
+    using storage_t =
+      any_sender_storage<3 * sizeof(void*), 6 * sizeof(void*), storage_counting_allocator<int>>;
+    storage_counts = {};
+    int value = 0;
+    {
+      storage_sender_of<storage_t> sender = make_big_sender(value);
+      CHECK(storage_counts.allocated == 1);
+      sync_wait(std::move(sender));
+      CHECK(storage_counts.allocated == 2);
+    }
+    CHECK(value == 42);
+    CHECK(storage_counts.deallocated == 2);
+  }
+
+  TEST_CASE(
+    "any_sender stores the sender and operation inline when they fit",
+    "[types][any_sender]") {
+    using storage_t = any_sender_storage<256, 512, storage_counting_allocator<int>>;
+    storage_counts = {};
+    int value = 0;
+    storage_sender_of<storage_t> sender = make_big_sender(value);
+    sync_wait(std::move(sender));
+    CHECK(value == 42);
+    CHECK(storage_counts.allocated == 0);
+  }
+
+  TEST_CASE("recycling_allocator reuses the block it was given back", "[types][any_sender]") {
+    recycling_allocator<std::byte> alloc;
+    std::byte* first = alloc.allocate(200);
+    alloc.deallocate(first, 200);
+    std::byte* second = alloc.allocate(180);
+    CHECK(first == second);
+    alloc.deallocate(second, 180);
+  }
+
+  TEST_CASE(
+    "any_sender with recycling storage can be connected repeatedly",
+    "[types][any_sender]") {
+    for (int i = 0; i < 10; ++i) {
+      int value = 0;
+      storage_sender_of<recycling_any_sender_storage<>> sender = make_big_sender(value);
+      sync_wait(std::move(sender));
+      CHECK(value == 42);
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////////
+  //                                                   any_sender::with_fast_types
+
+  using big_sender_t = decltype(make_big_sender(std::declval<int&>()));
+
+  template <class... Fast>
+  using fast_sender_of = storage_sender_of<
+    any_sender_storage<3 * sizeof(void*), 6 * sizeof(void*), storage_counting_allocator<int>>
+  >::with_fast_types<Fast...>;
+
+  TEST_CASE("any_sender::with_fast_types stores fast senders unerased", "[types][any_sender]") {
+    STATIC_REQUIRE(sender<fast_sender_of<big_sender_t>>);
+    STATIC_REQUIRE(std::is_nothrow_move_constructible_v<fast_sender_of<big_sender_t>>);
+    storage_counts = {};
+    int value = 0;
+    fast_sender_of<big_sender_t> sender = make_big_sender(value);
+    fast_sender_of<big_sender_t> moved = std::move(sender);
+    sync_wait(std::move(moved));
+    CHECK(value == 42);
+    CHECK(storage_counts.allocated == 0);
+  }
+
+  TEST_CASE(
+    "any_sender::with_fast_types type-erases senders of other types",
+    "[types][any_sender]") {
+    storage_counts = {};
+    int value = 0;
+    {
+      fast_sender_of<decltype(just())> sender = make_big_sender(value);
+      sync_wait(std::move(sender));
+    }
+    CHECK(value == 42);
+    CHECK(storage_counts.allocated == 2);
+    CHECK(storage_counts.deallocated == 2);
+  }
+
+  struct addressed_sender {
+    using sender_concept = stdexec::sender_t;
+    using completion_signatures = stdexec::completion_signatures<set_value_t(int)>;
+
+    template <class Receiver>
+    auto connect(Receiver rcvr) const {
+      return stdexec::connect(just(value), std::move(rcvr));
+    }
+
+    [[nodiscard]]
+    auto get_env() const noexcept -> env {
+      return {.object_ = this};
+    }
+
+    int value;
+  };
+
+  TEST_CASE("any_sender::with_fast_types forwards sender queries", "[types][any_sender]") {
+    using sender_t = any_receiver_ref<completion_signatures<set_value_t(int)>>::any_sender<
+      get_address.signature<const void*() noexcept>
+    >::with_fast_types<addressed_sender>;
+    sender_t sender = addressed_sender{42};
+    CHECK(get_address(stdexec::get_env(sender)) != nullptr);
+    auto [value] = sync_wait(std::move(sender)).value();
+    CHECK(value == 42);
+  }
+
+  // Sends whether its receiver's stop token is an inplace_stop_token.
+  struct stop_token_type_sender {
+    using sender_concept = stdexec::sender_t;
+    using completion_signatures = stdexec::completion_signatures<set_value_t(bool)>;
+
+    template <class Receiver>
+    auto connect(Receiver rcvr) const {
+      using token_t = stdexec::stop_token_of_t<stdexec::env_of_t<Receiver>>;
+      return stdexec::connect(just(std::same_as<token_t, inplace_stop_token>), std::move(rcvr));
+    }
+  };
+
+  TEST_CASE(
+    "any_sender::with_fast_types gives fast senders the environment of erased ones",
+    "[types][any_sender]") {
+    using receiver_ref = any_receiver_ref<completion_signatures<set_value_t(bool)>>;
+    using erased_t = receiver_ref::any_sender<>;
+    using fast_t = erased_t::with_fast_types<stop_token_type_sender>;
+    // The receiver's own stop token is a never_stop_token.
+    auto erased = connect(erased_t{stop_token_type_sender{}}, expect_value_receiver{true});
+    start(erased);
+    auto fast = connect(fast_t{stop_token_type_sender{}}, expect_value_receiver{true});
+    start(fast);
+  }
 } // namespace
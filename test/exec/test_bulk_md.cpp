@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exec/bulk_md.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <stdexec/execution.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace ex = stdexec;
+
+namespace {
+
+  TEST_CASE("exec::mdshape deduces its rank", "[adaptors][bulk]") {
+    exec::mdshape shape{3, 4};
+    STATIC_REQUIRE(decltype(shape)::rank() == 2);
+    CHECK(shape.extent(0) == 3);
+    CHECK(shape.extent(1) == 4);
+    CHECK(shape.size() == 12);
+  }
+
+  TEST_CASE("exec::bulk_md visits every index once", "[adaptors][bulk]") {
+    exec::static_thread_pool pool{4};
+    for (auto [rows, cols]: {std::array<std::size_t, 2>{0, 5},
+                             std::array<std::size_t, 2>{1, 1},
+                             std::array<std::size_t, 2>{7, 3},
+                             std::array<std::size_t, 2>{100, 37},
+                             std::array<std::size_t, 2>{5, 300}}) {
+      std::vector<std::atomic<int>> hits(rows * cols);
+      auto sndr = ex::schedule(pool.get_scheduler())
+                | exec::bulk_md(
+                    ex::par, exec::mdshape{rows, cols}, [&](std::size_t i, std::size_t j) {
+                      ++hits[i * cols + j];
+                    });
+      ex::sync_wait(std::move(sndr));
+      for (auto& h: hits) {
+        CHECK(h.load() == 1);
+      }
+    }
+  }
+
+  TEST_CASE("exec::bulk_md walks a tile's last dimension fastest", "[adaptors][bulk]") {
+    std::vector<std::array<int, 2>> order;
+    auto sndr = exec::bulk_md(
+      ex::just(),
+      ex::seq,
+      exec::mdshape{4, 4},
+      exec::mdshape{2, 2},
+      [&](int i, int j) { order.push_back({i, j}); });
+    ex::sync_wait(std::move(sndr));
+
+    // Tiles in Z order, each tile row by row.
+    const std::vector<std::array<int, 2>> expected{
+      {0, 0}, {0, 1}, {1, 0}, {1, 1}, // tile (0, 0)
+      {0, 2}, {0, 3}, {1, 2}, {1, 3}, // tile (0, 1)
+      {2, 0}, {2, 1}, {3, 0}, {3, 1}, // tile (1, 0)
+      {2, 2}, {2, 3}, {3, 2}, {3, 3}, // tile (1, 1)
+    };
+    CHECK(order == expected);
+  }
+
+  TEST_CASE("exec::bulk_md handles three dimensions and ragged tiles", "[adaptors][bulk]") {
+    exec::static_thread_pool pool{4};
+    constexpr std::size_t nx = 9, ny = 5, nz = 13;
+    std::vector<std::atomic<int>> hits(nx * ny * nz);
+    auto sndr = ex::schedule(pool.get_scheduler())
+              | exec::bulk_md(
+                  ex::par,
+                  exec::mdshape{nx, ny, nz},
+                  exec::mdshape{4, 2, 3},
+                  [&](std::size_t x, std::size_t y, std::size_t z) {
+                    ++hits[(x * ny + y) * nz + z];
+                  });
+    ex::sync_wait(std::move(sndr));
+    for (auto& h: hits) {
+      CHECK(h.load() == 1);
+    }
+  }
+
+  TEST_CASE("exec::bulk_md passes the predecessor's values", "[adaptors][bulk]") {
+    exec::static_thread_pool pool{4};
+    auto sndr = ex::transfer_just(pool.get_scheduler(), std::vector<int>(6 * 8))
+              | exec::bulk_md(
+                  ex::par, exec::mdshape{6, 8}, [](int i, int j, std::vector<int>& m) {
+                    m[static_cast<std::size_t>(i * 8 + j)] = i * 10 + j;
+                  });
+    auto [m] = ex::sync_wait(std::move(sndr)).value();
+    for (int i = 0; i < 6; ++i) {
+      for (int j = 0; j < 8; ++j) {
+        CHECK(m[static_cast<std::size_t>(i * 8 + j)] == i * 10 + j);
+      }
+    }
+  }
+} // namespace
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exec/bulk_simd.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <stdexec/execution.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace ex = stdexec;
+
+namespace {
+
+  // Records every index it is called for, and checks that full batches are aligned.
+  struct record_batches {
+    std::vector<std::atomic<int>>* visits_;
+    std::atomic<int>* misaligned_;
+
+    template <std::size_t Width>
+    void operator()(std::size_t i, std::integral_constant<std::size_t, Width>) const noexcept {
+      if (Width != 1 && i % Width != 0) {
+        misaligned_->fetch_add(1);
+      }
+      for (std::size_t j = 0; j < Width; ++j) {
+        (*visits_)[i + j].fetch_add(1);
+      }
+    }
+  };
+
+  TEST_CASE("bulk_simd visits every index exactly once", "[adaptors][bulk_simd]") {
+    for (std::size_t n: {0u, 1u, 7u, 8u, 9u, 100u}) {
+      std::vector<std::atomic<int>> visits(n);
+      std::atomic<int> misaligned{0};
+      auto sndr = ex::just()
+                | exec::bulk_simd<8>(ex::par_unseq, n, record_batches{&visits, &misaligned});
+      ex::sync_wait(std::move(sndr));
+      for (auto& v: visits) {
+        CHECK(v.load() == 1);
+      }
+      CHECK(misaligned.load() == 0);
+    }
+  }
+
+  TEST_CASE("bulk_simd forwards values to the function", "[adaptors][bulk_simd]") {
+    std::vector<int> out(20, 0);
+    auto sndr = ex::just(3)
+              | exec::bulk_simd<4>(ex::unseq, out.size(), [&](std::size_t i, auto width, int k) {
+                  for (std::size_t j = 0; j < width; ++j) {
+                    out[i + j] = k;
+                  }
+                });
+    auto [k] = ex::sync_wait(std::move(sndr)).value();
+    CHECK(k == 3);
+    CHECK(std::count(out.begin(), out.end(), 3) == 20);
+  }
+
+  TEST_CASE("bulk_simd runs in parallel on the static_thread_pool", "[adaptors][bulk_simd]") {
+    exec::static_thread_pool pool{4};
+    constexpr std::size_t n = 1003;
+    std::vector<std::atomic<int>> visits(n);
+    std::atomic<int> misaligned{0};
+    auto sndr = ex::schedule(pool.get_scheduler())
+              | exec::bulk_simd<16>(ex::par_unseq, n, record_batches{&visits, &misaligned});
+    ex::sync_wait(std::move(sndr));
+    for (auto& v: visits) {
+      CHECK(v.load() == 1);
+    }
+    CHECK(misaligned.load() == 0);
+  }
+
+#if !STDEXEC_STD_NO_EXCEPTIONS()
+  TEST_CASE("bulk_simd reports exceptions thrown by the function", "[adaptors][bulk_simd]") {
+    auto sndr = ex::just()
+              | exec::bulk_simd<4>(ex::par, 10, [](std::size_t, auto) {
+                  throw std::logic_error{""};
+                });
+    CHECK_THROWS_AS(ex::sync_wait(std::move(sndr)), std::logic_error);
+  }
+#endif
+
+  TEST_CASE("unsequenced bulk visits every index exactly once", "[adaptors][bulk_simd]") {
+    exec::static_thread_pool pool{4};
+    std::vector<float> x(1000, 1.0f);
+    std::vector<float> y(1000, 2.0f);
+    auto saxpy = [a = 3.0f, px = x.data(), py = y.data()](std::size_t i) {
+      py[i] = a * px[i] + py[i];
+    };
+    ex::sync_wait(ex::schedule(pool.get_scheduler()) | ex::bulk(ex::par_unseq, x.size(), saxpy));
+    ex::sync_wait(ex::just() | ex::bulk(ex::unseq, x.size(), saxpy));
+    CHECK(std::count(y.begin(), y.end(), 8.0f) == 1000);
+  }
+} // namespace
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exec/bulk_with_state.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <stdexec/execution.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ex = stdexec;
+
+namespace {
+
+  using histogram = std::array<std::size_t, 8>;
+
+  auto make_histogram() -> histogram {
+    return {};
+  }
+
+  void merge_histograms(histogram& into, histogram&& from) {
+    for (std::size_t i = 0; i < into.size(); ++i) {
+      into[i] += from[i];
+    }
+  }
+
+  TEST_CASE("exec::bulk_with_state builds a histogram on a thread pool", "[adaptors][bulk]") {
+    exec::static_thread_pool pool{4};
+    std::vector<int> input(10'000);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+      input[i] = static_cast<int>((i * 7) % 8);
+    }
+
+    auto sndr = ex::transfer_just(pool.get_scheduler(), input)
+              | exec::bulk_with_state(
+                  ex::par,
+                  input.size(),
+                  make_histogram,
+                  [](std::size_t i, histogram& h, const std::vector<int>& in) {
+                    ++h[static_cast<std::size_t>(in[i])];
+                  },
+                  merge_histograms);
+    auto [result] = ex::sync_wait(std::move(sndr)).value();
+
+    histogram expected{};
+    for (int x: input) {
+      ++expected[static_cast<std::size_t>(x)];
+    }
+    CHECK(result == expected);
+  }
+
+  TEST_CASE("exec::bulk_with_state creates at most one state per block", "[adaptors][bulk]") {
+    exec::static_thread_pool pool{4};
+    std::atomic<int> states{0};
+    auto sndr = ex::schedule(pool.get_scheduler())
+              | exec::bulk_with_state(
+                  ex::par,
+                  3,
+                  [&] {
+                    ++states;
+                    return 0;
+                  },
+                  [](int, int& count) { ++count; },
+                  [](int& into, int&& from) { into += from; });
+    auto [count] = ex::sync_wait(std::move(sndr)).value();
+    CHECK(count == 3);
+    CHECK(states.load() >= 1);
+    CHECK(states.load() <= 3);
+  }
+
+  TEST_CASE("exec::bulk_with_state merges states in order", "[adaptors][bulk]") {
+    exec::static_thread_pool pool{4};
+    auto sndr = ex::transfer_just(pool.get_scheduler(), std::string{"abcdefghijk"})
+              | exec::bulk_with_state(
+                  ex::par,
+                  11,
+                  [] { return std::string{}; },
+                  [](int i, std::string& s, const std::string& in) {
+                    s += in[static_cast<std::size_t>(i)];
+                  },
+                  [](std::string& into, std::string&& from) { into += from; });
+    auto [joined] = ex::sync_wait(std::move(sndr)).value();
+    CHECK(joined == "abcdefghijk");
+  }
+
+  TEST_CASE("exec::bulk_with_state with an empty shape", "[adaptors][bulk]") {
+    int calls = 0;
+    auto sndr = exec::bulk_with_state(
+      ex::just(),
+      ex::seq,
+      0,
+      [] { return 42; },
+      [&](int, int&) { ++calls; },
+      [](int& into, int&& from) { into += from; });
+    auto [result] = ex::sync_wait(std::move(sndr)).value();
+    CHECK(result == 42);
+    CHECK(calls == 0);
+  }
+
+  TEST_CASE("exec::bulk_with_state works without a parallel scheduler", "[adaptors][bulk]") {
+    auto sndr = ex::just(std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10})
+              | exec::bulk_with_state(
+                  ex::seq,
+                  10,
+                  [] { return 0L; },
+                  [](int i, long& sum, const std::vector<int>& in) {
+                    sum += in[static_cast<std::size_t>(i)];
+                  },
+                  [](long& into, long&& from) { into += from; });
+    auto [sum] = ex::sync_wait(std::move(sndr)).value();
+    CHECK(sum == 55);
+  }
+
+  TEST_CASE("exec::bulk_with_state accepts mutable callables", "[adaptors][bulk]") {
+    auto with_mutable_callables = [](auto sndr) {
+      return std::move(sndr)
+           | exec::bulk_with_state(
+               ex::par,
+               4,
+               [made = 0]() mutable { return made++; },
+               [seen = 0](int, int& state) mutable { state += ++seen; },
+               [](int& into, int&& from) { into += from; });
+    };
+    auto [sum] = ex::sync_wait(with_mutable_callables(ex::just())).value();
+    CHECK(sum == 1 + 2 + 3 + 4);
+
+    exec::static_thread_pool pool{2};
+    CHECK(ex::sync_wait(with_mutable_callables(ex::schedule(pool.get_scheduler()))));
+  }
+
+  TEST_CASE("exec::bulk_with_state reports exceptions from the function", "[adaptors][bulk]") {
+    exec::static_thread_pool pool{4};
+    auto sndr = ex::schedule(pool.get_scheduler())
+              | exec::bulk_with_state(
+                  ex::par,
+                  100,
+                  [] { return 0; },
+                  [](int i, int&) {
+                    if (i == 57) {
+                      throw std::runtime_error("57");
+                    }
+                  },
+                  [](int& into, int&& from) { into += from; });
+    CHECK_THROWS_AS(ex::sync_wait(std::move(sndr)), std::runtime_error);
+  }
+} // namespace
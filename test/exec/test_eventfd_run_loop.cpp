@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if __has_include(<sys/eventfd.h>)
+
+#  include "exec/linux/eventfd_run_loop.hpp"
+
+#  include "catch2/catch.hpp"
+
+#  include <atomic>
+#  include <optional>
+#  include <thread>
+
+#  include <poll.h>
+
+namespace ex = stdexec;
+
+namespace {
+
+  auto is_readable(int fd, int timeout_ms = 0) -> bool {
+    ::pollfd pfd{.fd = fd, .events = POLLIN, .revents = 0};
+    return ::poll(&pfd, 1, timeout_ms) == 1 && (pfd.revents & POLLIN);
+  }
+
+  TEST_CASE("eventfd_run_loop - the descriptor signals scheduled work", "[eventfd_run_loop]") {
+    exec::eventfd_run_loop loop;
+    CHECK_FALSE(is_readable(loop.native_handle()));
+
+    int count = 0;
+    ex::start_detached(ex::then(ex::schedule(loop.get_scheduler()), [&] { ++count; }));
+    CHECK(is_readable(loop.native_handle()));
+    CHECK(count == 0);
+
+    CHECK(loop.run_some() == 1);
+    CHECK(count == 1);
+    CHECK_FALSE(is_readable(loop.native_handle()));
+    CHECK_FALSE(loop.run_one());
+  }
+
+  TEST_CASE("eventfd_run_loop - finish signals the descriptor", "[eventfd_run_loop]") {
+    exec::eventfd_run_loop loop;
+    loop.finish();
+    CHECK(is_readable(loop.native_handle()));
+  }
+
+  TEST_CASE("eventfd_run_loop - can be driven by poll", "[eventfd_run_loop]") {
+    constexpr int num_tasks = 10000;
+    exec::eventfd_run_loop loop;
+    std::atomic<bool> done{false};
+    int count = 0;
+
+    std::thread producer{[&] {
+      for (int i = 0; i < num_tasks; ++i) {
+        ex::start_detached(ex::then(ex::schedule(loop.get_scheduler()), [&] {
+          if (++count == num_tasks) {
+            done.store(true);
+          }
+        }));
+      }
+    }};
+
+    while (!done.load()) {
+      if (is_readable(loop.native_handle(), 1000)) {
+        loop.run_some(64);
+      }
+    }
+    producer.join();
+    CHECK(count == num_tasks);
+  }
+
+  TEST_CASE(
+    "eventfd_run_loop - can be destroyed while a producer is still signalling it",
+    "[eventfd_run_loop]") {
+    for (int iteration = 0; iteration < 100; ++iteration) {
+      std::optional<exec::eventfd_run_loop> loop{std::in_place};
+      std::atomic<bool> done{false};
+
+      // The task may run before the producer returns from start_detached, and the loop is
+      // destroyed as soon as it has.
+      std::thread producer{[&] {
+        ex::start_detached(
+          ex::then(ex::schedule(loop->get_scheduler()), [&] { done.store(true); }));
+      }};
+
+      while (!done.load()) {
+        if (is_readable(loop->native_handle(), 1000)) {
+          loop->run_some();
+        }
+      }
+      loop.reset();
+      producer.join();
+    }
+  }
+} // namespace
+
+#endif
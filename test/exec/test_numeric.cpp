@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exec/numeric.hpp>
+#include <exec/sequence/fold.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <stdexec/execution.hpp>
+
+#include <catch2/catch.hpp>
+
+#if STDEXEC_HAS_STD_RANGES()
+
+#  include <functional>
+#  include <numeric>
+#  include <span>
+#  include <stdexcept>
+#  include <string>
+#  include <vector>
+
+namespace ex = stdexec;
+
+namespace {
+
+  auto iota_vector(std::size_t n) -> std::vector<long> {
+    std::vector<long> v(n);
+    std::iota(v.begin(), v.end(), 1L);
+    return v;
+  }
+
+  TEST_CASE("exec::reduce sums a range", "[adaptors][numeric]") {
+    exec::static_thread_pool pool{4};
+    for (std::size_t n: {0u, 1u, 3u, 4u, 5u, 1000u}) {
+      auto input = iota_vector(n);
+      auto sndr = ex::transfer_just(pool.get_scheduler(), std::span{input}) | exec::reduce(10L);
+      auto [sum] = ex::sync_wait(std::move(sndr)).value();
+      CHECK(sum == std::accumulate(input.begin(), input.end(), 10L));
+    }
+  }
+
+  TEST_CASE("exec::reduce combines blocks in order", "[adaptors][numeric]") {
+    exec::static_thread_pool pool{4};
+    std::vector<std::string> words{"a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k"};
+    auto sndr = ex::transfer_just(pool.get_scheduler(), std::span{words})
+              | exec::reduce(std::string{">"});
+    auto [joined] = ex::sync_wait(std::move(sndr)).value();
+    CHECK(joined == ">abcdefghijk");
+  }
+
+  TEST_CASE("exec::reduce works without a parallel scheduler", "[adaptors][numeric]") {
+    auto sndr = ex::just(iota_vector(20)) | exec::reduce(1.0, std::multiplies<>{});
+    auto [product] = ex::sync_wait(std::move(sndr)).value();
+    auto input = iota_vector(20);
+    CHECK(product == std::accumulate(input.begin(), input.end(), 1.0, std::multiplies<>{}));
+  }
+
+  TEST_CASE("exec::reduce agrees with the sequence exec::reduce_each", "[adaptors][numeric]") {
+    auto input = iota_vector(100);
+    auto [range_sum] = ex::sync_wait(ex::just(std::span{input}) | exec::reduce(0L)).value();
+    auto [sequence_sum] =
+      ex::sync_wait(exec::reduce_each(exec::iterate(std::views::all(input)), 0L, std::plus<>{}))
+        .value();
+    CHECK(range_sum == sequence_sum);
+  }
+
+  TEST_CASE("exec::inclusive_scan computes prefix sums in place", "[adaptors][numeric]") {
+    exec::static_thread_pool pool{4};
+    for (std::size_t n: {0u, 1u, 3u, 4u, 5u, 1000u}) {
+      auto input = iota_vector(n);
+      auto expected = input;
+      std::inclusive_scan(expected.begin(), expected.end(), expected.begin());
+
+      auto sndr = ex::transfer_just(pool.get_scheduler(), std::span{input})
+                | exec::inclusive_scan();
+      auto [out] = ex::sync_wait(std::move(sndr)).value();
+      CHECK(out.data() == input.data());
+      CHECK(input == expected);
+    }
+  }
+
+  TEST_CASE("exec::exclusive_scan computes prefix sums in place", "[adaptors][numeric]") {
+    exec::static_thread_pool pool{4};
+    for (std::size_t n: {0u, 1u, 3u, 4u, 5u, 1000u}) {
+      auto input = iota_vector(n);
+      auto expected = input;
+      std::exclusive_scan(expected.begin(), expected.end(), expected.begin(), 7L);
+
+      auto sndr = ex::transfer_just(pool.get_scheduler(), std::span{input})
+                | exec::exclusive_scan(7L);
+      ex::sync_wait(std::move(sndr));
+      CHECK(input == expected);
+    }
+  }
+
+  TEST_CASE("exec scans keep the order of a non-commutative operation", "[adaptors][numeric]") {
+    exec::static_thread_pool pool{3};
+    std::vector<std::string> words{"a", "b", "c", "d", "e", "f", "g"};
+    auto sndr = ex::transfer_just(pool.get_scheduler(), std::span{words})
+              | exec::inclusive_scan();
+    ex::sync_wait(std::move(sndr));
+    CHECK(words.back() == "abcdefg");
+    CHECK(words[2] == "abc");
+
+    std::vector<std::string> more{"a", "b", "c", "d", "e"};
+    ex::sync_wait(
+      ex::transfer_just(pool.get_scheduler(), std::span{more})
+      | exec::exclusive_scan(std::string{"_"}));
+    CHECK(more == std::vector<std::string>{"_", "_a", "_ab", "_abc", "_abcd"});
+  }
+
+  TEST_CASE("exec::inclusive_scan moves an owned range through", "[adaptors][numeric]") {
+    auto [out] = ex::sync_wait(ex::just(iota_vector(5)) | exec::inclusive_scan()).value();
+    CHECK(out == std::vector<long>{1, 3, 6, 10, 15});
+  }
+
+#  if !STDEXEC_STD_NO_EXCEPTIONS()
+  TEST_CASE("exec::reduce reports exceptions thrown by the operation", "[adaptors][numeric]") {
+    exec::static_thread_pool pool{2};
+    auto input = iota_vector(100);
+    auto sndr = ex::transfer_just(pool.get_scheduler(), std::span{input})
+              | exec::reduce(0L, [](long, long) -> long { throw std::logic_error{""}; });
+    CHECK_THROWS_AS(ex::sync_wait(std::move(sndr)), std::logic_error);
+  }
+#  endif
+} // namespace
+
+#endif
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exec/sharded_stop_token.hpp>
+#include <stdexec/execution.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace ex = stdexec;
+
+namespace {
+  struct on_stop {
+    int* count_;
+
+    void operator()() const noexcept {
+      ++*count_;
+    }
+  };
+
+  TEST_CASE("sharded_stop_token - default token", "[types][stop_token]") {
+    STATIC_REQUIRE(ex::stoppable_token<exec::sharded_stop_token>);
+    STATIC_REQUIRE(ex::stoppable_token_for<exec::sharded_stop_token, on_stop>);
+    STATIC_REQUIRE(!ex::unstoppable_token<exec::sharded_stop_token>);
+
+    exec::sharded_stop_token token;
+    CHECK_FALSE(token.stop_possible());
+    CHECK_FALSE(token.stop_requested());
+  }
+
+  TEST_CASE("sharded_stop_source - request_stop runs callbacks once", "[types][stop_token]") {
+    exec::sharded_stop_source source;
+    auto token = source.get_token();
+    CHECK(token.stop_possible());
+    CHECK_FALSE(token.stop_requested());
+
+    int count = 0;
+    exec::sharded_stop_callback<on_stop> cb1{token, on_stop{&count}};
+    exec::sharded_stop_callback<on_stop> cb2{token, on_stop{&count}};
+    CHECK(count == 0);
+
+    CHECK(source.request_stop());
+    CHECK(count == 2);
+    CHECK(token.stop_requested());
+
+    CHECK_FALSE(source.request_stop());
+    CHECK(count == 2);
+  }
+
+  TEST_CASE(
+    "sharded_stop_source - callbacks registered after stop run inline",
+    "[types][stop_token]") {
+    exec::sharded_stop_source source;
+    source.request_stop();
+    int count = 0;
+    exec::sharded_stop_callback<on_stop> cb{source.get_token(), on_stop{&count}};
+    CHECK(count == 1);
+  }
+
+  TEST_CASE("sharded_stop_source - deregistered callbacks don't run", "[types][stop_token]") {
+    exec::sharded_stop_source source;
+    int count = 0;
+    {
+      exec::sharded_stop_callback<on_stop> cb{source.get_token(), on_stop{&count}};
+    }
+    source.request_stop();
+    CHECK(count == 0);
+  }
+
+  TEST_CASE(
+    "sharded_stop_source - a callback can destroy itself while running",
+    "[types][stop_token]") {
+    exec::sharded_stop_source source;
+    struct destroy_self {
+      std::optional<exec::sharded_stop_callback<destroy_self>>* self_;
+
+      void operator()() const noexcept {
+        self_->reset();
+      }
+    };
+    std::optional<exec::sharded_stop_callback<destroy_self>> cb;
+    cb.emplace(source.get_token(), destroy_self{&cb});
+    source.request_stop();
+    CHECK_FALSE(cb.has_value());
+  }
+
+  TEST_CASE(
+    "sharded_stop_source - concurrent registration and stop request",
+    "[types][stop_token]") {
+    constexpr int num_threads = 8;
+    constexpr int iterations = 2000;
+    exec::sharded_stop_source source;
+    std::atomic<int> ran{0};
+    std::atomic<int> started{0};
+    std::atomic<int> ran_inline{0};
+
+    struct count_stop {
+      std::atomic<int>* ran_;
+
+      void operator()() const noexcept {
+        ran_->fetch_add(1, std::memory_order_relaxed);
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&] {
+        started.fetch_add(1);
+        for (int i = 0; i < iterations; ++i) {
+          exec::sharded_stop_callback<count_stop> cb{source.get_token(), count_stop{&ran}};
+        }
+        // Registered after stop is requested, so it must run inline.
+        int count = 0;
+        while (!source.stop_requested()) {
+          std::this_thread::yield();
+        }
+        exec::sharded_stop_callback<on_stop> cb{source.get_token(), on_stop{&count}};
+        ran_inline.fetch_add(count);
+      });
+    }
+    while (started.load() != num_threads) {
+      std::this_thread::yield();
+    }
+    source.request_stop();
+    for (auto& thread: threads) {
+      thread.join();
+    }
+    CHECK(ran.load() <= num_threads * iterations);
+    CHECK(ran_inline.load() == num_threads);
+  }
+
+  TEST_CASE("sharded_stop_token - when_all observes stop requests", "[types][stop_token]") {
+    exec::sharded_stop_source source;
+    bool seen = false;
+    auto sndr = ex::write_env(
+      ex::when_all(
+        ex::just() | ex::then([&] { source.request_stop(); }),
+        ex::read_env(ex::get_stop_token)
+          | ex::then([&](auto token) { seen = token.stop_requested(); })),
+      ex::prop{ex::get_stop_token, source.get_token()});
+    ex::sync_wait(std::move(sndr));
+    CHECK(seen);
+  }
+} // namespace
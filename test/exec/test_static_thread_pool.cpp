@@ -2,7 +2,9 @@
 #include <exec/static_thread_pool.hpp>
 #include <stdexec/execution.hpp>
 
+#include <atomic>
 #include <mutex>
+#include <stdexcept>
 #include <thread>
 #include <unordered_set>
 namespace ex = stdexec;
@@ -57,3 +59,134 @@ TEST_CASE(
   ex::sync_wait(std::move(sender));
   REQUIRE(thread_ids.size() == num_of_threads);
 }
+
+TEST_CASE(
+  "bulk on static_thread_pool completes with set_stopped if stop was already requested",
+  "[types][static_thread_pool]") {
+  exec::static_thread_pool pool{2};
+  ex::inplace_stop_source source;
+  source.request_stop();
+
+  std::atomic<int> calls{0};
+  auto sender = ex::write_env(
+    ex::schedule(pool.get_scheduler())
+      | ex::bulk(ex::par, 1000, [&](size_t) -> void { ++calls; }),
+    ex::prop{ex::get_stop_token, source.get_token()});
+  auto result = ex::sync_wait(std::move(sender));
+  CHECK_FALSE(result.has_value());
+  CHECK(calls.load() == 0);
+}
+
+TEST_CASE(
+  "bulk on static_thread_pool stops claiming chunks once stop is requested",
+  "[types][static_thread_pool]") {
+  exec::static_thread_pool pool{2};
+  ex::inplace_stop_source source;
+
+  std::atomic<int> calls{0};
+  auto sender = ex::write_env(
+    ex::schedule(pool.get_scheduler()) | ex::bulk(ex::par, 1000, [&](size_t) -> void {
+      ++calls;
+      source.request_stop();
+    }),
+    ex::prop{ex::get_stop_token, source.get_token()});
+  auto result = ex::sync_wait(std::move(sender));
+  CHECK_FALSE(result.has_value());
+  CHECK(calls.load() > 0);
+  CHECK(calls.load() < 1000);
+}
+
+TEST_CASE(
+  "bulk on static_thread_pool runs every index if stop is not requested",
+  "[types][static_thread_pool]") {
+  exec::static_thread_pool pool{3};
+  ex::inplace_stop_source source;
+
+  std::atomic<int> calls{0};
+  auto sender = ex::write_env(
+    ex::schedule(pool.get_scheduler())
+      | ex::bulk(ex::par, 1000, [&](size_t) -> void { ++calls; }),
+    ex::prop{ex::get_stop_token, source.get_token()});
+  auto result = ex::sync_wait(std::move(sender));
+  CHECK(result.has_value());
+  CHECK(calls.load() == 1000);
+}
+
+namespace {
+  void fork_join_fib(exec::fork_join_context ctx, int n, long& result) {
+    if (n < 2) {
+      result = n;
+      return;
+    }
+    long a = 0;
+    long b = 0;
+    auto child = ctx.spawn_child([&](exec::fork_join_context c) { fork_join_fib(c, n - 1, a); });
+    fork_join_fib(ctx, n - 2, b);
+    ctx.sync(child);
+    result = a + b;
+  }
+} // namespace
+
+TEST_CASE(
+  "fork_join_context computes recursive results on static_thread_pool",
+  "[types][static_thread_pool][fork_join]") {
+  exec::static_thread_pool pool{4};
+  auto sender = ex::schedule(pool.get_scheduler()) | ex::then([] {
+                  long result = 0;
+                  fork_join_fib(exec::fork_join_context::current(), 24, result);
+                  return result;
+                });
+  auto [result] = ex::sync_wait(std::move(sender)).value();
+  CHECK(result == 46368);
+}
+
+TEST_CASE(
+  "fork_join_context runs children inline outside of a pool",
+  "[types][static_thread_pool][fork_join]") {
+  auto ctx = exec::fork_join_context::current();
+  bool ran = false;
+  auto child = ctx.spawn_child([&](exec::fork_join_context) { ran = true; });
+  CHECK(ran);
+  ctx.sync(child);
+
+  long result = 0;
+  fork_join_fib(ctx, 15, result);
+  CHECK(result == 610);
+}
+
+TEST_CASE(
+  "fork_join_context rethrows exceptions from children on sync",
+  "[types][static_thread_pool][fork_join]") {
+  exec::static_thread_pool pool{2};
+  auto sender = ex::schedule(pool.get_scheduler()) | ex::then([] {
+                  auto ctx = exec::fork_join_context::current();
+                  auto child = ctx.spawn_child(
+                    [](exec::fork_join_context) { throw std::runtime_error("child"); });
+                  ctx.sync(child);
+                });
+  CHECK_THROWS_AS(ex::sync_wait(std::move(sender)), std::runtime_error);
+}
+
+TEST_CASE(
+  "fork_join_context joins unsynced children and overflows the local queue",
+  "[types][static_thread_pool][fork_join]") {
+  exec::static_thread_pool pool{3, exec::bwos_params{.numBlocks = 2, .blockSize = 4}};
+  std::atomic<int> calls{0};
+  auto sender = ex::schedule(pool.get_scheduler()) | ex::then([&] {
+                  auto ctx = exec::fork_join_context::current();
+                  auto spawn = [&](auto& self, int depth) -> void {
+                    if (depth == 0) {
+                      ++calls;
+                      return;
+                    }
+                    // Neither child is synced explicitly; each is joined when it goes out of
+                    // scope, and the queue of 8 tasks fills up before the recursion bottoms out.
+                    auto left = ctx.spawn_child([&](exec::fork_join_context) { ++calls; });
+                    auto right = ctx.spawn_child([&](exec::fork_join_context) { ++calls; });
+                    self(self, depth - 1);
+                  };
+                  spawn(spawn, 16);
+                });
+  ex::sync_wait(std::move(sender));
+  CHECK(calls.load() == 33);
+}
@@ -22,6 +22,8 @@
 #  include <exec/single_thread_context.hpp>
 #  include <exec/async_scope.hpp>
 
+#  include <test_common/allocators.hpp>
+#  include <test_common/receivers.hpp>
 #  include <test_common/schedulers.hpp>
 
 #  include <catch2/catch.hpp>
@@ -325,6 +327,154 @@ namespace {
     CHECK(count == 3);
   }
 #  endif // !STDEXEC_STD_NO_EXCEPTIONS()
+
+  auto add_with_allocator(std::allocator_arg_t, counting_allocator<std::byte>, int a, int b)
+    -> exec::task<int> {
+    co_return a + b;
+  }
+
+  TEST_CASE("task - frame is allocated with a leading allocator argument", "[types][task]") {
+    allocation_counts counts;
+    {
+      auto t = add_with_allocator(std::allocator_arg, counting_allocator<std::byte>{&counts}, 1, 2);
+      CHECK(counts.allocated == 1);
+      auto [i] = stdexec::sync_wait(std::move(t)).value();
+      CHECK(i == 3);
+    }
+    CHECK(counts.deallocated == 1);
+  }
+
+  allocation_counts frame_counts;
+
+  template <class Ty>
+  using counting_task = exec::basic_task<
+    Ty,
+    allocator_task_context<Ty, bound_counting_allocator<std::byte, &frame_counts>>
+  >;
+
+  auto nested_counting_task(int depth) -> counting_task<int> {
+    if (depth == 0) {
+      co_return 0;
+    }
+    co_return 1 + co_await nested_counting_task(depth - 1);
+  }
+
+  TEST_CASE("task - frame is allocated with the context's frame allocator", "[types][task]") {
+    frame_counts = {};
+    auto [i] = stdexec::sync_wait(nested_counting_task(3)).value();
+    CHECK(i == 3);
+    CHECK(frame_counts.allocated == 4);
+    CHECK(frame_counts.deallocated == 4);
+  }
+
+  auto nested_recycling_task(int depth) -> exec::recycling_task<int> {
+    if (depth == 0) {
+      co_return 0;
+    }
+    co_return 1 + co_await nested_recycling_task(depth - 1);
+  }
+
+  TEST_CASE("task - recycling_task reuses frames", "[types][task]") {
+    // The first run fills this thread's cache. Later runs take all their frames from it.
+    auto& cache = exec::__recycling_cache::__get();
+    std::size_t allocations_after_first_run = 0;
+    for (int i = 0; i < 10; ++i) {
+      auto [depth] = stdexec::sync_wait(nested_recycling_task(10)).value();
+      CHECK(depth == 10);
+      if (i == 0) {
+        allocations_after_first_run = cache.__num_allocations();
+        CHECK(allocations_after_first_run > 0);
+      }
+    }
+    CHECK(cache.__num_allocations() == allocations_after_first_run);
+    exec::single_thread_context ctx;
+    auto on_other_thread = starts_on(ctx.get_scheduler(), nested_recycling_task(5));
+    auto [depth] = stdexec::sync_wait(std::move(on_other_thread)).value();
+    CHECK(depth == 5);
+  }
+
+  auto await_twice(impulse_scheduler sched, int& steps) -> task<void> {
+    co_await schedule(sched);
+    ++steps;
+    co_await schedule(sched);
+    ++steps;
+  }
+
+  TEST_CASE(
+    "task - awaiting a sender that completes on the task's scheduler does not hop back",
+    "[types][sticky][task]") {
+    impulse_scheduler sched;
+    int steps = 0;
+    auto op = stdexec::connect(
+      await_twice(sched, steps), expect_void_receiver{stdexec::prop{get_scheduler, sched}});
+    stdexec::start(op);
+    sched.start_next();
+    CHECK(steps == 1);
+    sched.start_next();
+    CHECK(steps == 2);
+    CHECK_FALSE(sched.try_start_next());
+  }
+
+  auto await_other(impulse_scheduler other, int& steps) -> task<void> {
+    co_await schedule(other);
+    ++steps;
+  }
+
+  TEST_CASE(
+    "task - awaiting a sender that completes elsewhere hops back to the task's scheduler",
+    "[types][sticky][task]") {
+    impulse_scheduler sched;
+    impulse_scheduler other;
+    int steps = 0;
+    auto op = stdexec::connect(
+      await_other(other, steps), expect_void_receiver{stdexec::prop{get_scheduler, sched}});
+    stdexec::start(op);
+    other.start_next();
+    CHECK(steps == 0);
+    sched.start_next();
+    CHECK(steps == 1);
+  }
+
+  auto await_child(impulse_scheduler sched, int& steps) -> task<void> {
+    co_await await_twice(sched, steps);
+    ++steps;
+  }
+
+  TEST_CASE("task - awaiting a task does not hop back", "[types][sticky][task]") {
+    impulse_scheduler sched;
+    int steps = 0;
+    auto op = stdexec::connect(
+      await_child(sched, steps), expect_void_receiver{stdexec::prop{get_scheduler, sched}});
+    stdexec::start(op);
+    sched.start_next();
+    sched.start_next();
+    CHECK(steps == 3);
+    CHECK_FALSE(sched.try_start_next());
+  }
+
+  TEST_CASE(
+    "task - awaiting senders that complete inline does not grow the stack",
+    "[types][task]") {
+    auto sum = []() -> task<long> {
+      long total = 0;
+      for (int i = 0; i < 1'000'000; ++i) {
+        total += co_await just(1);
+      }
+      co_return total;
+    }();
+    auto [total] = stdexec::sync_wait(std::move(sum)).value();
+    CHECK(total == 1'000'000);
+  }
+
+  TEST_CASE("task - a sender that completes inline can stop the task", "[types][task]") {
+    bool resumed = false;
+    auto t = [](bool& resumed) -> task<void> {
+      co_await just_stopped();
+      resumed = true;
+    }(resumed);
+    CHECK_FALSE(stdexec::sync_wait(std::move(t)).has_value());
+    CHECK_FALSE(resumed);
+  }
 } // namespace
 
 #endif
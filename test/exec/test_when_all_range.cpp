@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exec/when_all_range.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <test_common/allocators.hpp>
+#include <test_common/schedulers.hpp>
+#include <test_common/receivers.hpp>
+#include <test_common/type_helpers.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ex = stdexec;
+
+namespace {
+
+  TEST_CASE("when_all_range returns a sender", "[adaptors][when_all_range]") {
+    std::vector<decltype(ex::just(1))> senders{ex::just(1), ex::just(2)};
+    auto snd = exec::when_all_range(std::move(senders));
+    STATIC_REQUIRE(ex::sender_in<decltype(snd), ex::env<>>);
+    check_val_types<ex::__mset<pack<std::vector<int>>>>(snd);
+    check_err_types<ex::__mset<std::exception_ptr>>(snd);
+    check_sends_stopped<true>(snd);
+  }
+
+  TEST_CASE(
+    "when_all_range sends the values of all children in order",
+    "[adaptors][when_all_range]") {
+    auto make = [](int i) {
+      return ex::just(i) | ex::then([](int i) { return std::to_string(i); });
+    };
+    std::vector<decltype(make(0))> senders;
+    for (int i = 0; i < 100; ++i) {
+      senders.push_back(make(i));
+    }
+    auto [values] = ex::sync_wait(exec::when_all_range(std::move(senders))).value();
+    REQUIRE(values.size() == 100);
+    for (int i = 0; i < 100; ++i) {
+      CHECK(values[static_cast<std::size_t>(i)] == std::to_string(i));
+    }
+  }
+
+  TEST_CASE(
+    "when_all_range can connect the same range more than once",
+    "[adaptors][when_all_range]") {
+    std::vector<decltype(ex::just(1))> senders{ex::just(1), ex::just(2), ex::just(3)};
+    auto snd = exec::when_all_range(senders);
+    auto [first] = ex::sync_wait(snd).value();
+    auto [second] = ex::sync_wait(snd).value();
+    CHECK(first == std::vector<int>{1, 2, 3});
+    CHECK(second == first);
+  }
+
+  TEST_CASE("when_all_range of void senders sends nothing", "[adaptors][when_all_range]") {
+    int count = 0;
+    auto make = [&] {
+      return ex::just() | ex::then([&] { ++count; });
+    };
+    std::vector<decltype(make())> senders{make(), make(), make()};
+    auto snd = exec::when_all_range(std::move(senders));
+    check_val_types<ex::__mset<pack<>>>(snd);
+    CHECK(ex::sync_wait(std::move(snd)).has_value());
+    CHECK(count == 3);
+  }
+
+  TEST_CASE("when_all_range of an empty range completes at once", "[adaptors][when_all_range]") {
+    std::vector<decltype(ex::just(1))> senders;
+    auto snd = exec::when_all_range(std::move(senders));
+    auto op = ex::connect(std::move(snd), expect_value_receiver{std::vector<int>{}});
+    ex::start(op);
+  }
+
+  TEST_CASE(
+    "when_all_range supports values that are not default-initializable",
+    "[adaptors][when_all_range]") {
+    struct no_default {
+      explicit no_default(int v)
+        : value(v) {
+      }
+
+      int value;
+    };
+
+    auto make = [](int i) {
+      return ex::just(i) | ex::then([](int i) { return no_default{i}; });
+    };
+    std::vector<decltype(make(0))> senders{make(1), make(2)};
+    auto [values] = ex::sync_wait(exec::when_all_range(std::move(senders))).value();
+    REQUIRE(values.size() == 2);
+    CHECK(values[0].value == 1);
+    CHECK(values[1].value == 2);
+  }
+
+  TEST_CASE(
+    "when_all_range forwards the first error and cancels the other children",
+    "[adaptors][when_all_range]") {
+    impulse_scheduler sched;
+    int ran = 0;
+    auto make = [&](int i) {
+      return ex::starts_on(sched, ex::just(i)) | ex::then([&](int i) {
+               ++ran;
+               if (i == 1) {
+                 throw std::logic_error("child failed");
+               }
+               return i;
+             });
+    };
+    std::vector<decltype(make(0))> senders{make(0), make(1), make(2)};
+    auto snd = exec::when_all_range(std::move(senders));
+    auto op = ex::connect(std::move(snd), expect_error_receiver{});
+    ex::start(op);
+    sched.start_next();
+    sched.start_next();
+    // The error cancelled the last child before it ran.
+    sched.start_next();
+    CHECK(ran == 2);
+  }
+
+  TEST_CASE("when_all_range forwards stop requests", "[adaptors][when_all_range]") {
+    impulse_scheduler sched;
+    ex::inplace_stop_source stop_source;
+    std::vector<decltype(ex::starts_on(sched, ex::just(1)))> senders{
+      ex::starts_on(sched, ex::just(1)), ex::starts_on(sched, ex::just(2))};
+    auto snd = ex::write_env(
+      exec::when_all_range(std::move(senders)),
+      ex::prop{ex::get_stop_token, stop_source.get_token()});
+    auto op = ex::connect(std::move(snd), expect_stopped_receiver{});
+    ex::start(op);
+    stop_source.request_stop();
+    sched.start_next();
+    sched.start_next();
+  }
+
+  TEST_CASE(
+    "when_all_range allocates the child operations with the receiver's allocator",
+    "[adaptors][when_all_range]") {
+    allocation_counts counts;
+    {
+      std::vector<decltype(ex::just(1))> senders{ex::just(1), ex::just(2), ex::just(3)};
+      auto snd = ex::write_env(
+        exec::when_all_range(std::move(senders)),
+        ex::prop{ex::get_allocator, counting_allocator<std::byte>{&counts}});
+      auto op = ex::connect(std::move(snd), expect_value_receiver{std::vector<int>{1, 2, 3}});
+      CHECK(counts.allocated == 1);
+      ex::start(op);
+    }
+    CHECK(counts.deallocated == 1);
+  }
+
+  TEST_CASE("when_all_range runs children concurrently on a pool", "[adaptors][when_all_range]") {
+    exec::static_thread_pool pool{4};
+    auto sched = pool.get_scheduler();
+    auto make = [&](int i) {
+      return ex::schedule(sched) | ex::then([i] { return i; });
+    };
+    std::vector<decltype(make(0))> senders;
+    for (int i = 0; i < 1000; ++i) {
+      senders.push_back(make(i));
+    }
+    auto [values] = ex::sync_wait(exec::when_all_range(std::move(senders))).value();
+    REQUIRE(values.size() == 1000);
+    CHECK(std::accumulate(values.begin(), values.end(), 0) == 999 * 1000 / 2);
+    for (int i = 0; i < 1000; ++i) {
+      CHECK(values[static_cast<std::size_t>(i)] == i);
+    }
+  }
+} // namespace
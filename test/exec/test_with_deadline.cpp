@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exec/timed_thread_scheduler.hpp>
+#include <exec/with_deadline.hpp>
+#include <stdexec/execution.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace ex = stdexec;
+using namespace std::chrono_literals;
+
+namespace {
+  // Waits for its stop token to be triggered, for up to 5 seconds, and sends whether it was.
+  auto wait_for_stop() {
+    return ex::read_env(ex::get_stop_token) | ex::then([](auto token) {
+             auto give_up = std::chrono::steady_clock::now() + 5s;
+             while (!token.stop_requested() && std::chrono::steady_clock::now() < give_up) {
+               std::this_thread::yield();
+             }
+             return token.stop_requested();
+           });
+  }
+
+  TEST_CASE("with_deadline - completes with the child's values", "[adaptors][with_deadline]") {
+    exec::timed_thread_context context;
+    auto sched = context.get_scheduler();
+    auto sndr = ex::just(42, std::string{"hello"})
+              | exec::with_deadline(sched, exec::now(sched) + 10s);
+    auto [i, s] = ex::sync_wait(std::move(sndr)).value();
+    CHECK(i == 42);
+    CHECK(s == "hello");
+  }
+
+  TEST_CASE("with_deadline - exposes the deadline", "[adaptors][with_deadline]") {
+    exec::timed_thread_context context;
+    auto sched = context.get_scheduler();
+    auto deadline = exec::now(sched) + 10s;
+    auto sndr = ex::read_env(exec::get_deadline) | exec::with_deadline(sched, deadline);
+    auto [seen] = ex::sync_wait(std::move(sndr)).value();
+    CHECK(seen == deadline);
+  }
+
+  TEST_CASE("with_deadline - stops the child at the deadline", "[adaptors][with_deadline]") {
+    exec::timed_thread_context context;
+    auto sched = context.get_scheduler();
+    auto t0 = std::chrono::steady_clock::now();
+    auto sndr = wait_for_stop() | exec::with_deadline(sched, exec::now(sched) + 10ms);
+    auto [stopped] = ex::sync_wait(std::move(sndr)).value();
+    CHECK(stopped);
+    CHECK(std::chrono::steady_clock::now() - t0 >= 10ms);
+  }
+
+  TEST_CASE("with_deadline - an inner deadline can be earlier", "[adaptors][with_deadline]") {
+    exec::timed_thread_context context;
+    auto sched = context.get_scheduler();
+    auto outer = exec::now(sched) + 10s;
+    auto inner = exec::now(sched) + 10ms;
+    auto sndr = (wait_for_stop() | exec::with_deadline(sched, inner))
+              | exec::with_deadline(sched, outer);
+    auto t0 = std::chrono::steady_clock::now();
+    auto [stopped] = ex::sync_wait(std::move(sndr)).value();
+    CHECK(stopped);
+    CHECK(std::chrono::steady_clock::now() - t0 < 5s);
+  }
+
+  TEST_CASE(
+    "with_deadline - an inner deadline can't extend the outer one",
+    "[adaptors][with_deadline]") {
+    exec::timed_thread_context context;
+    auto sched = context.get_scheduler();
+    auto outer = exec::now(sched) + 10ms;
+    auto inner = exec::now(sched) + 10s;
+    // The timers are armed on the receiver's scheduler.
+    auto with_sched = ex::prop{ex::get_scheduler, sched};
+    auto sndr = ex::write_env(
+      wait_for_stop() | exec::with_deadline(inner) | exec::with_deadline(outer), with_sched);
+    auto t0 = std::chrono::steady_clock::now();
+    auto [stopped] = ex::sync_wait(std::move(sndr)).value();
+    CHECK(stopped);
+    CHECK(std::chrono::steady_clock::now() - t0 < 5s);
+
+    auto seen = ex::sync_wait(ex::write_env(
+      ex::read_env(exec::get_deadline) | exec::with_deadline(inner) | exec::with_deadline(outer),
+      with_sched));
+    CHECK(std::get<0>(seen.value()) == outer);
+  }
+
+  TEST_CASE("with_deadline - forwards the receiver's stop requests", "[adaptors][with_deadline]") {
+    exec::timed_thread_context context;
+    auto sched = context.get_scheduler();
+    ex::inplace_stop_source source;
+    source.request_stop();
+    auto sndr = ex::write_env(
+      wait_for_stop() | exec::with_deadline(sched, exec::now(sched) + 10s),
+      ex::prop{ex::get_stop_token, source.get_token()});
+    auto [stopped] = ex::sync_wait(std::move(sndr)).value();
+    CHECK(stopped);
+  }
+
+  TEST_CASE(
+    "with_deadline - a stage that inherits the deadline passes on the stop token",
+    "[adaptors][with_deadline]") {
+    exec::timed_thread_context context;
+    auto sched = context.get_scheduler();
+    auto deadline = exec::now(sched) + 10s;
+    // Sends whether a with_deadline nested in the outer one gives its child the same stop
+    // token as it receives.
+    auto nested_keeps_token = [&](auto inner_deadline) {
+      return ex::read_env(ex::get_stop_token)
+           | ex::let_value([=](ex::inplace_stop_token outer) {
+               return ex::read_env(ex::get_stop_token) | exec::with_deadline(sched, inner_deadline)
+                    | ex::then([=](ex::inplace_stop_token inner) { return inner == outer; });
+             })
+           | exec::with_deadline(sched, deadline);
+    };
+    auto [inherited] = ex::sync_wait(nested_keeps_token(deadline + 1s)).value();
+    CHECK(inherited);
+    auto [armed] = ex::sync_wait(nested_keeps_token(deadline - 1s)).value();
+    CHECK_FALSE(armed);
+  }
+} // namespace
@@ -19,6 +19,7 @@
 
 #include <stdexec/execution.hpp>
 #include <exec/async_scope.hpp>
+#include <test_common/allocators.hpp>
 #include <test_common/schedulers.hpp>
 #include <test_common/receivers.hpp>
 #include <test_common/type_helpers.hpp>
@@ -335,4 +336,19 @@ namespace {
     (void) snd1;
     (void) snd2;
   }
+
+  TEST_CASE(
+    "ensure_started allocates its shared state with the env's allocator",
+    "[adaptors][ensure_started]") {
+    allocation_counts counts;
+    {
+      auto snd = ex::ensure_started(
+        ex::just(42), ex::prop{ex::get_allocator, counting_allocator<std::byte>{&counts}});
+      CHECK(counts.allocated == 1);
+      auto [v] = ex::sync_wait(std::move(snd)).value();
+      CHECK(v == 42);
+    }
+    CHECK(counts.allocated == 1);
+    CHECK(counts.deallocated == 1);
+  }
 } // namespace
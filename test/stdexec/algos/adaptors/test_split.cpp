@@ -17,12 +17,17 @@
 
 #include <catch2/catch.hpp>
 #include <stdexec/execution.hpp>
+#include <test_common/allocators.hpp>
 #include <test_common/schedulers.hpp>
 #include <test_common/senders.hpp>
 #include <test_common/receivers.hpp>
 #include <test_common/type_helpers.hpp>
 #include <exec/static_thread_pool.hpp>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 namespace ex = stdexec;
 
 using namespace std::chrono_literals;
@@ -512,4 +517,75 @@ namespace {
     (void) snd1;
     (void) snd2;
   }
+
+  TEST_CASE("split allocates its shared state with the env's allocator", "[adaptors][split]") {
+    allocation_counts counts;
+    {
+      auto snd = ex::split(
+        ex::just(42), ex::prop{ex::get_allocator, counting_allocator<std::byte>{&counts}});
+      CHECK(counts.allocated == 1);
+      auto [a] = ex::sync_wait(snd).value();
+      auto [b] = ex::sync_wait(snd).value();
+      CHECK(a == 42);
+      CHECK(b == 42);
+      CHECK(counts.deallocated == 0);
+    }
+    CHECK(counts.allocated == 1);
+    CHECK(counts.deallocated == 1);
+  }
+
+  // Catch assertions are not thread-safe, so the consumers below signal completion with a
+  // receiver that does not check anything.
+  struct flag_receiver {
+    using receiver_concept = ex::receiver_t;
+    std::atomic<bool>* done_;
+
+    void set_value() noexcept {
+      done_->store(true);
+    }
+
+    void set_error(std::exception_ptr) noexcept {
+      done_->store(true);
+    }
+
+    void set_stopped() noexcept {
+      done_->store(true);
+    }
+  };
+
+  TEST_CASE(
+    "split notifies consumers that subscribe and stop concurrently",
+    "[adaptors][split]") {
+    exec::static_thread_pool pool{2};
+    for (int iteration = 0; iteration < 100; ++iteration) {
+      auto split = ex::split(ex::schedule(pool.get_scheduler()) | ex::then([] { return 1; }));
+      constexpr int num_consumers = 8;
+      std::atomic<int> values{0};
+      std::atomic<int> stopped{0};
+      std::vector<std::thread> threads;
+      for (int i = 0; i < num_consumers; ++i) {
+        threads.emplace_back([&, i] {
+          ex::inplace_stop_source ssource;
+          std::atomic<bool> done{false};
+          auto sndr = ex::write_env(
+            split | ex::then([&](int v) { values += v; })
+              | ex::upon_stopped([&] { stopped += 1; }),
+            ex::prop{ex::get_stop_token, ssource.get_token()});
+          auto op = ex::connect(std::move(sndr), flag_receiver{&done});
+          ex::start(op);
+          if (i % 2 == 0) {
+            ssource.request_stop();
+          }
+          while (!done.load()) {
+            std::this_thread::yield();
+          }
+        });
+      }
+      for (auto& t: threads) {
+        t.join();
+      }
+      CHECK(values + stopped == num_consumers);
+      CHECK(values >= num_consumers / 2);
+    }
+  }
 } // namespace
@@ -381,4 +381,27 @@ namespace {
       wait_for_value(std::move(snd), std::string{"hello world"});
     }
   }
+
+  TEST_CASE(
+    "when_all gives children an unstoppable token when nothing can cancel them",
+    "[adaptors][when_all]") {
+    auto snd = ex::when_all(ex::just(1), ex::read_env(ex::get_stop_token));
+    auto [i, token] = ex::sync_wait(std::move(snd)).value();
+    CHECK(i == 1);
+    CHECK_FALSE(token.stop_possible());
+  }
+
+  TEST_CASE(
+    "when_all gives children a stoppable token when a child can fail",
+    "[adaptors][when_all]") {
+    auto snd = ex::when_all(ex::just() | ex::then([] { }), ex::read_env(ex::get_stop_token));
+    auto [token] = ex::sync_wait(std::move(snd)).value();
+    CHECK(token.stop_possible());
+  }
+
+  TEST_CASE("when_all error trumps a concurrent stop", "[adaptors][when_all]") {
+    auto snd = ex::when_all(ex::just_stopped(), ex::just_error(42), ex::just_stopped());
+    auto op = ex::connect(std::move(snd), expect_error_receiver{42});
+    ex::start(op);
+  }
 } // namespace
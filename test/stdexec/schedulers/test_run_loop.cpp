@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include <stdexec/execution.hpp>
+#include <test_common/receivers.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace ex = stdexec;
+
+namespace {
+
+  TEST_CASE("run_loop runs tasks in FIFO order", "[schedulers][run_loop]") {
+    ex::run_loop loop;
+    std::vector<int> order;
+    auto sched = loop.get_scheduler();
+    auto op1 = ex::connect(
+      ex::then(ex::schedule(sched), [&] { order.push_back(1); }), expect_void_receiver{});
+    auto op2 = ex::connect(
+      ex::then(ex::schedule(sched), [&] { order.push_back(2); }), expect_void_receiver{});
+    auto op3 = ex::connect(
+      ex::then(ex::schedule(sched), [&] { order.push_back(3); }), expect_void_receiver{});
+    ex::start(op1);
+    ex::start(op2);
+    ex::start(op3);
+    loop.finish();
+    loop.run();
+    CHECK(order == std::vector{1, 2, 3});
+  }
+
+  TEST_CASE("run_loop runs work scheduled by a running task", "[schedulers][run_loop]") {
+    ex::run_loop loop;
+    auto sched = loop.get_scheduler();
+    int count = 0;
+    auto inner = ex::connect(
+      ex::then(ex::schedule(sched), [&] {
+        ++count;
+        loop.finish();
+      }),
+      expect_void_receiver{});
+    auto outer = ex::connect(
+      ex::then(ex::schedule(sched), [&] {
+        ++count;
+        ex::start(inner);
+      }),
+      expect_void_receiver{});
+    ex::start(outer);
+    loop.run();
+    CHECK(count == 2);
+  }
+
+  TEST_CASE("run_loop can be finished from another thread", "[schedulers][run_loop]") {
+    ex::run_loop loop;
+    std::thread finisher{[&] { loop.finish(); }};
+    loop.run();
+    finisher.join();
+  }
+
+  TEST_CASE("run_loop executes tasks posted from many threads", "[schedulers][run_loop]") {
+    constexpr int num_threads = 4;
+    constexpr int tasks_per_thread = 2000;
+    auto spin_count = GENERATE(std::size_t{0}, std::size_t{1000});
+    ex::run_loop loop{spin_count};
+    auto sched = loop.get_scheduler();
+    std::atomic<int> remaining{num_threads * tasks_per_thread};
+    int executed = 0;
+
+    std::vector<std::thread> producers;
+    for (int i = 0; i < num_threads; ++i) {
+      producers.emplace_back([&] {
+        for (int j = 0; j < tasks_per_thread; ++j) {
+          ex::start_detached(ex::then(ex::schedule(sched), [&] {
+            ++executed;
+            if (remaining.fetch_sub(1) == 1) {
+              loop.finish();
+            }
+          }));
+        }
+      });
+    }
+    loop.run();
+    for (auto& t: producers) {
+      t.join();
+    }
+    CHECK(executed == num_threads * tasks_per_thread);
+  }
+
+  TEST_CASE(
+    "run_loop can be finished from another thread right after a post",
+    "[schedulers][run_loop]") {
+    for (int i = 0; i < 1000; ++i) {
+      ex::run_loop other;
+      std::thread worker{[&] { other.run(); }};
+      auto r = ex::sync_wait(ex::starts_on(other.get_scheduler(), ex::just(i)));
+      other.finish();
+      worker.join();
+      REQUIRE(r.has_value());
+      CHECK(std::get<0>(*r) == i);
+    }
+  }
+
+  TEST_CASE("run_loop::run_some does not block", "[schedulers][run_loop]") {
+    ex::run_loop loop;
+    CHECK(loop.run_some() == 0);
+    CHECK_FALSE(loop.run_one());
+
+    int count = 0;
+    auto sched = loop.get_scheduler();
+    auto op1 = ex::connect(ex::then(ex::schedule(sched), [&] { ++count; }), expect_void_receiver{});
+    auto op2 = ex::connect(ex::then(ex::schedule(sched), [&] { ++count; }), expect_void_receiver{});
+    auto op3 = ex::connect(ex::then(ex::schedule(sched), [&] { ++count; }), expect_void_receiver{});
+    ex::start(op1);
+    ex::start(op2);
+    ex::start(op3);
+    CHECK(loop.run_one());
+    CHECK(count == 1);
+    CHECK(loop.run_some() == 2);
+    CHECK(count == 3);
+    CHECK(loop.run_some() == 0);
+  }
+
+  struct wakeup_counter {
+    int count = 0;
+
+    static void wakeup(void* self) noexcept {
+      ++static_cast<wakeup_counter*>(self)->count;
+    }
+  };
+
+  TEST_CASE(
+    "run_loop calls the wakeup function when work arrives on an idle loop",
+    "[schedulers][run_loop]") {
+    wakeup_counter wakeups;
+    ex::run_loop loop{&wakeup_counter::wakeup, &wakeups};
+    auto sched = loop.get_scheduler();
+    int count = 0;
+    auto op1 = ex::connect(ex::then(ex::schedule(sched), [&] { ++count; }), expect_void_receiver{});
+    auto op2 = ex::connect(ex::then(ex::schedule(sched), [&] { ++count; }), expect_void_receiver{});
+    auto op3 = ex::connect(ex::then(ex::schedule(sched), [&] { ++count; }), expect_void_receiver{});
+    auto op4 = ex::connect(ex::then(ex::schedule(sched), [&] { ++count; }), expect_void_receiver{});
+
+    // Only the first of a burst of posts needs to wake the event loop.
+    ex::start(op1);
+    ex::start(op2);
+    CHECK(wakeups.count == 1);
+
+    // Leaving work behind asks for another turn.
+    CHECK(loop.run_some(1) == 1);
+    CHECK(wakeups.count == 2);
+    CHECK(loop.run_some() == 1);
+    CHECK(wakeups.count == 2);
+    CHECK(count == 2);
+
+    // Once drained, the next post wakes the event loop again.
+    ex::start(op3);
+    CHECK(wakeups.count == 3);
+    ex::start(op4);
+    CHECK(wakeups.count == 3);
+    CHECK(loop.run_some() == 2);
+    CHECK(count == 4);
+
+    loop.finish();
+    CHECK(wakeups.count == 4);
+  }
+} // namespace
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace {
+
+  struct allocation_counts {
+    int allocated = 0;
+    int deallocated = 0;
+  };
+
+  //! Allocator that counts its allocations and deallocations, for checking that an algorithm
+  //! uses the allocator it is given.
+  template <class T>
+  struct counting_allocator {
+    using value_type = T;
+
+    allocation_counts* counts;
+
+    explicit counting_allocator(allocation_counts* c) noexcept
+      : counts(c) {
+    }
+
+    template <class U>
+    counting_allocator(const counting_allocator<U>& other) noexcept
+      : counts(other.counts) {
+    }
+
+    auto allocate(std::size_t n) -> T* {
+      ++counts->allocated;
+      return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+      ++counts->deallocated;
+      std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template <class U>
+    auto operator==(const counting_allocator<U>& other) const noexcept -> bool {
+      return counts == other.counts;
+    }
+  };
+
+  //! A counting_allocator bound to the global allocation_counts `*Counts`. It is
+  //! default-constructible, for the places that require it, such as the allocator of an
+  //! any_sender_storage or the frame allocator of a task context.
+  template <class T, allocation_counts* Counts>
+  struct bound_counting_allocator : counting_allocator<T> {
+    template <class U>
+    struct rebind {
+      using other = bound_counting_allocator<U, Counts>;
+    };
+
+    bound_counting_allocator() noexcept
+      : counting_allocator<T>{Counts} {
+    }
+
+    template <class U>
+    bound_counting_allocator(const bound_counting_allocator<U, Counts>&) noexcept
+      : bound_counting_allocator() {
+    }
+  };
+} // namespace